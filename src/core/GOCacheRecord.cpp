@@ -0,0 +1,93 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOCacheRecord.h"
+
+#include <cstring>
+
+void GOCacheRecord::PutBytes(uint32_t value, unsigned nBytes) {
+  for (unsigned i = 0; i < nBytes; i++)
+    m_data.push_back((uint8_t)(value >> (8 * i)));
+}
+
+bool GOCacheRecord::GetBytes(uint32_t &value, unsigned nBytes) {
+  if (m_data.size() - m_pos < nBytes)
+    return false;
+
+  uint32_t result = 0;
+
+  for (unsigned i = 0; i < nBytes; i++)
+    result |= (uint32_t)m_data[m_pos++] << (8 * i);
+  value = result;
+  return true;
+}
+
+uint8_t *GOCacheRecord::PrepareForReading(uint32_t size) {
+  m_data.resize(size);
+  m_pos = 0;
+  return m_data.data();
+}
+
+void GOCacheRecord::PutFloat(float value) {
+  uint32_t bits;
+
+  memcpy(&bits, &value, sizeof(bits));
+  PutUInt(bits);
+}
+
+bool GOCacheRecord::GetUInt(uint8_t &value) {
+  uint32_t v;
+  const bool isOk = GetBytes(v, 4) && v <= UINT8_MAX;
+
+  if (isOk)
+    value = (uint8_t)v;
+  return isOk;
+}
+
+bool GOCacheRecord::GetInt(int32_t &value) {
+  uint32_t v;
+  const bool isOk = GetBytes(v, 4);
+
+  if (isOk)
+    value = (int32_t)v;
+  return isOk;
+}
+
+bool GOCacheRecord::GetInt(int8_t &value) {
+  int32_t v;
+  const bool isOk = GetInt(v) && v >= INT8_MIN && v <= INT8_MAX;
+
+  if (isOk)
+    value = (int8_t)v;
+  return isOk;
+}
+
+bool GOCacheRecord::GetFloat(float &value) {
+  uint32_t bits;
+  const bool isOk = GetBytes(bits, 4);
+
+  if (isOk)
+    memcpy(&value, &bits, sizeof(value));
+  return isOk;
+}
+
+bool GOCacheRecord::GetBool3(GOBool3 &value) {
+  int8_t v;
+  const bool isOk = GetInt(v) && v >= BOOL3_MIN && v <= BOOL3_MAX;
+
+  if (isOk)
+    value = to_bool3(v);
+  return isOk;
+}
+
+bool GOCacheRecord::GetBool(bool &value) {
+  uint32_t v;
+  const bool isOk = GetBytes(v, 1) && v <= 1;
+
+  if (isOk)
+    value = v;
+  return isOk;
+}
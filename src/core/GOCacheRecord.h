@@ -0,0 +1,71 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOCACHERECORD_H
+#define GOCACHERECORD_H
+
+#include <cstdint>
+#include <vector>
+
+#include "GOBool3.h"
+
+/**
+ * A group of scalar fields stored in the cache file independently of the
+ * layout of the structures in memory. Each field is stored in the little
+ * endian byte order: an integer or a float takes 4 bytes and a bool takes
+ * one byte.
+ *
+ * A record is stored prefixed with its size, so new fields may be appended
+ * to the end of a record without invalidating the existing caches: a reader
+ * finds that a field of an older cache is absent and keeps its default value,
+ * and a reader of an older version skips the fields it does not know.
+ */
+class GOCacheRecord {
+public:
+  // a bigger size means that the cache is damaged
+  static constexpr uint32_t MAX_SIZE = 1 << 24;
+
+private:
+  std::vector<uint8_t> m_data;
+  // the position of the next field to get
+  uint32_t m_pos;
+
+  void PutBytes(uint32_t value, unsigned nBytes);
+  bool GetBytes(uint32_t &value, unsigned nBytes);
+
+public:
+  GOCacheRecord() : m_pos(0) {}
+
+  const uint8_t *GetData() const { return m_data.data(); }
+  uint32_t GetSize() const { return m_data.size(); }
+
+  /**
+   * Resizes the record for reading the stored fields to the returned buffer
+   * and rewinds it to the first field
+   */
+  uint8_t *PrepareForReading(uint32_t size);
+
+  void PutUInt(uint32_t value) { PutBytes(value, 4); }
+  void PutInt(int32_t value) { PutBytes((uint32_t)value, 4); }
+  void PutFloat(float value);
+  void PutBool(bool value) { PutBytes(value, 1); }
+
+  /**
+   * Get the next field. If the record has no more fields then they return
+   * false and do not change the value. The overloads for the narrower types
+   * read the same 4-byte field and fail if the value does not fit the type
+   */
+  bool GetUInt(uint32_t &value) { return GetBytes(value, 4); }
+  bool GetUInt(uint8_t &value);
+  bool GetInt(int32_t &value);
+  bool GetInt(int8_t &value);
+  bool GetFloat(float &value);
+  bool GetBool(bool &value);
+  // reads a GOBool3 stored with PutInt()
+  bool GetBool3(GOBool3 &value);
+};
+
+#endif /* GOCACHERECORD_H */
@@ -0,0 +1,213 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOLzCodec.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+static constexpr unsigned HASH_BITS = 14;
+static constexpr unsigned NIBBLE_MAX = 15;
+// the search step grows by one after each so many bytes without a match
+static constexpr unsigned SKIP_TRIGGER = 6;
+// the literals and the matches not longer than it are copied at once
+static constexpr unsigned WILD_COPY = 16;
+
+static inline uint32_t read32(const uint8_t *p) {
+  uint32_t v;
+
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static inline unsigned hash32(uint32_t v) {
+  return (v * 2654435761u) >> (32 - HASH_BITS);
+}
+
+/**
+ * Writes the rest of a length exceeding the nibble
+ * @return the new output position or nullptr if there is not enough space
+ */
+static uint8_t *write_length(uint8_t *op, const uint8_t *opEnd, size_t rest) {
+  for (; rest >= 255; rest -= 255) {
+    if (op >= opEnd)
+      return nullptr;
+    *op++ = 255;
+  }
+  if (op >= opEnd)
+    return nullptr;
+  *op++ = (uint8_t)rest;
+  return op;
+}
+
+/**
+ * Reads the rest of a length exceeding the nibble
+ * @return false if the input is over
+ */
+static bool read_length(const uint8_t *&ip, const uint8_t *ipEnd, size_t &len) {
+  uint8_t b;
+
+  do {
+    if (ip >= ipEnd)
+      return false;
+    b = *ip++;
+    len += b;
+  } while (b == 255);
+  return true;
+}
+
+/**
+ * Writes a sequence of the literals and the match. matchLen == 0 means the
+ * last sequence without a match
+ * @return the new output position or nullptr if there is not enough space
+ */
+static uint8_t *write_sequence(
+  uint8_t *op,
+  const uint8_t *opEnd,
+  const uint8_t *literals,
+  size_t litLen,
+  unsigned offset,
+  size_t matchLen) {
+  const size_t matchCode = matchLen ? matchLen - GOLzCodec::MIN_MATCH : 0;
+  uint8_t *token = op++;
+
+  if (op > opEnd)
+    return nullptr;
+  *token = (uint8_t)(
+    (std::min<size_t>(litLen, NIBBLE_MAX) << 4)
+    | std::min<size_t>(matchCode, NIBBLE_MAX));
+  if (
+    litLen >= NIBBLE_MAX
+    && !(op = write_length(op, opEnd, litLen - NIBBLE_MAX)))
+    return nullptr;
+  if ((size_t)(opEnd - op) < litLen)
+    return nullptr;
+  if (litLen) {
+    memcpy(op, literals, litLen);
+    op += litLen;
+  }
+  if (matchLen) {
+    if (opEnd - op < 2)
+      return nullptr;
+    *op++ = (uint8_t)offset;
+    *op++ = (uint8_t)(offset >> 8);
+    if (
+      matchCode >= NIBBLE_MAX
+      && !(op = write_length(op, opEnd, matchCode - NIBBLE_MAX)))
+      return nullptr;
+  }
+  return op;
+}
+
+size_t GOLzCodec::compress(
+  const uint8_t *src, size_t srcSize, uint8_t *dst, size_t dstCapacity) {
+  // the positions + 1 of the last occurrences of the hashed 4-byte sequences
+  std::vector<uint32_t> table(1 << HASH_BITS, 0);
+  const uint8_t *opEnd = dst + dstCapacity;
+  uint8_t *op = dst;
+  size_t anchor = 0;
+  size_t pos = 0;
+
+  while (pos + MIN_MATCH <= srcSize) {
+    const uint32_t seq = read32(src + pos);
+    uint32_t &entry = table[hash32(seq)];
+    const size_t ref = entry;
+
+    entry = (uint32_t)(pos + 1);
+    if (ref && pos + 1 - ref <= MAX_OFFSET && read32(src + ref - 1) == seq) {
+      const uint8_t *match = src + ref - 1;
+      size_t matchLen = MIN_MATCH;
+
+      while (pos + matchLen < srcSize && match[matchLen] == src[pos + matchLen])
+        matchLen++;
+      op = write_sequence(
+        op,
+        opEnd,
+        src + anchor,
+        pos - anchor,
+        (unsigned)(src + pos - match),
+        matchLen);
+      if (!op)
+        return 0;
+      pos += matchLen;
+      anchor = pos;
+    } else
+      // skip faster over the data that does not compress
+      pos += 1 + ((pos - anchor) >> SKIP_TRIGGER);
+  }
+  op = write_sequence(op, opEnd, src + anchor, srcSize - anchor, 0, 0);
+  return op ? op - dst : 0;
+}
+
+bool GOLzCodec::decompress(
+  const uint8_t *src, size_t srcSize, uint8_t *dst, size_t dstSize) {
+  const uint8_t *ip = src;
+  const uint8_t *const ipEnd = src + srcSize;
+  uint8_t *op = dst;
+  uint8_t *const opEnd = dst + dstSize;
+
+  while (ip < ipEnd) {
+    const unsigned token = *ip++;
+    size_t litLen = token >> 4;
+
+    if (litLen == NIBBLE_MAX && !read_length(ip, ipEnd, litLen))
+      return false;
+    if ((size_t)(ipEnd - ip) < litLen || (size_t)(opEnd - op) < litLen)
+      return false;
+    if (
+      litLen <= WILD_COPY && ipEnd - ip >= WILD_COPY
+      && opEnd - op >= WILD_COPY)
+      // short runs are copied with one fixed size copy
+      memcpy(op, ip, WILD_COPY);
+    else
+      memcpy(op, ip, litLen);
+    ip += litLen;
+    op += litLen;
+    if (ip == ipEnd)
+      // the last sequence
+      return op == opEnd;
+
+    if (ipEnd - ip < 2)
+      return false;
+
+    const size_t offset = ip[0] | (ip[1] << 8);
+    size_t matchLen = token & NIBBLE_MAX;
+
+    ip += 2;
+    if (matchLen == NIBBLE_MAX && !read_length(ip, ipEnd, matchLen))
+      return false;
+    matchLen += MIN_MATCH;
+    if (!offset || offset > (size_t)(op - dst))
+      return false;
+    if ((size_t)(opEnd - op) < matchLen)
+      return false;
+
+    const uint8_t *match = op - offset;
+
+    if (offset >= WILD_COPY && matchLen <= WILD_COPY && opEnd - op >= WILD_COPY)
+      memcpy(op, match, WILD_COPY);
+    else if (offset >= matchLen)
+      memcpy(op, match, matchLen);
+    else
+      // the match overlaps the output, so it repeats the last offset bytes
+      for (size_t i = 0; i < matchLen; i++)
+        op[i] = match[i];
+    op += matchLen;
+  }
+  return false;
+}
+
+void GOLzCodec::encodeDelta(uint8_t *data, size_t size, unsigned stride) {
+  for (size_t i = size; i > stride; i--)
+    data[i - 1] -= data[i - 1 - stride];
+}
+
+void GOLzCodec::decodeDelta(uint8_t *data, size_t size, unsigned stride) {
+  for (size_t i = stride; i < size; i++)
+    data[i] += data[i - stride];
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOLZCODEC_H
+#define GOLZCODEC_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * A byte oriented LZ77 codec optimised for the decompression speed.
+ *
+ * The compressed data is a sequence of literal runs each followed by a copy
+ * of an earlier part of the output. Each sequence starts with a token byte:
+ * the high nibble is the literal count and the low nibble is the match length
+ * minus MIN_MATCH. The nibble value 15 means that the rest of the count
+ * follows as bytes of 255 terminated by a byte less than 255. The literals go
+ * then, and the match offset as two bytes little-endian after them. The last
+ * sequence has only literals.
+ *
+ * Each buffer is compressed independently of the others, and decompressing
+ * does not need any memory except the output buffer.
+ */
+class GOLzCodec {
+public:
+  static constexpr unsigned MIN_MATCH = 4;
+  static constexpr unsigned MAX_OFFSET = 0xFFFF;
+
+  /**
+   * Returns the size of the output buffer enough for compressing srcSize
+   * bytes of any content
+   */
+  static size_t getMaxCompressedSize(size_t srcSize) {
+    return srcSize + srcSize / 255 + 16;
+  }
+
+  /**
+   * Compresses the buffer
+   * @return the compressed size or 0 if it exceeds dstCapacity
+   */
+  static size_t compress(
+    const uint8_t *src, size_t srcSize, uint8_t *dst, size_t dstCapacity);
+
+  /**
+   * Decompresses the buffer
+   * @return false if the data is corrupted or it is not decompressed to
+   *   exactly dstSize bytes
+   */
+  static bool decompress(
+    const uint8_t *src, size_t srcSize, uint8_t *dst, size_t dstSize);
+
+  /**
+   * Replaces each byte with its difference from the byte stride positions
+   * before. Applied before compressing PCM samples it turns the slowly changing
+   * high bytes of the samples to repeating zeros
+   */
+  static void encodeDelta(uint8_t *data, size_t size, unsigned stride);
+
+  // Reverts encodeDelta()
+  static void decodeDelta(uint8_t *data, size_t size, unsigned stride);
+};
+
+#endif /* GOLZCODEC_H */
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -31,7 +31,9 @@
 static inline void touchMemory(const char *pos) { *(const volatile char *)pos; }
 
 GOMemoryPool::GOMemoryPool()
-  : m_PoolStart(0),
+  : m_PoolUsed(0),
+    m_FreeSize(0),
+    m_PoolStart(0),
     m_PoolPtr(0),
     m_PoolEnd(0),
     m_CacheStart(0),
@@ -58,14 +60,15 @@ bool inline GOMemoryPool::InMemoryPool(void *ptr) {
 }
 
 void *GOMemoryPool::Alloc(size_t length, bool final) {
-  if (m_MemoryLimit && m_CacheSize + m_PoolSize + m_MallocSize > m_MemoryLimit)
+  if (m_MemoryLimit && m_CacheSize + m_PoolUsed + m_MallocSize > m_MemoryLimit)
     return NULL;
   if (!final)
     return malloc(length);
   GOMutexLocker locker(m_mutex);
+  // the length is rounded up to the actual size of the block
   void *data = PoolAlloc(length);
   if (data) {
-    AddPoolAlloc(data);
+    AddPoolAlloc(data, length);
     return data;
   }
   m_MallocSize += length;
@@ -77,9 +80,15 @@ void GOMemoryPool::Free(void *data) {
     return;
   if (InMemoryPool(data)) {
     GOMutexLocker locker(m_mutex);
-    if (m_PoolAllocs.count(data)) {
-      /* Pool memory is not individually freed */
-      m_PoolAllocs.erase(m_PoolAllocs.find(data));
+    auto it = m_PoolAllocs.find(data);
+
+    if (it != m_PoolAllocs.end()) {
+      const size_t length = it->second;
+
+      m_PoolAllocs.erase(it);
+      // the cache data has no length and is freed with the cache file
+      if (length)
+        PoolFree((char *)data, length);
       return;
     } else
       wxLogError(_("Invalid free of %p"), data);
@@ -103,15 +112,107 @@ void *GOMemoryPool::MoveToPool(void *data, size_t length) {
   return new_data;
 }
 
-void GOMemoryPool::AddPoolAlloc(void *data) { m_PoolAllocs.insert(data); }
+void GOMemoryPool::AddPoolAlloc(void *data, size_t length) {
+  m_PoolAllocs[data] = length;
+  m_PoolUsed += length;
+}
+
+void GOMemoryPool::AddFreeBlock(char *start, size_t length) {
+  m_FreeBlocks.emplace(start, length);
+  m_FreeBySize.emplace(length, start);
+  m_FreeSize += length;
+}
+
+void GOMemoryPool::RemoveFreeBlock(std::map<char *, size_t>::iterator it) {
+  m_FreeBySize.erase(std::make_pair(it->second, it->first));
+  m_FreeSize -= it->second;
+  m_FreeBlocks.erase(it);
+}
+
+void GOMemoryPool::ClearFreeBlocks() {
+  m_FreeBlocks.clear();
+  m_FreeBySize.clear();
+  m_FreeSize = 0;
+}
+
+char *GOMemoryPool::TakeFreeBlock(size_t &length) {
+  auto bySize = m_FreeBySize.lower_bound(std::make_pair(length, (char *)0));
+
+  if (bySize == m_FreeBySize.end())
+    return NULL;
+
+  char *const start = bySize->second;
+  const size_t blockLength = bySize->first;
+
+  RemoveFreeBlock(m_FreeBlocks.find(start));
+  if (blockLength - length >= MIN_SPLIT_SIZE)
+    AddFreeBlock(start + length, blockLength - length);
+  else
+    length = blockLength;
+  return start;
+}
+
+void GOMemoryPool::PoolFree(char *data, size_t length) {
+  char *start = data;
+  char *end = data + length;
+  auto next = m_FreeBlocks.lower_bound(start);
 
-void *GOMemoryPool::PoolAlloc(size_t length) {
+  m_PoolUsed -= length;
+  if (next != m_FreeBlocks.begin()) {
+    auto prev = std::prev(next);
+
+    if (prev->first + prev->second == start) {
+      start = prev->first;
+      RemoveFreeBlock(prev);
+    }
+  }
+  if (next != m_FreeBlocks.end() && next->first == end) {
+    end += next->second;
+    RemoveFreeBlock(next);
+  }
+  if (end == m_PoolPtr)
+    // the block is at the end of the used range, so just shrink the range
+    m_PoolPtr = start;
+  else
+    AddFreeBlock(start, end - start);
+  if ((size_t)(end - start) >= RELEASE_MIN_SIZE)
+    ReleasePages(start, end);
+}
+
+void GOMemoryPool::ReleasePages(char *start, char *end) {
+  // only the pages lying entirely inside the range may be released
+  const size_t pageMask = m_PageSize - 1;
+  char *pageStart = m_PoolStart
+    + ((start - m_PoolStart + pageMask) & ~pageMask);
+  char *pageEnd = m_PoolStart + ((end - m_PoolStart) & ~pageMask);
+
+  if (pageEnd <= pageStart)
+    return;
+#ifdef __linux__
+  // the pool is a shared mapping, so MADV_DONTNEED would keep the pages
+  madvise(pageStart, pageEnd - pageStart, MADV_REMOVE);
+#endif
+#ifdef __WXMAC__
+  madvise(pageStart, pageEnd - pageStart, MADV_FREE);
+#endif
+#ifdef __WIN32__
+  VirtualAlloc(pageStart, pageEnd - pageStart, MEM_RESET, PAGE_READWRITE);
+#endif
+}
+
+void *GOMemoryPool::PoolAlloc(size_t &length) {
   char *new_ptr;
 
   if (!m_PoolStart)
     return NULL;
   if (!length)
     length++;
+  length = (length + ALLOC_ALIGN - 1) & ~(ALLOC_ALIGN - 1);
+
+  char *const freeBlock = TakeFreeBlock(length);
+
+  if (freeBlock)
+    return freeBlock;
 
   new_ptr = m_PoolPtr + length;
   if (m_PoolPtr <= new_ptr && new_ptr < m_PoolEnd) {
@@ -162,7 +263,10 @@ void *GOMemoryPool::GetCacheData(size_t offset, size_t length) {
       touchMemory(data + i);
     if (length)
       touchMemory(data + length - 1);
-    AddPoolAlloc(data);
+
+    GOMutexLocker locker(m_mutex);
+
+    AddPoolAlloc(data, 0);
     return data;
   }
   return NULL;
@@ -173,7 +277,7 @@ void GOMemoryPool::FreeCacheFile() {
   InitPool();
 }
 
-size_t GOMemoryPool::GetAllocSize() { return m_PoolSize + m_MallocSize; }
+size_t GOMemoryPool::GetAllocSize() { return m_PoolUsed + m_MallocSize; }
 
 size_t GOMemoryPool::GetMappedSize() { return m_CacheSize; }
 
@@ -183,6 +287,18 @@ size_t GOMemoryPool::GetPoolUsage() { return m_PoolSize; }
 
 size_t GOMemoryPool::GetMemoryLimit() { return m_MemoryLimit; }
 
+GOMemoryPool::FragmentationStat GOMemoryPool::GetFragmentationStat() {
+  GOMutexLocker locker(m_mutex);
+  FragmentationStat stat;
+
+  stat.m_FreeSize = m_FreeSize;
+  stat.m_NFreeBlocks = m_FreeBlocks.size();
+  stat.m_LargestFreeBlock
+    = m_FreeBySize.empty() ? 0 : m_FreeBySize.rbegin()->first;
+  stat.m_UnusedSize = m_PoolEnd - m_PoolPtr;
+  return stat;
+}
+
 bool GOMemoryPool::IsPoolFull() { return m_AllocError > 0; }
 
 void GOMemoryPool::SetMemoryLimit(size_t limit) { m_MemoryLimit = limit; }
@@ -368,6 +484,8 @@ void GOMemoryPool::InitPool() {
   }
   m_PoolPtr = m_PoolStart;
   m_PoolEnd = m_PoolStart + m_PoolSize;
+  m_PoolUsed = 0;
+  ClearFreeBlocks();
 }
 
 void GOMemoryPool::FreePool() {
@@ -389,6 +507,8 @@ void GOMemoryPool::FreePool() {
   m_PoolStart = 0;
   m_PoolSize = 0;
   m_PoolLimit = 0;
+  m_PoolUsed = 0;
+  ClearFreeBlocks();
 
   m_CacheStart = 0;
   m_CacheSize = 0;
@@ -427,8 +547,25 @@ void GOMemoryPool::TouchMemory(std::atomic_bool &stop) {
         return;
     }
   } else {
-    for (int i = 0; m_TouchPos < m_PoolSize; m_TouchPos += m_PageSize, i++) {
-      touchMemory(m_PoolStart + m_TouchPos);
+    GOMutexLocker locker(m_mutex);
+    const size_t usedSize = m_PoolPtr - m_PoolStart;
+
+    for (int i = 0; m_TouchPos < usedSize; m_TouchPos += m_PageSize, i++) {
+      char *const pos = m_PoolStart + m_TouchPos;
+      auto next = m_FreeBlocks.upper_bound(pos);
+
+      // do not bring the released pages of the free blocks back
+      if (next != m_FreeBlocks.begin()) {
+        auto prev = std::prev(next);
+        char *const freeEnd = prev->first + prev->second;
+
+        if (pos < freeEnd && freeEnd - pos >= (ptrdiff_t)m_PageSize) {
+          // continue from the page containing freeEnd
+          m_TouchPos += ((freeEnd - pos) / m_PageSize - 1) * m_PageSize;
+          continue;
+        }
+      }
+      touchMemory(pos);
       if (stop.load() || i > 1000)
         return;
     }
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -8,15 +8,57 @@
 #ifndef GOMEMORYPOOL_H_
 #define GOMEMORYPOOL_H_
 
+#include <atomic>
+#include <map>
 #include <set>
+#include <unordered_map>
+#include <utility>
 
 #include "threading/GOMutex.h"
 
 class wxFile;
 
+/**
+ * Allocates the sample memory.
+ *
+ * The final allocations are placed into a reserved address range (the pool)
+ * that is committed in increments. A freed pool block is kept in the free
+ * lists and is reused by the later allocations: the free blocks are ordered by
+ * size, so the smallest block fitting the request is taken and the rest is
+ * split off. The adjacent free blocks are merged, a free block at the end of
+ * the used range returns to the unused range, and the whole pages of the free
+ * blocks larger than RELEASE_MIN_SIZE are returned to the OS. So freeing and
+ * allocating the samples again during a session does not grow the pool.
+ */
 class GOMemoryPool {
+public:
+  // all pool allocations are aligned to this
+  static constexpr size_t ALLOC_ALIGN = 16;
+  // a free block smaller than this is not split off an allocated one
+  static constexpr size_t MIN_SPLIT_SIZE = 256;
+  // free blocks smaller than this are not returned to the OS
+  static constexpr size_t RELEASE_MIN_SIZE = 64 * 1024;
+
+  struct FragmentationStat {
+    // the total size of the free blocks inside the used range of the pool
+    size_t m_FreeSize;
+    size_t m_NFreeBlocks;
+    size_t m_LargestFreeBlock;
+    // the pool memory after the last allocated block
+    size_t m_UnusedSize;
+  };
+
+private:
   GOMutex m_mutex;
-  std::set<void *> m_PoolAllocs;
+  // the allocated blocks and their sizes. The size is 0 for the cache data
+  std::unordered_map<void *, size_t> m_PoolAllocs;
+  // the free blocks by their addresses
+  std::map<char *, size_t> m_FreeBlocks;
+  // the free blocks by their sizes
+  std::set<std::pair<size_t, char *>> m_FreeBySize;
+  // the total size of the allocated blocks
+  size_t m_PoolUsed;
+  size_t m_FreeSize;
   char *m_PoolStart;
   char *m_PoolPtr;
   char *m_PoolEnd;
@@ -35,8 +77,18 @@ class GOMemoryPool {
   void InitPool();
   void GrowPool(size_t size);
   void FreePool();
-  void *PoolAlloc(size_t length);
-  void AddPoolAlloc(void *data);
+  // rounds up the length to the actual size of the block allocated
+  void *PoolAlloc(size_t &length);
+  void AddPoolAlloc(void *data, size_t length);
+  void AddFreeBlock(char *start, size_t length);
+  void RemoveFreeBlock(std::map<char *, size_t>::iterator it);
+  // takes the best fitting free block. Returns nullptr if there is no one
+  char *TakeFreeBlock(size_t &length);
+  // returns the block to the free lists merging it with the neighbours
+  void PoolFree(char *data, size_t length);
+  // gives the whole pages of the range back to the OS
+  void ReleasePages(char *start, char *end);
+  void ClearFreeBlocks();
 
   static size_t GetVMALimit();
   static size_t GetSystemMemory();
@@ -64,6 +116,7 @@ public:
   size_t GetPoolSize();
   size_t GetPoolUsage();
   size_t GetMemoryLimit();
+  FragmentationStat GetFragmentationStat();
 
   static size_t GetSystemMemoryLimit();
   static size_t GetPageSize();
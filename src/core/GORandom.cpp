@@ -0,0 +1,65 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GORandom.h"
+
+#include <atomic>
+
+namespace {
+
+struct ThreadState {
+  // the generation of the global seed the state is seeded from
+  uint64_t m_generation = 0;
+  uint64_t m_state = 0;
+};
+
+std::atomic<uint64_t> s_seed = 0;
+// is increased by each setSeed()
+std::atomic<uint64_t> s_generation = 1;
+std::atomic<uint64_t> s_NThreads = 0;
+thread_local ThreadState t_state;
+
+// splitmix64: turns any seed including 0 into a well mixed non-zero state
+uint64_t mix(uint64_t x) {
+  x += 0x9E3779B97F4A7C15ull;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+  x ^= x >> 31;
+  return x ? x : 0x9E3779B97F4A7C15ull;
+}
+
+} // namespace
+
+void GORandom::setSeed(uint64_t seed) {
+  s_seed.store(seed, std::memory_order_relaxed);
+  s_generation.fetch_add(1, std::memory_order_release);
+}
+
+void GORandom::seedThread(uint64_t seed) {
+  t_state.m_generation = s_generation.load(std::memory_order_acquire);
+  t_state.m_state = mix(seed);
+}
+
+uint32_t GORandom::next() {
+  ThreadState &state = t_state;
+  const uint64_t generation = s_generation.load(std::memory_order_acquire);
+
+  if (state.m_generation != generation) {
+    state.m_generation = generation;
+    state.m_state = mix(
+      s_seed.load(std::memory_order_relaxed)
+      ^ mix(s_NThreads.fetch_add(1, std::memory_order_relaxed)));
+  }
+
+  // xorshift64*
+  uint64_t x = state.m_state;
+
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+  state.m_state = x;
+  return (uint32_t)((x * 0x2545F4914F6CDD1Dull) >> 32);
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GORANDOM_H
+#define GORANDOM_H
+
+#include <cstdint>
+
+/**
+ * A pseudo random generator for the real-time code.
+ *
+ * Each thread has its own generator state, so unlike rand() no lock is taken
+ * and the threads do not disturb the sequences of each other. The state of a
+ * thread is seeded on the first use from the global seed and the sequence
+ * number of the thread. setSeed() changes the global seed and makes all
+ * threads reseed on their next use; seedThread() seeds the calling thread
+ * explicitly, so a render on that thread can be reproduced exactly.
+ */
+class GORandom {
+public:
+  static void setSeed(uint64_t seed);
+  static void seedThread(uint64_t seed);
+
+  // returns the next random 32-bit value of the calling thread
+  static uint32_t next();
+
+  // returns a random value in [0, n). n must be positive
+  static unsigned nextBelow(unsigned n) {
+    return (unsigned)(((uint64_t)next() * n) >> 32);
+  }
+
+  // returns a random value in [-1, 1)
+  static float nextSigned() {
+    return (int32_t)next() * (1.0f / 2147483648.0f);
+  }
+};
+
+#endif /* GORANDOM_H */
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -22,10 +22,13 @@ void GOSampleStatistic::Init() {
   m_Valid = true;
   m_MemorySize = 0;
   m_EndSegmentSize = 0;
+  m_TruncatedSize = 0;
   m_MinBitsPerSample = 0xff;
   m_MaxBitsPerSample = 0;
   m_UsedBits = 0;
   m_AllocatedSamples = 0;
+  m_RenderNs = 0;
+  m_NRenderedPeriods = 0;
 }
 
 void GOSampleStatistic::Cumulate(const GOSampleStatistic &stat) {
@@ -34,12 +37,15 @@ void GOSampleStatistic::Cumulate(const GOSampleStatistic &stat) {
   Prepare();
   m_MemorySize += stat.m_MemorySize;
   m_EndSegmentSize += stat.m_EndSegmentSize;
+  m_TruncatedSize += stat.m_TruncatedSize;
   if (m_MinBitsPerSample > stat.m_MinBitsPerSample)
     m_MinBitsPerSample = stat.m_MinBitsPerSample;
   if (m_MaxBitsPerSample < stat.m_MaxBitsPerSample)
     m_MaxBitsPerSample = stat.m_MaxBitsPerSample;
   m_UsedBits += stat.m_UsedBits;
   m_AllocatedSamples += stat.m_AllocatedSamples;
+  m_RenderNs += stat.m_RenderNs;
+  m_NRenderedPeriods += stat.m_NRenderedPeriods;
 }
 
 bool GOSampleStatistic::IsValid() const { return m_Valid; }
@@ -68,6 +74,26 @@ void GOSampleStatistic::SetBitsPerSample(
 
 size_t GOSampleStatistic::GetEndSegmentSize() const { return m_EndSegmentSize; }
 
+void GOSampleStatistic::SetTruncatedSize(size_t size) {
+  Prepare();
+  m_TruncatedSize = size;
+}
+
+size_t GOSampleStatistic::GetTruncatedSize() const { return m_TruncatedSize; }
+
+void GOSampleStatistic::SetRenderTime(
+  uint64_t renderNs, uint64_t nRenderedPeriods) {
+  Prepare();
+  m_RenderNs = renderNs;
+  m_NRenderedPeriods = nRenderedPeriods;
+}
+
+uint64_t GOSampleStatistic::GetRenderNs() const { return m_RenderNs; }
+
+uint64_t GOSampleStatistic::GetNRenderedPeriods() const {
+  return m_NRenderedPeriods;
+}
+
 unsigned GOSampleStatistic::GetMinBitPerSample() const {
   return m_MinBitsPerSample;
 }
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -9,16 +9,22 @@
 #define GOSAMPLESTATISTIC_H
 
 #include <stddef.h>
+#include <stdint.h>
 
 class GOSampleStatistic {
 private:
   bool m_Valid;
   size_t m_MemorySize;
   size_t m_EndSegmentSize;
+  // the size of the sample data cut off at load time by release truncation
+  size_t m_TruncatedSize;
   unsigned m_MinBitsPerSample;
   unsigned m_MaxBitsPerSample;
   size_t m_AllocatedSamples;
   size_t m_UsedBits;
+  // the time spent on rendering the samplers and the number of their periods
+  uint64_t m_RenderNs;
+  uint64_t m_NRenderedPeriods;
 
   void Prepare();
 
@@ -31,14 +37,19 @@ public:
 
   void SetMemorySize(size_t size);
   void SetEndSegmentSize(size_t size);
+  void SetTruncatedSize(size_t size);
   void SetBitsPerSample(unsigned bits, unsigned samples, unsigned max_value);
+  void SetRenderTime(uint64_t renderNs, uint64_t nRenderedPeriods);
 
   bool IsValid() const;
   size_t GetMemorySize() const;
   size_t GetEndSegmentSize() const;
+  size_t GetTruncatedSize() const;
   unsigned GetMinBitPerSample() const;
   unsigned GetMaxBitPerSample() const;
   float GetUsedBits() const;
+  uint64_t GetRenderNs() const;
+  uint64_t GetNRenderedPeriods() const;
 };
 
 #endif
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -9,6 +9,9 @@
 
 #include <wx/intl.h>
 #include <wx/log.h>
+#include <zlib.h>
+
+#include <algorithm>
 
 #include "files/GOInvalidFile.h"
 #include "threading/GOMutexLocker.h"
@@ -17,13 +20,30 @@
 #include "GOArchiveIndex.h"
 #include "GOArchiveReader.h"
 
+// the size of the chunks read by VerifyContent
+static constexpr size_t VERIFY_BUFFER_SIZE = 1024 * 1024;
+
 GOArchive::GOArchive(const wxString &cachePath)
-  : m_CachePath(cachePath), m_ID(), m_Dependencies(), m_Entries(), m_Path() {}
+  : m_CachePath(cachePath),
+    m_ID(),
+    m_Dependencies(),
+    m_Entries(),
+    m_IsIndexChanged(false),
+    m_Path() {}
 
 GOArchive::~GOArchive() { Close(); }
 
+void GOArchive::BuildEntryIndex() {
+  m_EntryIndex.clear();
+  m_EntryIndex.reserve(m_Entries.size());
+  for (unsigned i = 0; i < m_Entries.size(); i++)
+    m_EntryIndex[m_Entries[i].name] = i;
+}
+
 bool GOArchive::OpenArchive(const wxString &path) {
   m_Entries.clear();
+  m_EntryIndex.clear();
+  m_IsIndexChanged = false;
   m_Path = path;
   if (!m_File.Open(path, wxFile::read)) {
     wxLogError(_("Failed to open '%s'"), path.c_str());
@@ -31,8 +51,10 @@ bool GOArchive::OpenArchive(const wxString &path) {
   }
   {
     GOArchiveIndex index(m_CachePath, m_Path);
-    if (index.ReadIndex(m_ID, m_Entries))
+    if (index.ReadIndex(m_ID, m_Entries)) {
+      BuildEntryIndex();
       return true;
+    }
   }
 
   GOArchiveReader reader(m_File);
@@ -41,30 +63,61 @@ bool GOArchive::OpenArchive(const wxString &path) {
     return false;
   }
 
+  BuildEntryIndex();
+
   GOArchiveIndex index(m_CachePath, m_Path);
   index.WriteIndex(m_ID, m_Entries);
   return true;
 }
 
 void GOArchive::Close() {
+  if (m_IsIndexChanged) {
+    GOArchiveIndex index(m_CachePath, m_Path);
+
+    index.WriteIndex(m_ID, m_Entries);
+    m_IsIndexChanged = false;
+  }
   m_File.Close();
   m_Entries.clear();
+  m_EntryIndex.clear();
 }
 
 bool GOArchive::containsFile(const wxString &name) {
-  for (unsigned i = 0; i < m_Entries.size(); i++)
-    if (m_Entries[i].name == name)
-      return true;
-  return false;
+  return m_EntryIndex.find(name) != m_EntryIndex.end();
+}
+
+const GOArchiveEntry *GOArchive::FindEntry(const wxString &name) const {
+  auto it = m_EntryIndex.find(name);
+
+  return it != m_EntryIndex.end() ? &m_Entries[it->second] : nullptr;
 }
 
 GOOpenedFile *GOArchive::OpenFile(const wxString &name) {
-  for (unsigned i = 0; i < m_Entries.size(); i++)
-    if (m_Entries[i].name == name) {
-      return new GOArchiveEntryFile(
-        this, m_Entries[i].name, m_Entries[i].offset, m_Entries[i].len);
-    }
-  return new GOInvalidFile(name);
+  auto it = m_EntryIndex.find(name);
+
+  if (it == m_EntryIndex.end())
+    return new GOInvalidFile(name);
+
+  const GOArchiveEntry &e = m_Entries[it->second];
+  GOArchiveEntry::CrcState crcState;
+
+  {
+    GOMutexLocker lock(m_Mutex);
+
+    crcState = e.crc_state;
+  }
+  if (crcState == GOArchiveEntry::CRC_MISMATCH)
+    wxLogError(
+      _("CRC mismatch of '%s' in organ package - file corrupted?"),
+      e.name.c_str());
+  return new GOArchiveEntryFile(
+    this,
+    e.name,
+    e.offset,
+    e.len,
+    it->second,
+    e.crc,
+    crcState == GOArchiveEntry::CRC_UNCHECKED);
 }
 
 size_t GOArchive::ReadContent(void *buffer, size_t offset, size_t len) {
@@ -78,6 +131,64 @@ size_t GOArchive::ReadContent(void *buffer, size_t offset, size_t len) {
   return l;
 }
 
+void GOArchive::SetCrcChecked(unsigned index, bool isOk) {
+  GOMutexLocker lock(m_Mutex);
+
+  if (index < m_Entries.size()) {
+    GOArchiveEntry &e = m_Entries[index];
+
+    e.crc_state
+      = isOk ? GOArchiveEntry::CRC_OK : GOArchiveEntry::CRC_MISMATCH;
+    m_IsIndexChanged = true;
+    if (!isOk)
+      wxLogError(
+        _("CRC mismatch of '%s' in organ package - file corrupted?"),
+        e.name.c_str());
+  }
+}
+
+uint64_t GOArchive::GetUncheckedLength() const {
+  uint64_t length = 0;
+
+  for (const GOArchiveEntry &e : m_Entries)
+    if (e.crc_state == GOArchiveEntry::CRC_UNCHECKED)
+      length += e.len;
+  return length;
+}
+
+unsigned GOArchive::VerifyContent(
+  const std::function<bool(size_t)> &onProgress) {
+  std::vector<uint8_t> buffer(VERIFY_BUFFER_SIZE);
+  unsigned nMismatches = 0;
+  bool isCancelled = false;
+
+  for (unsigned i = 0; i < m_Entries.size() && !isCancelled; i++) {
+    const GOArchiveEntry &e = m_Entries[i];
+
+    if (e.crc_state == GOArchiveEntry::CRC_UNCHECKED) {
+      uint32_t crc = crc32(0, Z_NULL, 0);
+      size_t pos = 0;
+
+      while (pos < e.len && !isCancelled) {
+        const size_t len = ReadContent(
+          buffer.data(), e.offset + pos, std::min(e.len - pos, buffer.size()));
+
+        if (!len)
+          break;
+        crc = crc32(crc, buffer.data(), len);
+        pos += len;
+        isCancelled = !onProgress(len);
+      }
+      // the content that can not be read is considered as corrupted
+      if (pos == e.len || !isCancelled)
+        SetCrcChecked(i, pos == e.len && crc == e.crc);
+    }
+    if (e.crc_state == GOArchiveEntry::CRC_MISMATCH)
+      nMismatches++;
+  }
+  return nMismatches;
+}
+
 const wxString &GOArchive::GetArchiveID() { return m_ID; }
 const wxString &GOArchive::GetPath() { return m_Path; }
 
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -9,8 +9,12 @@
 #define GOARCHIVE_H
 
 #include <wx/file.h>
+#include <wx/hashmap.h>
 #include <wx/string.h>
 
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
 #include <vector>
 
 #include "threading/GOMutex.h"
@@ -25,9 +29,16 @@ private:
   wxString m_ID;
   std::vector<wxString> m_Dependencies;
   std::vector<GOArchiveEntry> m_Entries;
+  // the entry number by the name
+  std::unordered_map<wxString, unsigned, wxStringHash, wxStringEqual>
+    m_EntryIndex;
+  // whether the crc states of the entries are changed since the index was read
+  bool m_IsIndexChanged;
   wxFile m_File;
   wxString m_Path;
 
+  void BuildEntryIndex();
+
 public:
   GOArchive(const wxString &cachePath);
   ~GOArchive();
@@ -36,10 +47,27 @@ public:
   void Close();
 
   bool containsFile(const wxString &name);
+  // returns nullptr if there is no such file
+  const GOArchiveEntry *FindEntry(const wxString &name) const;
   GOOpenedFile *OpenFile(const wxString &name);
 
   size_t ReadContent(void *buffer, size_t offset, size_t len);
 
+  /**
+   * Remembers the result of the crc check of the entry made when it was read.
+   * The results are saved to the index on Close()
+   */
+  void SetCrcChecked(unsigned index, bool isOk);
+  // Returns the total length of the entries not checked against the crc yet
+  uint64_t GetUncheckedLength() const;
+  /**
+   * Checks the crc of all entries not checked yet
+   * @param onProgress is called with the length of the data checked since the
+   *   previous call. If it returns false then the checking is cancelled
+   * @return the number of the entries with a crc mismatch
+   */
+  unsigned VerifyContent(const std::function<bool(size_t)> &onProgress);
+
   const wxString &GetArchiveID();
   const wxString &GetPath();
 
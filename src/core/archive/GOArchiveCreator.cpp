@@ -2,7 +2,7 @@
  * GrandOrgue - a free pipe organ simulator
  *
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  *
  * This program is free software; you can redistribute it and/or
  * modify it under the terms of the GNU General Public License as
@@ -33,20 +33,31 @@
 
 #include "GOArchive.h"
 #include "GOArchiveFile.h"
+#include "GOArchiveIndex.h"
 #include "GOCompress.h"
+#include "GOHash.h"
 #include "GOOrgan.h"
 #include "GOWave.h"
 #include "go_path.h"
 
+static const wxString SOURCES_INDEX_NAME = wxT("packagesources.ini");
+
 GOArchiveCreator::GOArchiveCreator(const wxString &cacheDir)
-  : m_OrganList(),
+  : m_CacheDir(cacheDir),
+    m_OrganList(),
     m_Manager(m_OrganList, cacheDir),
     m_Output(),
     m_packageIDs(),
     m_packages(),
     m_organs(),
     m_OrganPaths(),
-    m_PackageTitle() {}
+    m_PackageTitle(),
+    m_PackagePath(),
+    m_WritePath(),
+    mp_PrevPackage(),
+    m_PrevSources(),
+    m_Sources(),
+    m_NReusedFiles(0) {}
 
 GOArchiveCreator::~GOArchiveCreator() {}
 
@@ -112,10 +123,137 @@ bool GOArchiveCreator::storeFile(
   return true;
 }
 
+bool GOArchiveCreator::SetPreviousPackage(const wxString &path) {
+  std::unique_ptr<GOArchive> archive = std::make_unique<GOArchive>(m_CacheDir);
+
+  if (!archive->OpenArchive(path)) {
+    wxLogError(_("Failed to open the previous organ package %s"), path.c_str());
+    return false;
+  }
+  m_PrevSources.clear();
+  if (archive->containsFile(SOURCES_INDEX_NAME)) {
+    std::unique_ptr<GOOpenedFile> file(archive->OpenFile(SOURCES_INDEX_NAME));
+
+    readSourcesIndex(file.get());
+  } else
+    wxLogWarning(
+      _("The previous organ package %s has no information about its source "
+        "files. All files will be processed again"),
+      path.c_str());
+  mp_PrevPackage = std::move(archive);
+  return true;
+}
+
+void GOArchiveCreator::readSourcesIndex(GOOpenedFile *file) {
+  GOConfigFileReader cfg;
+
+  if (!cfg.Read(file))
+    return;
+  for (const auto &group : cfg.GetContent()) {
+    const std::map<wxString, wxString> &values = group.second;
+    auto name = values.find(wxT("Name"));
+    auto size = values.find(wxT("Size"));
+    auto time = values.find(wxT("Time"));
+    auto hash = values.find(wxT("Hash"));
+    SourceInfo source;
+    wxLongLong_t value;
+
+    if (
+      !group.first.StartsWith(wxT("Source")) || name == values.end()
+      || size == values.end() || time == values.end() || hash == values.end())
+      continue;
+    if (!size->second.ToLongLong(&value))
+      continue;
+    source.size = value;
+    if (!time->second.ToLongLong(&value))
+      continue;
+    source.time = value;
+    source.hash = hash->second;
+    m_PrevSources[name->second] = source;
+  }
+}
+
+bool GOArchiveCreator::writeSourcesIndex() {
+  GOConfigFileWriter cfg_file;
+  GOConfigWriter cfg(cfg_file, false);
+  unsigned i = 0;
+
+  cfg.WriteInteger(wxT("General"), wxT("SourceCount"), m_Sources.size());
+  for (const auto &entry : m_Sources) {
+    wxString group = wxString::Format(wxT("Source%06u"), ++i);
+
+    cfg.WriteString(group, wxT("Name"), entry.first);
+    cfg.WriteString(
+      group,
+      wxT("Size"),
+      wxString::Format(wxT("%llu"), (unsigned long long)entry.second.size));
+    cfg.WriteString(
+      group,
+      wxT("Time"),
+      wxString::Format(wxT("%lld"), (long long)entry.second.time));
+    cfg.WriteString(group, wxT("Hash"), entry.second.hash);
+  }
+
+  GOBuffer<uint8_t> buf;
+  if (!cfg_file.GetFileContent(buf))
+    return false;
+  return m_Output.Add(SOURCES_INDEX_NAME, buf);
+}
+
+/**
+ * Returns the member of the previous package that has been made from the same
+ * source. The source is the same if it has the same size and either the same
+ * modification time or, if source.hash is filled, the same content hash
+ */
+const GOArchiveEntry *GOArchiveCreator::findReusableEntry(
+  const wxString &name, SourceInfo &source) {
+  if (!mp_PrevPackage)
+    return nullptr;
+
+  auto prev = m_PrevSources.find(name);
+
+  if (
+    prev == m_PrevSources.end() || prev->second.size != source.size
+    || (prev->second.time != source.time && prev->second.hash != source.hash))
+    return nullptr;
+  // the file may have become a part of a dependency package
+  for (unsigned i = 0; i < m_packages.size(); i++)
+    if (m_packages[i]->containsFile(name))
+      return nullptr;
+
+  const GOArchiveEntry *entry = mp_PrevPackage->FindEntry(name);
+
+  if (entry)
+    source.hash = prev->second.hash;
+  return entry;
+}
+
+bool GOArchiveCreator::copyPreviousFile(
+  const wxString &name, const GOArchiveEntry &entry) {
+  std::unique_ptr<GOOpenedFile> file(mp_PrevPackage->OpenFile(name));
+
+  if (!m_Output.Copy(name, *file, entry.crc)) {
+    wxLogError(
+      _("Failed to copy %s from the previous organ package"), name.c_str());
+    return false;
+  }
+  m_NReusedFiles++;
+  return true;
+}
+
 bool GOArchiveCreator::CreatePackage(
   const wxString &path, const wxString title) {
   m_PackageTitle = title;
-  if (!m_Output.Open(path)) {
+  m_PackagePath = path;
+  m_WritePath = path;
+  // the previous package is still read while the new one is written
+  if (
+    mp_PrevPackage
+    && wxFileName(path).SameAs(wxFileName(mp_PrevPackage->GetPath())))
+    m_WritePath = path + wxT(".new");
+  m_Sources.clear();
+  m_NReusedFiles = 0;
+  if (!m_Output.Open(m_WritePath)) {
     wxLogError(_("Failed creating organ package file %s"), path.c_str());
     return false;
   }
@@ -165,6 +303,10 @@ bool GOArchiveCreator::FinishPackage() {
     if (!addOrganData(i, f.get()))
       return false;
   }
+  if (!writeSourcesIndex()) {
+    wxLogError(_("Failed writing the package sources file"));
+    return false;
+  }
   if (!writePackageIndex()) {
     wxLogError(_("Failed writing the package index file"));
     return false;
@@ -173,6 +315,19 @@ bool GOArchiveCreator::FinishPackage() {
     wxLogError(_("Failed writing the package directory"));
     return false;
   }
+  if (mp_PrevPackage) {
+    wxLogInfo(
+      _("%u files have been copied from the previous organ package"),
+      m_NReusedFiles);
+    mp_PrevPackage.reset();
+  }
+  if (
+    m_WritePath != m_PackagePath
+    && !wxRenameFile(m_WritePath, m_PackagePath)) {
+    wxLogError(
+      _("Failed to replace the organ package %s"), m_PackagePath.c_str());
+    return false;
+  }
   return true;
 }
 
@@ -203,12 +358,11 @@ bool GOArchiveCreator::AddDirectory(const wxString &path) {
   files.Sort();
   for (unsigned i = 0; i < files.size(); i++) {
     wxFileName fname(files[i]);
-    GOBuffer<uint8_t> buf;
+    SourceInfo source;
     GOStandardFile f(files[i]);
-    if (!f.ReadContent(buf)) {
-      wxLogError(_("Failed to read file %s"), files[i].c_str());
-      return false;
-    }
+
+    source.size = fname.GetSize().GetValue();
+    source.time = fname.GetModificationTime().GetTicks();
     if (!checkExtension(files[i], fname.GetExt()))
       wxLogError(_("Unknown filetype %s"), files[i].c_str());
     if (!fname.MakeRelativeTo(dir)) {
@@ -217,18 +371,44 @@ bool GOArchiveCreator::AddDirectory(const wxString &path) {
     }
     wxString fn = fname.GetLongPath();
     fn.Replace(wxFileName::GetPathSeparator(), wxT("\\"));
-    if (fn == "organindex.ini")
+    if (fn == "organindex.ini" || fn == SOURCES_INDEX_NAME)
       continue;
-    if (!compressData(fn, fname.GetExt().Lower(), buf)) {
-      wxLogError(_("failed to compress data %s"), fn.c_str());
-      return false;
+
+    // the size and the modification time are enough to skip reading the file
+    const GOArchiveEntry *prevEntry = findReusableEntry(fn, source);
+
+    if (prevEntry) {
+      if (!copyPreviousFile(fn, *prevEntry))
+        return false;
+    } else {
+      GOBuffer<uint8_t> buf;
+      if (!f.ReadContent(buf)) {
+        wxLogError(_("Failed to read file %s"), files[i].c_str());
+        return false;
+      }
+
+      GOHash hash;
+      hash.Update(buf.get(), buf.GetSize());
+      source.hash = hash.getStringHash();
+      // the file might have been touched without changing the content
+      prevEntry = findReusableEntry(fn, source);
+      if (prevEntry) {
+        if (!copyPreviousFile(fn, *prevEntry))
+          return false;
+      } else {
+        if (!compressData(fn, fname.GetExt().Lower(), buf)) {
+          wxLogError(_("failed to compress data %s"), fn.c_str());
+          return false;
+        }
+        if (!storeFile(fn, buf))
+          return false;
+      }
     }
     for (unsigned i = 0; i < m_OrganPaths.size(); i++)
       if (m_OrganPaths[i] == fn)
         if (!addOrganData(i, &f))
           return false;
-    if (!storeFile(fn, buf))
-      return false;
+    m_Sources[fn] = source;
   }
   return true;
 }
@@ -2,7 +2,7 @@
  * GrandOrgue - a free pipe organ simulator
  *
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  *
  * This program is free software; you can redistribute it and/or
  * modify it under the terms of the GNU General Public License as
@@ -22,15 +22,32 @@
 #ifndef GRANDORGUEARCHIVECREATOR_H
 #define GRANDORGUEARCHIVECREATOR_H
 
+#include <cstdint>
+#include <map>
+#include <memory>
+
 #include "GOArchiveManager.h"
 #include "GOArchiveWriter.h"
 #include "GOOrganList.h"
 
 class GOOpenedFile;
 class GOOrgan;
+typedef struct _GOArchiveEntry GOArchiveEntry;
 
 class GOArchiveCreator {
 private:
+  /**
+   * What the package member was made from. Stored in the package, so the next
+   * build may detect the unchanged source files
+   */
+  struct SourceInfo {
+    uint64_t size;
+    int64_t time;
+    // the sha1 of the source content
+    wxString hash;
+  };
+
+  wxString m_CacheDir;
   GOOrganList m_OrganList;
   GOArchiveManager m_Manager;
   GOArchiveWriter m_Output;
@@ -39,9 +56,23 @@ private:
   ptr_vector<GOOrgan> m_organs;
   std::vector<wxString> m_OrganPaths;
   wxString m_PackageTitle;
+  wxString m_PackagePath;
+  // differs from m_PackagePath when the previous package is overwritten
+  wxString m_WritePath;
+
+  // the previous build of the package. Its unchanged members are copied as is
+  std::unique_ptr<GOArchive> mp_PrevPackage;
+  std::map<wxString, SourceInfo> m_PrevSources;
+  std::map<wxString, SourceInfo> m_Sources;
+  unsigned m_NReusedFiles;
 
   std::unique_ptr<GOOpenedFile> findPackageFile(const wxString &name);
   bool writePackageIndex();
+  void readSourcesIndex(GOOpenedFile *file);
+  bool writeSourcesIndex();
+  const GOArchiveEntry *findReusableEntry(
+    const wxString &name, SourceInfo &source);
+  bool copyPreviousFile(const wxString &name, const GOArchiveEntry &entry);
   bool checkExtension(const wxString &name, wxString ext);
   bool storeFile(const wxString &name, const GOBuffer<uint8_t> &data);
   bool addOrganData(unsigned idx, GOOpenedFile *file);
@@ -52,6 +83,13 @@ public:
   GOArchiveCreator(const wxString &cacheDir);
   ~GOArchiveCreator();
 
+  /**
+   * Turns on the update mode: the members of the previous package whose source
+   * files have not changed since it was built are copied without reencoding.
+   * Must be called before CreatePackage. The previous package may have the
+   * same path as the new one
+   */
+  bool SetPreviousPackage(const wxString &path);
   bool CreatePackage(const wxString &path, const wxString title);
   bool AddPackage(const wxString &path);
   void AddOrgan(const wxString &path);
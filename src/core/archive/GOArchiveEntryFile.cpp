@@ -1,21 +1,33 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
 
 #include "GOArchiveEntryFile.h"
 
+#include <zlib.h>
+
 #include "GOArchive.h"
 
 GOArchiveEntryFile::GOArchiveEntryFile(
-  GOArchive *archive, const wxString &name, size_t offset, size_t len)
+  GOArchive *archive,
+  const wxString &name,
+  size_t offset,
+  size_t len,
+  unsigned index,
+  uint32_t crc,
+  bool isCrcToCheck)
   : m_archiv(archive),
     m_Name(name),
     m_Offset(offset),
     m_Length(len),
-    m_Pos(0) {}
+    m_Pos(0),
+    m_Index(index),
+    m_ExpectedCrc(crc),
+    m_IsCrcToCheck(isCrcToCheck),
+    m_Crc(crc32(0, Z_NULL, 0)) {}
 
 size_t GOArchiveEntryFile::GetSize() { return m_Length; }
 
@@ -25,6 +37,7 @@ const wxString GOArchiveEntryFile::GetPath() { return wxEmptyString; }
 
 bool GOArchiveEntryFile::Open() {
   m_Pos = 0;
+  m_Crc = crc32(0, Z_NULL, 0);
   return true;
 }
 
@@ -36,5 +49,12 @@ size_t GOArchiveEntryFile::Read(void *buffer, size_t len) {
     len = remain;
   len = m_archiv->ReadContent(buffer, m_Offset + m_Pos, len);
   m_Pos += len;
+  if (m_IsCrcToCheck && len) {
+    m_Crc = crc32(m_Crc, (const Bytef *)buffer, len);
+    if (m_Pos == m_Length) {
+      m_archiv->SetCrcChecked(m_Index, m_Crc == m_ExpectedCrc);
+      m_IsCrcToCheck = false;
+    }
+  }
   return len;
 }
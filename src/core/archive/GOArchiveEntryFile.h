@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -8,6 +8,8 @@
 #ifndef GORUGEARCHIVEENTRYFILE_H
 #define GORUGEARCHIVEENTRYFILE_H
 
+#include <cstdint>
+
 #include "files/GOOpenedFile.h"
 
 class GOArchive;
@@ -19,10 +21,26 @@ private:
   size_t m_Offset;
   size_t m_Length;
   size_t m_Pos;
+  // the entry number in the archive and the expected crc of the content
+  unsigned m_Index;
+  uint32_t m_ExpectedCrc;
+  // the crc of the content from the beginning to m_Pos if it is being checked
+  bool m_IsCrcToCheck;
+  uint32_t m_Crc;
 
 public:
+  /**
+   * @param isCrcToCheck whether to check the crc when all the content is read.
+   *   The result is passed to archive->SetCrcChecked()
+   */
   GOArchiveEntryFile(
-    GOArchive *archive, const wxString &name, size_t offset, size_t len);
+    GOArchive *archive,
+    const wxString &name,
+    size_t offset,
+    size_t len,
+    unsigned index,
+    uint32_t crc,
+    bool isCrcToCheck);
 
   size_t GetSize();
   const wxString GetName();
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -15,8 +15,11 @@
 #include "GOArchiveFile.h"
 #include "GOHash.h"
 
-/* Value which is used to identify a valid cache index file. */
-#define GRANDORGUE_INDEX_MAGIC 0x43214321
+/*
+ * Value which is used to identify a valid cache index file. It must be changed
+ * together with the format of the index entries.
+ */
+#define GRANDORGUE_INDEX_MAGIC 0x43214323
 
 GOArchiveIndex::GOArchiveIndex(const wxString &cachePath, const wxString &path)
   : m_CachePath(cachePath), m_Path(path), m_File() {}
@@ -79,6 +82,10 @@ bool GOArchiveIndex::WriteEntry(const GOArchiveEntry &e) {
     return false;
   if (!Write(&e.len, sizeof(e.len)))
     return false;
+  if (!Write(&e.crc, sizeof(e.crc)))
+    return false;
+  if (!Write(&e.crc_state, sizeof(e.crc_state)))
+    return false;
   return true;
 }
 
@@ -89,6 +96,12 @@ bool GOArchiveIndex::ReadEntry(GOArchiveEntry &e) {
     return false;
   if (!Read(&e.len, sizeof(e.len)))
     return false;
+  if (!Read(&e.crc, sizeof(e.crc)))
+    return false;
+  if (!Read(&e.crc_state, sizeof(e.crc_state)))
+    return false;
+  if (e.crc_state > GOArchiveEntry::CRC_MISMATCH)
+    return false;
   return true;
 }
 
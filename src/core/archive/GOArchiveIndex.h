@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -11,15 +11,21 @@
 #include <wx/file.h>
 #include <wx/string.h>
 
+#include <cstdint>
 #include <vector>
 
 class GOSettingDirectory;
 typedef struct _GOHashType GOHashType;
 
 typedef struct _GOArchiveEntry {
+  // whether the content has been compared with the crc
+  enum CrcState : uint8_t { CRC_UNCHECKED, CRC_OK, CRC_MISMATCH };
+
   wxString name;
   size_t offset;
   size_t len;
+  uint32_t crc;
+  CrcState crc_state;
 } GOArchiveEntry;
 
 class GOArchiveIndex {
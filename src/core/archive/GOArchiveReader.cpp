@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -10,7 +10,6 @@
 #include <wx/font.h>
 #include <wx/intl.h>
 #include <wx/log.h>
-#include <zlib.h>
 
 #include "GOArchiveIndex.h"
 #include "GOBuffer.h"
@@ -55,27 +54,6 @@ bool GOArchiveReader::GenerateFileHash(wxString &id) {
   return true;
 }
 
-uint32_t GOArchiveReader::CalculateCrc(size_t offset, size_t length) {
-  uint8_t buf[4096];
-  if (!Seek(offset)) {
-    wxLogError(_("Reading data for CRC failed"));
-    return 0;
-  }
-  uint32_t crc = crc32(0, Z_NULL, 0);
-  while (length > 0) {
-    size_t len = length;
-    if (len > sizeof(buf))
-      len = sizeof(buf);
-    if (!Read(buf, len)) {
-      wxLogError(_("Reading data for CRC failed"));
-      return 0;
-    }
-    crc = crc32(crc, buf, len);
-    length -= len;
-  }
-  return crc;
-}
-
 size_t GOArchiveReader::ExtractU64(void *ptr) {
   GOUInt64LE *p = (GOUInt64LE *)ptr;
   return *p;
@@ -89,6 +67,7 @@ size_t GOArchiveReader::ExtractU32(void *ptr) {
 bool GOArchiveReader::ReadFileRecord(
   size_t central_offset,
   GOZipCentralHeader &central,
+  NameSet &names,
   std::vector<GOArchiveEntry> &entries) {
   GOBuffer<uint8_t> central_buf(
     central.name_length + central.extra_length + central.comment_length);
@@ -322,20 +301,19 @@ bool GOArchiveReader::ReadFileRecord(
       wxLogError(_("Non-empty directory '%s'"), name.c_str());
     return true;
   }
-  for (unsigned i = 0; i < entries.size(); i++)
-    if (entries[i].name == name) {
-      wxLogError(_("Duplicate file '%s'"), name.c_str());
-      return false;
-    }
+  if (!names.insert(name).second) {
+    wxLogError(_("Duplicate file '%s'"), name.c_str());
+    return false;
+  }
   GOArchiveEntry e;
   e.name = name;
   e.name.Replace(wxT("/"), wxT("\\"));
   e.offset
     = local_offset + local.name_length + local.extra_length + sizeof(local);
   e.len = central_uncompressed_size;
+  e.crc = central.crc;
+  e.crc_state = GOArchiveEntry::CRC_UNCHECKED;
   entries.push_back(e);
-  if (CalculateCrc(e.offset, e.len) != central.crc)
-    wxLogError(_("CRC mismatch in organ package - file corrupted?"));
   return true;
 }
 
@@ -344,6 +322,8 @@ bool GOArchiveReader::ReadCentralDirectory(
   size_t entry_count,
   size_t length,
   std::vector<GOArchiveEntry> &entries) {
+  NameSet names;
+
   while (entry_count > 0) {
     GOZipCentralHeader record;
     if (length < sizeof(record)) {
@@ -364,7 +344,7 @@ bool GOArchiveReader::ReadCentralDirectory(
       wxLogError(_("Incomplete central directory entry"));
       return false;
     }
-    if (!ReadFileRecord(offset, record, entries))
+    if (!ReadFileRecord(offset, record, names, entries))
       return false;
     offset += len;
     length -= len;
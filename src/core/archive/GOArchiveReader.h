@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -10,6 +10,9 @@
 
 #include <wx/string.h>
 
+#include <wx/hashmap.h>
+
+#include <unordered_set>
 #include <vector>
 
 #include "GOZipFormat.h"
@@ -26,11 +29,18 @@ private:
   bool GenerateFileHash(wxString &id);
   size_t ExtractU64(void *ptr);
   size_t ExtractU32(void *ptr);
-  uint32_t CalculateCrc(size_t offset, size_t length);
 
+  using NameSet = std::unordered_set<wxString, wxStringHash, wxStringEqual>;
+
+  /**
+   * Reads the file record and adds it to entries. The content is not read:
+   * the crc is checked later when the file is used.
+   * @param names the names of the entries already read for detecting duplicates
+   */
   bool ReadFileRecord(
     size_t central_offset,
     GOZipCentralHeader &central,
+    NameSet &names,
     std::vector<GOArchiveEntry> &entries);
   bool ReadCentralDirectory(
     size_t offset,
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -9,6 +9,10 @@
 
 #include <zlib.h>
 
+#include <algorithm>
+
+#include "files/GOOpenedFile.h"
+
 GOArchiveWriter::GOArchiveWriter()
   : m_Offset(0), m_directory(0), m_Entries(0), m_Names() {}
 
@@ -27,7 +31,7 @@ bool GOArchiveWriter::Write(const void *data, size_t size) {
   return m_File.Write(data, size) == size;
 }
 
-bool GOArchiveWriter::Add(wxString name, const GOBuffer<uint8_t> &content) {
+bool GOArchiveWriter::BeginEntry(wxString name, size_t size, uint32_t crc) {
   name.Replace(wxT("\\"), wxT("/"));
   for (unsigned i = 0; i < m_Names.size(); i++)
     if (m_Names[i] == name)
@@ -41,7 +45,7 @@ bool GOArchiveWriter::Add(wxString name, const GOBuffer<uint8_t> &content) {
   sig.compression = 0;
   sig.modification_time = 0;
   sig.modification_date = 0;
-  sig.crc = crc32(crc32(0, Z_NULL, 0), content.get(), content.GetSize());
+  sig.crc = crc;
   sig.compressed_size = 0xffffffff;
   sig.uncompressed_size = 0xffffffff;
   sig.name_length = fname.length();
@@ -49,8 +53,8 @@ bool GOArchiveWriter::Add(wxString name, const GOBuffer<uint8_t> &content) {
   GOZipLocal64ExtendHeader locext;
   locext.header.type = 0x0001;
   locext.header.size = sizeof(locext) - sizeof(locext.header);
-  locext.uncompressed_size = content.GetSize();
-  locext.compressed_size = content.GetSize();
+  locext.uncompressed_size = size;
+  locext.compressed_size = size;
 
   GOZipCentralHeader csig;
   csig.signature = ZIP_CENTRAL_DIRECTORY_HEADER;
@@ -83,8 +87,6 @@ bool GOArchiveWriter::Add(wxString name, const GOBuffer<uint8_t> &content) {
     return false;
   if (!Write(&locext, sizeof(locext)))
     return false;
-  if (!Write(content.get(), content.GetSize()))
-    return false;
 
   GOBuffer<uint8_t> entry;
   entry.Append((const uint8_t *)&csig, sizeof(csig));
@@ -98,6 +100,32 @@ bool GOArchiveWriter::Add(wxString name, const GOBuffer<uint8_t> &content) {
   return true;
 }
 
+bool GOArchiveWriter::Add(wxString name, const GOBuffer<uint8_t> &content) {
+  return BeginEntry(
+           name,
+           content.GetSize(),
+           crc32(crc32(0, Z_NULL, 0), content.get(), content.GetSize()))
+    && Write(content.get(), content.GetSize());
+}
+
+bool GOArchiveWriter::Copy(wxString name, GOOpenedFile &file, uint32_t crc) {
+  if (!file.Open())
+    return false;
+
+  size_t rest = file.GetSize();
+  bool res = BeginEntry(name, rest, crc);
+  GOBuffer<uint8_t> buf(std::min(rest, COPY_BLOCK_SIZE));
+
+  while (res && rest > 0) {
+    size_t len = std::min(rest, buf.GetSize());
+
+    res = file.Read(buf.get(), len) == len && Write(buf.get(), len);
+    rest -= len;
+  }
+  file.Close();
+  return res;
+}
+
 bool GOArchiveWriter::Close() {
   if (!m_File.IsOpened())
     return false;
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -15,8 +15,12 @@
 #include "GOBuffer.h"
 #include "GOZipFormat.h"
 
+class GOOpenedFile;
+
 class GOArchiveWriter {
 private:
+  static constexpr size_t COPY_BLOCK_SIZE = 1 << 20;
+
   wxFile m_File;
   size_t m_Offset;
   GOBuffer<uint8_t> m_directory;
@@ -24,6 +28,8 @@ private:
   std::vector<wxString> m_Names;
 
   bool Write(const void *data, size_t size);
+  // writes the local header and registers the entry in the central directory
+  bool BeginEntry(wxString name, size_t size, uint32_t crc);
 
 public:
   GOArchiveWriter();
@@ -31,6 +37,11 @@ public:
 
   bool Open(wxString filename);
   bool Add(wxString name, const GOBuffer<uint8_t> &content);
+  /**
+   * Adds the content of the file as is without calculating the crc. Used for
+   * copying members of another archive with their known crc
+   */
+  bool Copy(wxString name, GOOpenedFile &file, uint32_t crc);
   bool Close();
 };
 
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -69,6 +69,8 @@ public:
 
   void push_back(T *ptr) { std::vector<T *>::push_back(ptr); }
 
+  void swap(ptr_vector &other) { std::vector<T *>::swap(other); }
+
   void insert(unsigned pos, T *ptr) {
     std::vector<T *>::insert(std::vector<T *>::begin() + pos, ptr);
   }
@@ -1,12 +1,14 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
 
 #include "GOMutex.h"
 
+#include "GORealtimeLog.h"
+#include "GOThreadWatchdog.h"
 #include "threading_impl.h"
 
 #define GO_PRINTCONTENTION 0
@@ -36,27 +38,33 @@ void GOMutex::DoUnlock() { m_mutex.unlock(); }
 bool GOMutex::DoTryLock() { return m_mutex.try_lock(); }
 
 bool GOMutex::LockOrStop(const char *lockerInfo, GOThread *pThread) {
-  bool isLocked = false;
-
-  if (pThread != NULL) {
-    bool isFirstTime = true;
-
-    while (!pThread->ShouldStop() && !isLocked) {
-      isLocked = DoLock(true);
-      if (!isLocked && isFirstTime) {
-        const char *currentLockerInfo = m_LockerInfo.load();
-
-        wxLogWarning(
-          "GOMutex: timeout when locking mutex %p; currentLocker=%s "
-          "newLocker=%s",
-          this,
-          wxString(currentLockerInfo),
-          wxString(LOCKER_INFO(lockerInfo)));
-        isFirstTime = false;
+  bool isLocked = DoTryLock();
+
+  if (!isLocked) {
+    // let the watchdog report what a stalled thread is waiting for
+    GOThreadWatchdog::MutexWait mutexWait(this, LOCKER_INFO(lockerInfo));
+
+    if (pThread != NULL) {
+      bool isFirstTime = true;
+
+      while (!pThread->ShouldStop() && !isLocked) {
+        isLocked = DoLock(true);
+        if (!isLocked && isFirstTime) {
+          const char *currentLockerInfo = m_LockerInfo.load();
+
+          // it may be called from an audio thread, so wxLog is not used
+          GO_RT_LOG_WARNING(
+            "GOMutex: timeout when locking mutex %p; currentLocker=%s "
+            "newLocker=%s",
+            (const void *)this,
+            currentLockerInfo,
+            LOCKER_INFO(lockerInfo));
+          isFirstTime = false;
+        }
       }
-    }
-  } else
-    isLocked = DoLock(false);
+    } else
+      isLocked = DoLock(false);
+  }
 
   if (isLocked)
     m_LockerInfo.store(LOCKER_INFO(lockerInfo));
@@ -0,0 +1,244 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GORealtimeLog.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+#include <wx/intl.h>
+
+#include "GOThread.h"
+
+GORealtimeLog::GORealtimeLog(std::chrono::nanoseconds minInterval)
+  : m_MinInterval(minInterval.count()),
+    m_EnqueuePos(0),
+    m_DequeuePos(0),
+    m_NDropped(0) {
+  for (unsigned i = 0; i < CAPACITY; i++)
+    m_cells[i].m_sequence.store(i, std::memory_order_relaxed);
+}
+
+static GORealtimeLog instance;
+
+GORealtimeLog &GORealtimeLog::getInstance() { return instance; }
+
+bool GORealtimeLog::IsAllowed(Site &site, unsigned &nSuppressed) {
+  const int64_t now = getTimeNs();
+  int64_t nextAllowed = site.m_NextAllowedTime.load(std::memory_order_relaxed);
+  // only one of the concurrent posters of the same site wins
+  bool isAllowed = now >= nextAllowed
+    && site.m_NextAllowedTime.compare_exchange_strong(
+      nextAllowed, now + m_MinInterval, std::memory_order_relaxed);
+
+  if (isAllowed)
+    nSuppressed = site.m_NSuppressed.exchange(0, std::memory_order_relaxed);
+  else
+    site.m_NSuppressed.fetch_add(1, std::memory_order_relaxed);
+  return isAllowed;
+}
+
+/*
+ * Push and Pop implement a bounded multi-producer multi-consumer queue where
+ * each cell carries a sequence number telling whether it is free for the
+ * current lap of producers or filled for the current lap of consumers
+ */
+
+void GORealtimeLog::Push(const Record &record) {
+  size_t pos = m_EnqueuePos.load(std::memory_order_relaxed);
+  Cell *pCell = nullptr;
+
+  while (!pCell) {
+    Cell &cell = m_cells[pos & (CAPACITY - 1)];
+    const size_t seq = cell.m_sequence.load(std::memory_order_acquire);
+    const intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+    if (diff == 0) { // the cell is free. Try to occupy it
+      if (m_EnqueuePos.compare_exchange_weak(
+            pos, pos + 1, std::memory_order_relaxed))
+        pCell = &cell;
+    } else if (diff < 0) { // the ring is full
+      m_NDropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    } else // another producer has occupied the cell
+      pos = m_EnqueuePos.load(std::memory_order_relaxed);
+  }
+  pCell->m_record = record;
+  pCell->m_sequence.store(pos + 1, std::memory_order_release);
+}
+
+bool GORealtimeLog::Pop(Record &record) {
+  size_t pos = m_DequeuePos.load(std::memory_order_relaxed);
+  Cell *pCell = nullptr;
+
+  while (!pCell) {
+    Cell &cell = m_cells[pos & (CAPACITY - 1)];
+    const size_t seq = cell.m_sequence.load(std::memory_order_acquire);
+    const intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+
+    if (diff == 0) { // the cell is filled. Try to take it
+      if (m_DequeuePos.compare_exchange_weak(
+            pos, pos + 1, std::memory_order_relaxed))
+        pCell = &cell;
+    } else if (diff < 0) // the ring is empty
+      return false;
+    else
+      pos = m_DequeuePos.load(std::memory_order_relaxed);
+  }
+  record = pCell->m_record;
+  pCell->m_sequence.store(pos + CAPACITY, std::memory_order_release);
+  return true;
+}
+
+void GORealtimeLog::PostText(wxLogLevel level, const wxString &text) {
+  Record record;
+  const wxScopedCharBuffer utf8 = text.utf8_str();
+  const size_t len = std::min(utf8.length(), (size_t)MAX_TEXT_LENGTH);
+
+  record.m_level = level;
+  record.m_format = nullptr;
+  record.m_NArgs = 0;
+  record.m_NSuppressed = 0;
+  memcpy(record.m_text, utf8.data(), len);
+  record.m_text[len] = 0;
+  Push(record);
+}
+
+static const char *const CONVERSIONS = "diouxXeEfFgGaAcsp";
+static const char *const LENGTH_MODIFIERS = "hlLqjzt";
+
+/**
+ * Formats one argument according to the printf conversion spec. The length
+ * modifiers of the spec are ignored because the argument is already widened
+ */
+static wxString format_arg(
+  const wxString &flags, char conversion, const GORealtimeLog::Arg &arg) {
+  wxString res;
+
+  switch (arg.m_type) {
+  case GORealtimeLog::Arg::INT:
+    res = wxString::Format(
+      "%" + flags + (strchr("dic", conversion) ? "lld" : "llu"), arg.m_int);
+    break;
+  case GORealtimeLog::Arg::UINT:
+    res = wxString::Format(
+      "%" + flags + "ll" + (strchr("ouxX", conversion) ? conversion : 'u'),
+      arg.m_uint);
+    break;
+  case GORealtimeLog::Arg::DOUBLE:
+    res = wxString::Format(
+      "%" + flags + (strchr("eEfFgGaA", conversion) ? conversion : 'g'),
+      arg.m_double);
+    break;
+  case GORealtimeLog::Arg::STRING:
+    res = wxString::Format(
+      "%" + flags + "s", arg.m_string ? arg.m_string : "(null)");
+    break;
+  case GORealtimeLog::Arg::POINTER:
+    res = wxString::Format("%p", arg.m_pointer);
+    break;
+  }
+  return res;
+}
+
+wxString GORealtimeLog::formatRecord(const Record &record) {
+  wxString res;
+
+  if (record.m_format) {
+    const wxString format = wxGetTranslation(record.m_format);
+    const size_t l = format.length();
+    unsigned argI = 0;
+
+    for (size_t i = 0; i < l; i++) {
+      const wxUniChar c = format[i];
+
+      if (c == '%' && i + 1 < l && format[i + 1] == '%') {
+        res << '%';
+        i++;
+      } else if (c == '%') {
+        // parse the spec: flags, width and precision, length, conversion
+        size_t j = i + 1;
+        wxString flags;
+
+        while (j < l && !strchr(CONVERSIONS, (char)format[j])) {
+          if (!strchr(LENGTH_MODIFIERS, (char)format[j]))
+            flags << format[j];
+          j++;
+        }
+        if (j < l && argI < record.m_NArgs)
+          res << format_arg(flags, (char)format[j], record.m_args[argI++]);
+        else // a malformed spec or too few arguments: keep it as is
+          res << format.Mid(i, j - i + 1);
+        i = j;
+      } else
+        res << c;
+    }
+  } else
+    res = wxString::FromUTF8(record.m_text);
+  if (record.m_NSuppressed)
+    res << wxString::Format(
+      _(" (%u similar messages were suppressed)"), record.m_NSuppressed);
+  return res;
+}
+
+unsigned GORealtimeLog::Drain(const Sink &sink) {
+  unsigned nDrained = 0;
+  Record record;
+
+  while (Pop(record)) {
+    sink(record.m_level, formatRecord(record));
+    nDrained++;
+  }
+
+  const unsigned nDropped = m_NDropped.exchange(0);
+
+  if (nDropped)
+    sink(
+      wxLOG_Warning,
+      wxString::Format(
+        _("%u log messages were dropped because of log overflow"), nDropped));
+  return nDrained;
+}
+
+unsigned GORealtimeLog::DrainToWxLog() {
+  return Drain([](wxLogLevel level, const wxString &msg) {
+    wxLogGeneric(level, "%s", msg);
+  });
+}
+
+/**
+ * Periodically drains the instance log to wxLog. It polls instead of waiting
+ * for a signal because signalling a condition is not allowed on the audio
+ * threads
+ */
+class GORealtimeLogThread : public GOThread {
+protected:
+  void Entry() override {
+    while (!ShouldStop()) {
+      instance.DrainToWxLog();
+      std::this_thread::sleep_for(GORealtimeLog::DRAIN_INTERVAL);
+    }
+  }
+
+public:
+  ~GORealtimeLogThread() { Stop(); }
+};
+
+static std::unique_ptr<GORealtimeLogThread> p_DrainThread;
+
+void GORealtimeLog::startDraining() {
+  if (!p_DrainThread) {
+    p_DrainThread = std::make_unique<GORealtimeLogThread>();
+    p_DrainThread->Start();
+  }
+}
+
+void GORealtimeLog::stopDraining() {
+  p_DrainThread.reset();
+  instance.DrainToWxLog();
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOREALTIMELOG_H
+#define GOREALTIMELOG_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+#include <wx/log.h>
+#include <wx/string.h>
+
+/**
+ * A log for the threads that must not block: the audio callbacks, the sound
+ * worker threads and the loader threads.
+ *
+ * Posting a message neither allocates memory nor formats it nor takes a lock.
+ * The message is stored as a structured record (a static format string and up
+ * to MAX_ARGS scalar arguments) in a preallocated lock-free ring. Later the
+ * records are formatted and passed to wxLog by a background thread, so the
+ * possible blocking in wxLog and in the GUI log window never happens on the
+ * posting thread. If the ring is full then the record is dropped and counted.
+ *
+ * Each call site is rate limited: its messages are posted not more often than
+ * once per the minimal interval. The suppressed messages are counted and their
+ * number is reported with the next posted message of the same site.
+ *
+ * Use the GO_RT_LOG_ERROR and GO_RT_LOG_WARNING macros for posting.
+ */
+class GORealtimeLog {
+public:
+  static constexpr unsigned MAX_ARGS = 6;
+  // the maximal length of a text posted with PostText()
+  static constexpr unsigned MAX_TEXT_LENGTH = 479;
+  // must be a power of 2
+  static constexpr unsigned CAPACITY = 256;
+  static constexpr std::chrono::milliseconds DEFAULT_MIN_INTERVAL{1000};
+  // how often the background thread drains the ring
+  static constexpr std::chrono::milliseconds DRAIN_INTERVAL{100};
+
+  struct Arg {
+    enum Type : uint8_t { INT, UINT, DOUBLE, STRING, POINTER };
+
+    Type m_type;
+    union {
+      long long m_int;
+      unsigned long long m_uint;
+      double m_double;
+      // must point to a static string
+      const char *m_string;
+      const void *m_pointer;
+    };
+  };
+
+  /**
+   * The rate limiting state of one call site. It is constant-initialised, so a
+   * static local instance does not require a guarded initialisation
+   */
+  class Site {
+  private:
+    friend class GORealtimeLog;
+
+    // steady clock time in ns when the next message may be posted
+    std::atomic<int64_t> m_NextAllowedTime;
+    std::atomic<unsigned> m_NSuppressed;
+
+  public:
+    constexpr Site() : m_NextAllowedTime(0), m_NSuppressed(0) {}
+  };
+
+  struct Record {
+    wxLogLevel m_level;
+    // a static format string in the printf style. Nullptr if m_text is used
+    const char *m_format;
+    unsigned m_NArgs;
+    Arg m_args[MAX_ARGS];
+    // how many messages of the same site were suppressed before this one
+    unsigned m_NSuppressed;
+    char m_text[MAX_TEXT_LENGTH + 1];
+  };
+
+  // Post() copies the records by value, so it must not allocate
+  static_assert(
+    std::is_trivially_copyable_v<Record>,
+    "A GORealtimeLog record must be copied without allocating");
+
+  using Sink = std::function<void(wxLogLevel level, const wxString &msg)>;
+
+private:
+  struct Cell {
+    std::atomic<size_t> m_sequence;
+    Record m_record;
+  };
+
+  const int64_t m_MinInterval;
+  Cell m_cells[CAPACITY];
+  std::atomic<size_t> m_EnqueuePos;
+  std::atomic<size_t> m_DequeuePos;
+  std::atomic<unsigned> m_NDropped;
+
+  template <typename T> static Arg toArg(T value) {
+    Arg arg;
+
+    if constexpr (std::is_floating_point_v<T>) {
+      arg.m_type = Arg::DOUBLE;
+      arg.m_double = value;
+    } else if constexpr (std::is_enum_v<T> || std::is_signed_v<T>) {
+      arg.m_type = Arg::INT;
+      arg.m_int = (long long)value;
+    } else if constexpr (std::is_unsigned_v<T>) {
+      arg.m_type = Arg::UINT;
+      arg.m_uint = value;
+    } else if constexpr (std::is_convertible_v<T, const char *>) {
+      arg.m_type = Arg::STRING;
+      arg.m_string = value;
+    } else {
+      static_assert(std::is_pointer_v<T>, "Unsupported GORealtimeLog argument");
+      arg.m_type = Arg::POINTER;
+      arg.m_pointer = (const void *)value;
+    }
+    return arg;
+  }
+
+  static int64_t getTimeNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+  }
+
+  /**
+   * Checks the rate limit of the site. Returns whether a message may be posted
+   * now. If yes then returns the number of suppressed messages in nSuppressed
+   */
+  bool IsAllowed(Site &site, unsigned &nSuppressed);
+
+  // Puts the record to the ring. If the ring is full then drops it
+  void Push(const Record &record);
+  bool Pop(Record &record);
+
+public:
+  GORealtimeLog(
+    std::chrono::nanoseconds minInterval = DEFAULT_MIN_INTERVAL);
+
+  // the log instance used by the GO_RT_LOG_* macros
+  static GORealtimeLog &getInstance();
+
+  /**
+   * Posts a message. Never blocks and never allocates memory.
+   * @param site the rate limiting state of the call site
+   * @param level wxLOG_Error, wxLOG_Warning etc
+   * @param format a static printf-like format string. It may be marked with
+   *   wxTRANSLATE; it is translated when formatting
+   * @param args not more than MAX_ARGS numbers, pointers or static strings
+   */
+  template <typename... Args>
+  void Post(Site &site, wxLogLevel level, const char *format, Args... args) {
+    static_assert(sizeof...(Args) <= MAX_ARGS, "Too many GORealtimeLog args");
+
+    unsigned nSuppressed;
+
+    if (IsAllowed(site, nSuppressed)) {
+      Record record;
+
+      record.m_level = level;
+      record.m_format = format;
+      record.m_NArgs = 0;
+      ((record.m_args[record.m_NArgs++] = toArg(args)), ...);
+      record.m_NSuppressed = nSuppressed;
+      record.m_text[0] = 0;
+      Push(record);
+    }
+  }
+
+  /**
+   * Posts an already formatted message. It copies the text truncating it to
+   * MAX_TEXT_LENGTH. Converting a wxString may allocate, so it is intended for
+   * the loader threads and not for the audio ones.
+   */
+  void PostText(wxLogLevel level, const wxString &text);
+
+  unsigned GetNDropped() const { return m_NDropped.load(); }
+
+  /**
+   * Formats one record
+   */
+  static wxString formatRecord(const Record &record);
+
+  /**
+   * Formats all posted records and passes them to the sink. May be called
+   * from one thread at a time
+   * @return the number of records drained
+   */
+  unsigned Drain(const Sink &sink);
+
+  // Drains all posted records to wxLog
+  unsigned DrainToWxLog();
+
+  // Start the background thread draining the instance log to wxLog
+  static void startDraining();
+  // Stop the background thread and drain the rest of records
+  static void stopDraining();
+};
+
+#define GO_RT_LOG(level, format, ...)                                          \
+  do {                                                                         \
+    static GORealtimeLog::Site goRtLogSite;                                    \
+                                                                               \
+    GORealtimeLog::getInstance().Post(                                         \
+      goRtLogSite, level, format, ##__VA_ARGS__);                              \
+  } while (false)
+
+#define GO_RT_LOG_ERROR(format, ...)                                           \
+  GO_RT_LOG(wxLOG_Error, format, ##__VA_ARGS__)
+#define GO_RT_LOG_WARNING(format, ...)                                         \
+  GO_RT_LOG(wxLOG_Warning, format, ##__VA_ARGS__)
+
+#endif /* GOREALTIMELOG_H */
@@ -0,0 +1,370 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOThreadWatchdog.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <wx/intl.h>
+#include <wx/log.h>
+
+#include "GOMutex.h"
+#include "GOThread.h"
+
+#if __has_include(<execinfo.h>) && __has_include(<pthread.h>)
+#define GO_WATCHDOG_CAPTURES_STACK 1
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+
+#include <execinfo.h>
+#include <pthread.h>
+#else
+#define GO_WATCHDOG_CAPTURES_STACK 0
+#endif
+
+static int64_t get_time_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+static uintptr_t get_current_thread_handle() {
+#if GO_WATCHDOG_CAPTURES_STACK
+  return (uintptr_t)pthread_self();
+#else
+  return 0;
+#endif
+}
+
+static std::atomic_bool s_IsStarted(false);
+// the heartbeat the current thread is busy with
+static thread_local GOThreadWatchdog::Heartbeat *t_pCurrent = nullptr;
+
+static std::mutex s_RegistryMutex;
+static GOThreadWatchdog::Heartbeat *p_FirstHeartbeat = nullptr;
+
+GOThreadWatchdog::Heartbeat::Heartbeat(const char *name)
+  : m_name(name),
+    m_BusySince(0),
+    m_ThreadHandle(0),
+    m_WaitedMutex(nullptr),
+    m_WaiterInfo(nullptr),
+    p_prev(nullptr),
+    m_ReportedSince(0) {
+  std::lock_guard<std::mutex> lock(s_RegistryMutex);
+
+  p_next = p_FirstHeartbeat;
+  if (p_next)
+    p_next->p_prev = this;
+  p_FirstHeartbeat = this;
+}
+
+GOThreadWatchdog::Heartbeat::~Heartbeat() {
+  std::lock_guard<std::mutex> lock(s_RegistryMutex);
+
+  if (p_prev)
+    p_prev->p_next = p_next;
+  else
+    p_FirstHeartbeat = p_next;
+  if (p_next)
+    p_next->p_prev = p_prev;
+  if (t_pCurrent == this)
+    t_pCurrent = nullptr;
+}
+
+void GOThreadWatchdog::Heartbeat::Beat() {
+  if (s_IsStarted.load(std::memory_order_relaxed)) {
+    m_ThreadHandle.store(get_current_thread_handle(), std::memory_order_relaxed);
+    t_pCurrent = this;
+    m_BusySince.store(get_time_ns(), std::memory_order_release);
+  }
+}
+
+void GOThreadWatchdog::Heartbeat::Idle() {
+  m_BusySince.store(0, std::memory_order_relaxed);
+  if (t_pCurrent == this)
+    t_pCurrent = nullptr;
+}
+
+GOThreadWatchdog::MutexWait::MutexWait(
+  const GOMutex *pMutex, const char *waiterInfo)
+  : p_heartbeat(t_pCurrent) {
+  if (p_heartbeat) {
+    p_heartbeat->m_WaiterInfo.store(waiterInfo, std::memory_order_relaxed);
+    p_heartbeat->m_WaitedMutex.store(pMutex, std::memory_order_release);
+  }
+}
+
+GOThreadWatchdog::MutexWait::~MutexWait() {
+  if (p_heartbeat)
+    p_heartbeat->m_WaitedMutex.store(nullptr, std::memory_order_relaxed);
+}
+
+#if GO_WATCHDOG_CAPTURES_STACK
+
+/*
+ * The stack of another thread is captured by sending a signal to it. The signal
+ * handler calls backtrace() into a static buffer and the watchdog thread
+ * symbolizes the frames afterwards. SIGURG is used because it is ignored by
+ * default, so a late signal cannot kill the process.
+ *
+ * backtrace() is not async-signal-safe and may block forever in the stalled
+ * thread. Then the capture is abandoned: the buffer stays owned by the handler
+ * and no new capture starts until the handler releases it.
+ */
+
+static constexpr int CAPTURE_SIGNAL = SIGURG;
+
+enum {
+  CAPTURE_IDLE,
+  CAPTURE_REQUESTED,
+  CAPTURE_RUNNING,
+  CAPTURE_DONE,
+  // the watchdog has stopped waiting for the running handler
+  CAPTURE_ABANDONED
+};
+
+static std::atomic_int s_CaptureState(CAPTURE_IDLE);
+// the thread the capture is requested for, so a late signal to another thread
+// does not answer it
+static std::atomic<uintptr_t> s_CaptureThread(0);
+static void *s_CapturedFrames[GOThreadWatchdog::MAX_FRAMES];
+static int s_NCapturedFrames = 0;
+static struct sigaction s_OldSigAction;
+
+static void capture_signal_handler(int) {
+  const int savedErrno = errno;
+  int expected = CAPTURE_REQUESTED;
+
+  if (
+    s_CaptureThread.load(std::memory_order_relaxed)
+      == get_current_thread_handle()
+    && s_CaptureState.compare_exchange_strong(expected, CAPTURE_RUNNING)) {
+    s_NCapturedFrames
+      = backtrace(s_CapturedFrames, GOThreadWatchdog::MAX_FRAMES);
+    expected = CAPTURE_RUNNING;
+    // if nobody waits for the frames then just release the buffer
+    if (!s_CaptureState.compare_exchange_strong(expected, CAPTURE_DONE))
+      s_CaptureState.store(CAPTURE_IDLE, std::memory_order_release);
+  }
+  errno = savedErrno;
+}
+
+static void install_capture_handler() {
+  struct sigaction action;
+  void *frame;
+
+  // the first call of backtrace() may load libraries, so it must not happen
+  // in the signal handler
+  backtrace(&frame, 1);
+  action.sa_handler = capture_signal_handler;
+  sigemptyset(&action.sa_mask);
+  action.sa_flags = SA_RESTART;
+  sigaction(CAPTURE_SIGNAL, &action, &s_OldSigAction);
+}
+
+static void uninstall_capture_handler() {
+  sigaction(CAPTURE_SIGNAL, &s_OldSigAction, nullptr);
+}
+
+// waits until the handler finishes. Returns false if the deadline expires
+static bool wait_for_capture(int64_t deadline) {
+  while (s_CaptureState.load(std::memory_order_acquire) != CAPTURE_DONE) {
+    if (get_time_ns() >= deadline)
+      return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+/**
+ * Captures the stack of the thread and appends the symbolized frames to lines
+ */
+static void capture_stack(uintptr_t threadHandle, wxArrayString &lines) {
+  const int64_t timeout
+    = std::chrono::nanoseconds(GOThreadWatchdog::CAPTURE_TIMEOUT).count();
+  const int64_t deadline = get_time_ns() + timeout;
+  int expected = CAPTURE_IDLE;
+
+  s_CaptureThread.store(threadHandle);
+  if (!s_CaptureState.compare_exchange_strong(expected, CAPTURE_REQUESTED)) {
+    lines.Add(_("The stack of the thread could not be captured because the "
+                "previous capture has not finished"));
+    return;
+  }
+  if (pthread_kill((pthread_t)threadHandle, CAPTURE_SIGNAL) == 0)
+    wait_for_capture(deadline);
+
+  bool isCaptured = false;
+
+  expected = CAPTURE_REQUESTED;
+  // if the handler has already started then wait a bit more for it
+  if (!s_CaptureState.compare_exchange_strong(expected, CAPTURE_IDLE)) {
+    isCaptured = wait_for_capture(deadline + timeout);
+    expected = CAPTURE_RUNNING;
+    // the handler finishes it later
+    if (!isCaptured)
+      isCaptured
+        = !s_CaptureState.compare_exchange_strong(expected, CAPTURE_ABANDONED);
+  }
+  if (isCaptured) {
+    // skip the frame of the signal handler
+    const int nFrames = s_NCapturedFrames - 1;
+    char **symbols = nFrames > 0
+      ? backtrace_symbols(s_CapturedFrames + 1, nFrames)
+      : nullptr;
+
+    if (symbols) {
+      for (int i = 0; i < nFrames; i++)
+        lines.Add(wxString::Format(wxT("[%02d] %s"), i, symbols[i]));
+      free(symbols);
+    }
+    s_CaptureState.store(CAPTURE_IDLE);
+  } else
+    lines.Add(_("The stack of the thread could not be captured"));
+}
+
+#else
+
+static void install_capture_handler() {}
+static void uninstall_capture_handler() {}
+
+static void capture_stack(uintptr_t threadHandle, wxArrayString &lines) {
+  lines.Add(_("Capturing the stack is not supported on this platform"));
+}
+
+#endif
+
+// the state of a stalled heartbeat copied under the registry mutex
+struct GOThreadStall {
+  const char *m_name;
+  int64_t m_BusyNs;
+  const GOMutex *p_WaitedMutex;
+  const char *m_WaiterInfo;
+  uintptr_t m_ThreadHandle;
+};
+
+static void report_stall(const GOThreadStall &stall) {
+  wxArrayString lines;
+
+  lines.Add(wxString::Format(
+    _("The thread %s has not responded for %lld ms"),
+    stall.m_name,
+    (long long)(stall.m_BusyNs / 1000000)));
+  if (stall.p_WaitedMutex) {
+    const char *lockerInfo = stall.p_WaitedMutex->GetLockerInfo();
+
+    lines.Add(wxString::Format(
+      _("It waits for the mutex %p as %s. The mutex is locked by %s"),
+      (const void *)stall.p_WaitedMutex,
+      stall.m_WaiterInfo ? stall.m_WaiterInfo : "?",
+      lockerInfo ? lockerInfo : "?"));
+  }
+  capture_stack(stall.m_ThreadHandle, lines);
+
+  // the report goes to stderr too because wxLog shows the messages of other
+  // threads only when the main loop is alive, and it may be the stalled one
+  for (const wxString &line : lines) {
+    fprintf(stderr, "%s\n", (const char *)line.utf8_str());
+    wxLogWarning(wxT("%s"), line);
+  }
+}
+
+class GOThreadWatchdogThread : public GOThread {
+private:
+  const int64_t m_DeadlineNs;
+  const std::chrono::milliseconds m_CheckInterval;
+
+  void CheckHeartbeats() {
+    std::vector<GOThreadStall> stalls;
+
+    {
+      // the reporting may take long, so it is done after unlocking for not
+      // blocking the threads creating or destroying their heartbeats
+      std::lock_guard<std::mutex> lock(s_RegistryMutex);
+      const int64_t now = get_time_ns();
+
+      for (GOThreadWatchdog::Heartbeat *p = p_FirstHeartbeat; p; p = p->p_next)
+        CheckHeartbeat(*p, now, stalls);
+    }
+    for (const GOThreadStall &stall : stalls)
+      report_stall(stall);
+  }
+
+  void CheckHeartbeat(
+    GOThreadWatchdog::Heartbeat &heartbeat,
+    int64_t now,
+    std::vector<GOThreadStall> &stalls) {
+    const int64_t busySince
+      = heartbeat.m_BusySince.load(std::memory_order_acquire);
+
+    // report each stall once
+    if (
+      busySince && now - busySince > m_DeadlineNs
+      && busySince != heartbeat.m_ReportedSince) {
+      heartbeat.m_ReportedSince = busySince;
+      stalls.push_back(
+        {heartbeat.m_name,
+         now - busySince,
+         heartbeat.m_WaitedMutex.load(std::memory_order_acquire),
+         heartbeat.m_WaiterInfo.load(std::memory_order_relaxed),
+         heartbeat.m_ThreadHandle.load(std::memory_order_relaxed)});
+    }
+  }
+
+protected:
+  void Entry() override {
+    while (!ShouldStop()) {
+      std::this_thread::sleep_for(m_CheckInterval);
+      CheckHeartbeats();
+    }
+  }
+
+public:
+  GOThreadWatchdogThread(std::chrono::milliseconds deadline)
+    : m_DeadlineNs(std::chrono::nanoseconds(deadline).count()),
+      m_CheckInterval(std::clamp(
+        deadline / 4,
+        std::chrono::milliseconds(10),
+        std::chrono::milliseconds(100))) {}
+
+  ~GOThreadWatchdogThread() { Stop(); }
+};
+
+static std::unique_ptr<GOThreadWatchdogThread> p_WatchdogThread;
+
+void GOThreadWatchdog::start(std::chrono::milliseconds deadline) {
+  stop();
+  {
+    std::lock_guard<std::mutex> lock(s_RegistryMutex);
+
+    // forget the states left from the previous start
+    for (Heartbeat *p = p_FirstHeartbeat; p; p = p->p_next) {
+      p->m_BusySince.store(0);
+      p->m_ReportedSince = 0;
+    }
+  }
+  install_capture_handler();
+  p_WatchdogThread = std::make_unique<GOThreadWatchdogThread>(deadline);
+  p_WatchdogThread->Start();
+  s_IsStarted.store(true);
+}
+
+void GOThreadWatchdog::stop() {
+  if (p_WatchdogThread) {
+    s_IsStarted.store(false);
+    p_WatchdogThread.reset();
+    uninstall_capture_handler();
+  }
+}
+
+bool GOThreadWatchdog::isStarted() { return s_IsStarted.load(); }
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOTHREADWATCHDOG_H
+#define GOTHREADWATCHDOG_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+class GOMutex;
+
+/**
+ * Detects the threads that are stuck for too long and reports them.
+ *
+ * Each watched thread owns a Heartbeat. The thread calls Beat() when it starts
+ * a piece of work that must finish soon and Idle() when it is going to wait
+ * legally for an unbounded time. When a heartbeat stays busy longer than the
+ * deadline, the watchdog thread writes a report with the name of the stalled
+ * thread, the mutex it is waiting for with the current owner of the mutex, and
+ * the stack of the stalled thread where the platform allows capturing it.
+ *
+ * Beat() and Idle() never block and never allocate, so they may be called on
+ * the audio threads. All the reporting happens on the watchdog thread.
+ *
+ * The watchdog is opt-in: until start() is called Beat() does nothing.
+ */
+class GOThreadWatchdog {
+public:
+  // the maximal number of the stack frames captured
+  static constexpr unsigned MAX_FRAMES = 64;
+  // how long to wait for the stalled thread to capture its stack
+  static constexpr std::chrono::milliseconds CAPTURE_TIMEOUT{200};
+
+  class Heartbeat {
+  private:
+    friend class GOThreadWatchdog;
+    friend class GOThreadWatchdogThread;
+
+    // must point to a static string
+    const char *m_name;
+    // steady clock time in ns of the last Beat(). 0 if the thread is idle
+    std::atomic<int64_t> m_BusySince;
+    // the native handle of the thread called the last Beat()
+    std::atomic<uintptr_t> m_ThreadHandle;
+    // the mutex the thread is waiting for or nullptr
+    std::atomic<const GOMutex *> m_WaitedMutex;
+    std::atomic<const char *> m_WaiterInfo;
+
+    // the registry list. Guarded by the registry mutex
+    Heartbeat *p_prev;
+    Heartbeat *p_next;
+    // m_BusySince of the last report. Accessed by the watchdog thread only
+    int64_t m_ReportedSince;
+
+    Heartbeat(const Heartbeat &) = delete;
+    const Heartbeat &operator=(const Heartbeat &) = delete;
+
+  public:
+    // registers the heartbeat. The name must point to a static string
+    Heartbeat(const char *name);
+    // unregisters the heartbeat
+    ~Heartbeat();
+
+    const char *GetName() const { return m_name; }
+
+    /**
+     * Marks the calling thread busy since now. The next Beat() or Idle() must
+     * happen before the deadline expires
+     */
+    void Beat();
+
+    // Marks the calling thread idle so it is not watched until the next Beat()
+    void Idle();
+  };
+
+  /**
+   * Marks the current thread waiting for a mutex while it exists, so a report
+   * about the current thread can tell what it waits for. Does nothing if the
+   * current thread is not busy with a heartbeat
+   */
+  class MutexWait {
+  private:
+    Heartbeat *p_heartbeat;
+
+  public:
+    MutexWait(const GOMutex *pMutex, const char *waiterInfo);
+    ~MutexWait();
+  };
+
+  /**
+   * Starts the watchdog thread
+   * @param deadline how long a heartbeat may stay busy before it is reported
+   */
+  static void start(std::chrono::milliseconds deadline);
+
+  // Stops the watchdog thread
+  static void stop();
+
+  static bool isStarted();
+};
+
+#endif /* GOTHREADWATCHDOG_H */
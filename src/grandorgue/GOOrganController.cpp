@@ -8,6 +8,9 @@
 #include "GOOrganController.h"
 
 #include <algorithm>
+#include <chrono>
+#include <string>
+#include <unordered_map>
 
 #include <wx/filename.h>
 #include <wx/log.h>
@@ -59,6 +62,7 @@
 #include "model/GOSwitch.h"
 #include "model/GOTremulant.h"
 #include "sound/GOSoundOrganEngine.h"
+#include "sound/playing/GOSoundAudioSection.h"
 #include "sound/playing/GOSoundReleaseAlignTable.h"
 #include "temperaments/GOTemperament.h"
 #include "yaml/GOYamlModel.h"
@@ -71,6 +75,7 @@
 #include "GOHash.h"
 #include "GOMetronome.h"
 #include "GOOrgan.h"
+#include "GOSampleStatistic.h"
 #include "GOTimer.h"
 #include "go_path.h"
 
@@ -107,7 +112,8 @@ GOOrganController::GOOrganController(GOConfig &config, bool isAppInitialized)
   }
   GOOrganModel::SetModelModificationListener(this);
   m_setter = new GOSetter(this);
-  m_pool.SetMemoryLimit(m_config.MemoryLimit() * 1024 * 1024);
+  mp_pool = std::make_shared<GOMemoryPool>();
+  mp_pool->SetMemoryLimit(m_config.MemoryLimit() * 1024 * 1024);
 }
 
 GOOrganController::~GOOrganController() {
@@ -162,19 +168,48 @@ void GOOrganController::ResetOrganModified() {
   SetOrganModified(false);
 }
 
+static std::string get_object_hash(const GOCacheObject &obj) {
+  GOHash hash;
+
+  obj.UpdateHash(hash);
+
+  const GOHashType &hashValue = hash.getHash();
+
+  return std::string((const char *)hashValue.hash, sizeof(hashValue.hash));
+}
+
+unsigned GOOrganController::TakeLoadedData(
+  GOOrganController &donor, std::vector<GOCacheObject *> &notTaken) {
+  std::unordered_multimap<std::string, GOCacheObject *> donorObjects;
+  unsigned nTaken = 0;
+
+  for (GOCacheObject *pObj : donor.GetCacheObjects())
+    if (pObj->IsReady())
+      donorObjects.emplace(get_object_hash(*pObj), pObj);
+  for (GOCacheObject *pObj : GetCacheObjects()) {
+    auto it = donorObjects.find(get_object_hash(*pObj));
+
+    if (it != donorObjects.end() && pObj->TakeDataFrom(*it->second)) {
+      donorObjects.erase(it);
+      nTaken++;
+    } else
+      notTaken.push_back(pObj);
+  }
+  return nTaken;
+}
+
 GOHashType GOOrganController::GenerateCacheHash() {
   GOHash hash;
 
   UpdateHash(hash);
-  hash.Update(sizeof(GOSoundAudioSection));
-  hash.Update(sizeof(GOSoundingPipe));
-  hash.Update(sizeof(GOSoundReleaseAlignTable));
+  // The cache format is versioned separately, so only the parameters changing
+  // the content of the sections are hashed, not the layout of the structures
   hash.Update(BLOCK_HISTORY);
   hash.Update(GOSoundAudioSection::getMaxReadAhead());
   hash.Update(SHORT_LOOP_LENGTH);
-  GOSoundProvider::UpdateCacheHash(hash);
-  hash.Update(sizeof(GOSoundAudioSection::StartSegment));
-  hash.Update(sizeof(GOSoundAudioSection::EndSegment));
+  // the release align table is stored without its dimensions
+  hash.Update(PHASE_ALIGN_DERIVATIVES);
+  hash.Update(PHASE_ALIGN_AMPLITUDES);
   return hash.getHash();
 }
 
@@ -334,7 +369,8 @@ wxString GOOrganController::Load(
   const GOOrgan &organ,
   const wxString &file2,
   bool isGuiOnly,
-  GOProgressMonitor &monitor) {
+  GOProgressMonitor &monitor,
+  GOOrganController *pDonor) {
   GOBuffer<char> dummy;
   wxString errMsg;
 
@@ -467,93 +503,89 @@ wxString GOOrganController::Load(
 
     if (!isGuiOnly) {
       try {
-        bool cache_ok = false;
+        bool isCacheToBeKept = false;
+        std::vector<GOCacheObject *> notTakenObjects;
 
         dummy.resize(1024 * 1024 * 50);
         ResolveReferences();
 
-        /* Figure out list of pipes to load */
-        GOCacheObjectDistributor objectDistributor(GetCacheObjects());
-
-        monitor.Reset(objectDistributor.GetNObjects());
-
-        GOCacheObject *obj = nullptr;
+        if (pDonor) {
+          monitor.Setup(
+            1, _("Loading sample set"), _("Reusing the loaded samples"));
+          // the taken samples are allocated from the donor pool
+          mp_pool = pDonor->mp_pool;
 
-        /* Load pipes */
-        if (wxFileExists(m_CacheFilename)) {
-          wxFile cache_file(m_CacheFilename);
-          GOCache reader(cache_file, m_pool);
-          cache_ok = cache_file.IsOpened();
+          const unsigned nTaken = TakeLoadedData(*pDonor, notTakenObjects);
 
-          if (cache_ok) {
-            GOHashType hash1, hash2;
-            if (!reader.ReadHeader()) {
-              cache_ok = false;
-              wxLogWarning(_("Cache file had bad magic bypassing cache."));
-            }
-            hash1 = GenerateCacheHash();
-            if (
-              !reader.Read(&hash2, sizeof(hash2))
-              || memcmp(&hash1, &hash2, sizeof(hash1))) {
-              cache_ok = false;
-              reader.FreeCacheFile();
-              wxLogWarning(_("Cache file had diffent hash bypassing cache."));
-            }
-          }
+          wxLogInfo(
+            _("%u of %u objects have been reused from the previous load"),
+            nTaken,
+            (unsigned)GetCacheObjects().size());
 
-          GOCacheObject *obj = nullptr;
+          const GOHashType donorHash = pDonor->GenerateCacheHash();
+          const GOHashType hash = GenerateCacheHash();
 
-          if (cache_ok) {
-            while ((obj = objectDistributor.FetchNext())) {
-              if (!obj->LoadFromCacheWithoutExc(m_pool, reader)) {
-                wxLogWarning(_("Cache load failure: %s"), obj->GetLoadError());
-                break;
-              }
-              if (!monitor.Update(
-                    objectDistributor.GetPos(), obj->GetLoadTitle()))
-                throw GOLoadAborted(); // Skip the rest of the loading code
-            }
-            if (!obj)
-              m_Cacheable = true;
-            else
-              // obj points to an object with a load error. We will try to load
-              // it from the file later
-              cache_ok = false;
-          }
+          // The cache is kept if it is still valid or if the old cache file is
+          // mapped to the shared pool, so it must not be overwritten
+          isCacheToBeKept = !memcmp(&donorHash, &hash, sizeof(hash))
+            || mp_pool->GetMappedSize() > 0;
+        }
 
-          if (!cache_ok && !m_config.ManageCache())
-            wxLogWarning(
-              _("The cache for this organ is outdated. Please update "
-                "or delete it."));
+        /* Figure out list of pipes to load */
+        GOCacheObjectDistributor objectDistributor(
+          pDonor ? notTakenObjects : GetCacheObjects());
+        // the objects that could not be read from the cache
+        std::vector<GOCacheObject *> fileObjects;
+        // whether the cache file is to be rewritten after loading
+        bool isCacheToBeUpdated = !isCacheToBeKept;
 
-          reader.Close();
-        }
+        monitor.Reset(objectDistributor.GetNObjects());
 
-        if (!cache_ok) {
-          GOLoadWorker thisWorker(m_FileStore, m_pool, objectDistributor);
+        /* Load pipes. The cache cannot be mapped to the shared pool of the
+         * donor, so the objects not taken from it are loaded from files */
+        if (!pDonor) {
+          // An intact cache is rewritten only if it gets more objects
+          isCacheToBeUpdated = !LoadCacheFile(
+            m_CacheFilename, objectDistributor, fileObjects, monitor);
+        } else
+          while (GOCacheObject *obj = objectDistributor.FetchNext())
+            fileObjects.push_back(obj);
+
+        if (!fileObjects.empty()) {
+          GOCacheObjectDistributor fileDistributor(fileObjects);
+          // the objects already processed are shown as done in the progress
+          const unsigned nCached
+            = objectDistributor.GetNObjects() - fileObjects.size();
+          GOLoadWorker thisWorker(m_FileStore, *mp_pool, fileDistributor);
           ptr_vector<GOLoadThread> threads;
+          GOCacheObject *obj = nullptr;
 
           // Create and run additional worker threads
           for (unsigned i = 0; i < m_config.LoadConcurrency(); i++)
             threads.push_back(
-              new GOLoadThread(m_FileStore, m_pool, objectDistributor));
+              new GOLoadThread(m_FileStore, *mp_pool, fileDistributor));
           for (unsigned i = 0; i < threads.size(); i++)
             threads[i]->Run();
 
-          // try to load the object that we could not load from cache
-          if (obj)
-            thisWorker.LoadObjectNoExc(obj);
-
           while (thisWorker.LoadNextObject(obj))
             // show the progress and process possible Cancel
             if (!monitor.Update(
-                  objectDistributor.GetPos(), obj->GetLoadTitle()))
+                  nCached + fileDistributor.GetPos(), obj->GetLoadTitle()))
               throw GOLoadAborted(); // skip the rest of loading code
-          // rethrow exception if any occurred in thisWorker.LoadNextObject
-          bool wereExceptions = thisWorker.WereExceptions();
 
-          for (unsigned i = 0; i < threads.size(); i++)
-            wereExceptions |= threads[i]->CheckExceptions();
+          bool wereExceptions;
+
+          try {
+            // rethrow exception if any occurred in thisWorker.LoadNextObject
+            wereExceptions = thisWorker.WereExceptions();
+            for (unsigned i = 0; i < threads.size(); i++)
+              wereExceptions |= threads[i]->CheckExceptions();
+          } catch (const GOOutOfMemory &) {
+            // stop the other workers and keep the objects loaded so far
+            threads.clear();
+            UpdatePartialCache(isCacheToBeUpdated, fileObjects, monitor);
+            throw;
+          }
           if (wereExceptions) {
             for (auto obj : GetCacheObjects()) {
               if (!obj->IsReady())
@@ -564,16 +596,18 @@ wxString GOOrganController::Load(
               _("Load error"),
               wxOK | wxICON_ERROR,
               NULL);
-          } else {
-            if (objectDistributor.IsComplete())
-              m_Cacheable = true;
-            if (m_config.ManageCache() && m_Cacheable)
-              UpdateCache(m_config.CompressCache(), monitor);
           }
 
+          if (GetUnreachableSamples())
+            wxLogInfo(
+              _("%u sample files are not loaded because they are never played "
+                "on this organ"),
+              GetUnreachableSamples());
+
           // Despite a possible exception automatic calling ~GOLoadThread from
           // ~ptr_vector stops all additional worker threads
         }
+        UpdatePartialCache(isCacheToBeUpdated, fileObjects, monitor);
       } catch (const GOOutOfMemory &e) {
         GOMessageBox(
           _("Out of memory - only parts of the organ are loaded. Please "
@@ -588,6 +622,9 @@ wxString GOOrganController::Load(
           wxOK | wxICON_ERROR,
           NULL);
       }
+      // the sample descriptions are needed only for loading
+      for (GOCacheObject *pObj : GetCacheObjects())
+        pObj->FinishLoading();
     }
   } catch (const wxString &error_) {
     errMsg = error_;
@@ -619,6 +656,50 @@ wxString GOOrganController::ExportCombination(const wxString &fileName) {
   return errMsg;
 }
 
+static wxString csv_quote(const wxString &value) {
+  wxString quoted = value;
+
+  quoted.Replace(wxT("\""), wxT("\"\""));
+  return wxT("\"") + quoted + wxT("\"");
+}
+
+static void write_statistic(
+  wxTextOutputStream &out, const GOPipeConfigNode &node, unsigned level) {
+  const GOSampleStatistic stat = node.GetStatistic();
+
+  if (stat.IsValid())
+    out << wxString::Format(
+      wxT("%u,%s,%llu,%llu,%llu,%llu,%llu\n"),
+      level,
+      csv_quote(node.GetName()),
+      (unsigned long long)stat.GetMemorySize(),
+      (unsigned long long)stat.GetEndSegmentSize(),
+      (unsigned long long)stat.GetTruncatedSize(),
+      (unsigned long long)stat.GetRenderNs(),
+      (unsigned long long)stat.GetNRenderedPeriods());
+  for (unsigned i = 0; i < node.GetChildCount(); i++)
+    write_statistic(out, *node.GetChild(i), level + 1);
+}
+
+wxString GOOrganController::ExportStatistic(const wxString &fileName) {
+  wxString errMsg;
+  wxFileOutputStream fOS(fileName);
+
+  if (fOS.IsOk()) {
+    wxTextOutputStream out(fOS);
+
+    out << wxT("level,name,memory_bytes,end_segment_bytes,truncated_bytes,")
+           wxT("render_ns,voice_periods\n");
+    write_statistic(out, GetRootPipeConfigNode(), 0);
+    out.Flush();
+    if (!fOS.Close())
+      errMsg.Printf(
+        wxT("Unable to write all the data to the file '%s'"), fileName);
+  } else
+    errMsg.Printf(wxT("Unable to open the file '%s' for writing"), fileName);
+  return errMsg;
+}
+
 void GOOrganController::LoadCombination(const wxString &file) {
   wxString errMsg;
   const wxFileName fileName(file);
@@ -680,7 +761,108 @@ void GOOrganController::LoadCombination(const wxString &file) {
   }
 }
 
+bool GOOrganController::LoadCacheFile(
+  const wxString &cacheFileName,
+  GOCacheObjectDistributor &objectDistributor,
+  std::vector<GOCacheObject *> &fileObjects,
+  GOProgressMonitor &monitor) {
+  bool cache_ok = false;
+
+  if (wxFileExists(cacheFileName)) {
+    wxFile cache_file(cacheFileName);
+    GOCache reader(cache_file, *mp_pool);
+    cache_ok = cache_file.IsOpened();
+
+    if (cache_ok && !reader.ReadHeader()) {
+      cache_ok = false;
+      wxLogWarning(_("Cache file had bad magic bypassing cache."));
+    }
+    if (cache_ok) {
+      GOHashType hash1, hash2;
+
+      hash1 = GenerateCacheHash();
+      if (
+        !reader.Read(&hash2, sizeof(hash2))
+        || memcmp(&hash1, &hash2, sizeof(hash1))) {
+        cache_ok = false;
+        reader.FreeCacheFile();
+        wxLogWarning(_("Cache file had diffent hash bypassing cache."));
+      }
+    }
+
+    if (cache_ok) {
+      const auto startTime = std::chrono::steady_clock::now();
+      GOCacheObject *obj;
+
+      while ((obj = objectDistributor.FetchNext())) {
+        uint8_t isCached = 0;
+
+        if (!reader.Read(&isCached, sizeof(isCached))) {
+          wxLogWarning(_("Cache load failure: the file is truncated"));
+          fileObjects.push_back(obj);
+          break;
+        }
+        // the object had not been loaded when the cache was written
+        if (!isCached)
+          fileObjects.push_back(obj);
+        else if (!obj->LoadFromCacheWithoutExc(*mp_pool, reader)) {
+          wxLogWarning(_("Cache load failure: %s"), obj->GetLoadError());
+          // the position of the next object is unknown, so the rest is loaded
+          // from the files
+          fileObjects.push_back(obj);
+          break;
+        }
+        if (!monitor.Update(objectDistributor.GetPos(), obj->GetLoadTitle()))
+          throw GOLoadAborted(); // Skip the rest of the loading code
+      }
+      if (obj)
+        cache_ok = false;
+      m_Cacheable = true;
+      wxLogInfo(
+        reader.IsCompressed()
+          ? _("The compressed cache of %.1f MB has been read in %.1f s")
+          : _("The cache of %.1f MB has been read in %.1f s"),
+        cache_file.Length() / 1048576.0,
+        std::chrono::duration<double>(
+          std::chrono::steady_clock::now() - startTime)
+          .count());
+    }
+
+    if (!cache_ok && !m_config.ManageCache())
+      wxLogWarning(
+        _("The cache for this organ is outdated. Please update "
+          "or delete it."));
+
+    reader.Close();
+  }
+
+  // the objects not read from the cache are loaded from the files
+  while (GOCacheObject *obj = objectDistributor.FetchNext())
+    fileObjects.push_back(obj);
+  if (cache_ok && !fileObjects.empty())
+    wxLogInfo(
+      _("%u objects are not in the cache and are loaded from the files"),
+      (unsigned)fileObjects.size());
+  return cache_ok;
+}
+
+void GOOrganController::UpdatePartialCache(
+  bool isCacheToBeUpdated,
+  const std::vector<GOCacheObject *> &fileObjects,
+  GOProgressMonitor &monitor) {
+  m_Cacheable = true;
+  if (
+    m_config.ManageCache() && isCacheToBeUpdated
+    && (fileObjects.empty()
+        || std::any_of(
+          fileObjects.begin(),
+          fileObjects.end(),
+          [](const GOCacheObject *pObj) { return pObj->IsReady(); })))
+    UpdateCache(m_config.CompressCache(), monitor);
+}
+
 bool GOOrganController::UpdateCache(bool compress, GOProgressMonitor &monitor) {
+  const auto startTime = std::chrono::steady_clock::now();
   bool isOk = false;
 
   DeleteCache();
@@ -707,7 +889,13 @@ bool GOOrganController::UpdateCache(bool compress, GOProgressMonitor &monitor) {
 
       if (!obj)
         break;
-      if (!obj->SaveCache(writer)) {
+
+      // the objects not loaded are marked, so they are loaded from the files
+      const uint8_t isCached = obj->IsReady();
+
+      if (
+        !writer.Write(&isCached, sizeof(isCached))
+        || (isCached && !obj->SaveCache(writer))) {
         isOk = false;
         wxLogError(
           _("Save of %s to the cache failed"), obj->GetLoadTitle().c_str());
@@ -718,9 +906,21 @@ bool GOOrganController::UpdateCache(bool compress, GOProgressMonitor &monitor) {
         isOk = false;
       }
     }
-    writer.Close();
+    if (!writer.Close())
+      isOk = false;
     if (!isOk)
       DeleteCache();
+    else if (compress)
+      // show the trade-off between the size and the time
+      wxLogInfo(
+        _("The cache has been written in %.1f s: %.1f MB of data are "
+          "compressed to %.1f MB (%.0f%%)"),
+        std::chrono::duration<double>(
+          std::chrono::steady_clock::now() - startTime)
+          .count(),
+        writer.GetRawSize() / 1048576.0,
+        writer.GetStoredSize() / 1048576.0,
+        writer.GetStoredSize() * 100.0 / writer.GetRawSize());
   } else
     wxLogError(_("Opening the cache file %s failed"), m_CacheFilename);
   return isOk;
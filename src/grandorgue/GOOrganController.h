@@ -8,6 +8,7 @@
 #ifndef GOORGANCONTROLLER_H
 #define GOORGANCONTROLLER_H
 
+#include <memory>
 #include <vector>
 
 #include <wx/filefn.h>
@@ -20,6 +21,7 @@
 #include "control/GOLabelControl.h"
 #include "gui/frames/GOMainWindowData.h"
 #include "gui/panels/GOGUIMouseState.h"
+#include "loader/GOCacheObjectDistributor.h"
 #include "loader/GOFileStore.h"
 #include "loader/GOProgressMonitor.h"
 #include "model/GOOrganModel.h"
@@ -103,7 +105,8 @@ private:
   int m_SampleSetId1, m_SampleSetId2;
   GOGUIMouseState m_MouseState;
 
-  GOMemoryPool m_pool;
+  // shared with the next instance when reloading with the samples reused
+  std::shared_ptr<GOMemoryPool> mp_pool;
   GOGuiImageCache *mp_ImageCache;
   GOLabelControl m_PitchLabel;
   GOLabelControl m_TemperamentLabel;
@@ -117,6 +120,24 @@ private:
 
   void ReadOrganFile(GOConfigReader &cfg);
   GOHashType GenerateCacheHash();
+  /**
+   * Takes the loaded data of the donor objects having the same hash
+   * @param donor a previous instance of the same organ sharing the memory pool
+   * @param notTaken the objects that have not got their data
+   * @return the number of objects that have got their data
+   */
+  unsigned TakeLoadedData(
+    GOOrganController &donor, std::vector<GOCacheObject *> &notTaken);
+  /**
+   * Called after loading the objects that could not be read from the cache.
+   * Writes the cache if it is to be updated unless all these objects have
+   * failed. The failed objects are marked as missing in the cache, so the
+   * next load reads the others from the cache and retries only the failed ones
+   */
+  void UpdatePartialCache(
+    bool isCacheToBeUpdated,
+    const std::vector<GOCacheObject *> &fileObjects,
+    GOProgressMonitor &monitor);
   wxString GenerateSettingFileName();
   wxString GenerateCacheFileName();
   void SetTemperament(const GOTemperament &temperament);
@@ -149,24 +170,60 @@ public:
     m_FileStore.SetDirectory(dir);
   }
 
+  /**
+   * Loads the organ
+   * @param organ the organ to load
+   * @param cmb the settings file to import or an empty string
+   * @param isGuiOnly whether not to load the samples
+   * @param monitor the progress monitor
+   * @param pDonor if not nullptr then a previous instance of the same organ.
+   *   The samples of the pipes with unchanged sample-affecting attributes are
+   *   taken from it instead of loading. Only other pipes are loaded, without
+   *   the cache
+   * @return an empty string if succeeded otherwise the error message
+   */
   wxString Load(
     const GOOrgan &organ,
     const wxString &cmb,
     bool isGuiOnly,
-    GOProgressMonitor &monitor);
+    GOProgressMonitor &monitor,
+    GOOrganController *pDonor = nullptr);
   /**
    * Exports organ combinations in the yaml file
    * @param fileName - the path to the yaml file to export
    * @return an empty string if succeeded otherwise the error message
    */
   wxString ExportCombination(const wxString &fileName);
+  /**
+   * Exports the memory and the render time of each node of the pipe
+   * configuration tree in the csv file
+   * @param fileName - the path to the csv file to export
+   * @return an empty string if succeeded otherwise the error message
+   */
+  wxString ExportStatistic(const wxString &fileName);
   void LoadCombination(const wxString &cmb);
   bool Save();
   bool Export(const wxString &cmb);
   bool CachePresent() const { return wxFileExists(m_CacheFilename); }
   bool IsCacheable() const { return m_Cacheable; }
   bool UpdateCache(bool compress, GOProgressMonitor &monitor);
+  /**
+   * Reads the objects of the distributor from the cache file. The objects not
+   * read from it are appended to fileObjects for loading from the sample files.
+   * If the cache file is absent, outdated or damaged then all the objects are
+   * appended
+   * @return whether the cache file is valid and all its objects have been read
+   */
+  bool LoadCacheFile(
+    const wxString &cacheFileName,
+    GOCacheObjectDistributor &objectDistributor,
+    std::vector<GOCacheObject *> &fileObjects,
+    GOProgressMonitor &monitor);
   void DeleteCache();
+  // Checks the crc of the organ package content. Returns the number of errors
+  unsigned VerifyPackages(GOProgressMonitor &monitor) {
+    return m_FileStore.VerifyArchives(monitor);
+  }
   void DeleteSettings();
   void Abort();
   void PreparePlayback(
@@ -183,7 +240,7 @@ public:
   GOGUIPanel *GetPanel(unsigned index) { return m_panels[index]; }
   unsigned GetPanelCount() const { return m_panels.size(); }
   void AddPanel(GOGUIPanel *panel) { m_panels.push_back(panel); }
-  GOMemoryPool &GetMemoryPool() { return m_pool; }
+  GOMemoryPool &GetMemoryPool() { return *mp_pool; }
   GOConfig &GetSettings() { return m_config; }
   GOGuiImageCache &GetImageCache() const { return *mp_ImageCache; }
   void SetTemperament(const wxString &name);
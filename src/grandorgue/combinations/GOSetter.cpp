@@ -31,6 +31,7 @@
 
 #include "GOEvent.h"
 #include "GOOrganController.h"
+#include "GOTimer.h"
 #include "go_ids.h"
 
 #define FRAME_GENERALS 1000
@@ -741,7 +742,6 @@ GOSetter::GOSetter(GOOrganController *organController)
     m_bank(0),
     m_crescendopos(0),
     m_crescendobank(0),
-    m_framegeneral(0),
     m_general(0),
     m_crescendo(0),
     m_CurrFileDisplay(*organController, &MIDI_CONTEXT_SEQUENCER),
@@ -763,7 +763,10 @@ GOSetter::GOSetter(GOOrganController *organController)
   m_OrganController->RegisterControlChangedHandler(this);
 }
 
-GOSetter::~GOSetter() {}
+GOSetter::~GOSetter() {
+  FlushPitch();
+  ClearFrameGenerals();
+}
 
 static const wxString WX_OVERRIDE_MODE = wxT("OverrideMode");
 static const wxString WX_EMPTY_STRING = wxEmptyString;
@@ -779,17 +782,54 @@ wxString GOSetter::GetCrescendoCmbStateName(uint8_t crescendoIdx) const {
     m_CrescendoOverrideMode[crescendoIdx], crescendoIdx);
 }
 
+static const wxString WX_FRAME_GENERAL_03D = wxT("FrameGeneral%03d");
+static const wxString WX_PROTECTED = wxT("Protected");
+
+static wxString frame_general_group(unsigned idx) {
+  return wxString::Format(WX_FRAME_GENERAL_03D, idx + 1);
+}
+
+GOGeneralCombination *GOSetter::FindFrameGeneral(unsigned idx) const {
+  auto it = m_FrameGenerals.find(idx);
+
+  return it != m_FrameGenerals.end() ? it->second : nullptr;
+}
+
+GOGeneralCombination &GOSetter::GetFrameGeneral(unsigned idx) {
+  GOGeneralCombination *&pCmb = m_FrameGenerals[idx];
+
+  if (!pCmb) {
+    pCmb = new GOGeneralCombination(*m_OrganController, true);
+    pCmb->SetGroup(frame_general_group(idx));
+  }
+  return *pCmb;
+}
+
+void GOSetter::ClearFrameGenerals() {
+  for (auto &frameEntry : m_FrameGenerals)
+    delete frameEntry.second;
+  m_FrameGenerals.clear();
+}
+
 void GOSetter::Load(GOConfigReader &cfg) {
   m_OrganController->RegisterSaveableObject(this);
 
   wxString buffer;
 
-  m_framegeneral.resize(0);
+  // The sequencer frames are not materialized until they are used. Only the
+  // protected ones are created here because their protection comes from the
+  // ODF
+  ClearFrameGenerals();
   for (unsigned i = 0; i < FRAME_GENERALS; i++) {
-    m_framegeneral.push_back(
-      new GOGeneralCombination(*m_OrganController, true));
-    buffer.Printf(wxT("FrameGeneral%03d"), i + 1);
-    m_framegeneral[i]->Load(cfg, buffer);
+    const wxString group = frame_general_group(i);
+
+    if (cfg.ReadBoolean(ODFSetting, group, WX_PROTECTED, false, false)) {
+      GOGeneralCombination *pCmb
+        = new GOGeneralCombination(*m_OrganController, true);
+
+      pCmb->Init(cfg, group);
+      m_FrameGenerals[i] = pCmb;
+    }
   }
 
   m_general.resize(0);
@@ -994,9 +1034,34 @@ void GOSetter::Save(GOConfigWriter &cfg) {
       WX_OVERRIDE_MODE,
       m_CrescendoOverrideMode[i]);
   }
+  // only the materialized sequencer frames are saved. The absent ones are
+  // empty
+  for (auto &frameEntry : m_FrameGenerals)
+    frameEntry.second->Save(cfg);
   // another objects are saveble themself so they are saved separatelly
 }
 
+void GOSetter::LoadCombination(GOConfigReader &cfg) {
+  for (unsigned i = 0; i < FRAME_GENERALS; i++) {
+    const wxString group = frame_general_group(i);
+    const bool isOnOdf = GOCombination::isCmbOnFile(cfg, ODFSetting, group);
+
+    if (
+      isOnOdf || FindFrameGeneral(i)
+      || GOCombination::isCmbOnFile(cfg, CMBSetting, group)) {
+      GOGeneralCombination &cmb = GetFrameGeneral(i);
+
+      cmb.LoadCombination(cfg);
+      // Old presets contain all frames. Keep an empty frame only if it is
+      // protected or if it overrides an odf one
+      if (cmb.IsEmpty() && !cmb.IsProtected() && !isOnOdf) {
+        delete &cmb;
+        m_FrameGenerals.erase(i);
+      }
+    }
+  }
+}
+
 const wxString WX_C = wxT("%c");
 const wxString WX_C02U = wxT("%c%02u");
 const wxString WX_U = wxT("%u");
@@ -1061,9 +1126,11 @@ void GOSetter::ToYaml(YAML::Node &yamlNode) const {
   // save sequencer
   YAML::Node sequencerNode;
 
-  for (unsigned i = 0; i < FRAME_GENERALS; i++)
+  for (const auto &frameEntry : m_FrameGenerals)
     GOCombination::putToYamlMap(
-      sequencerNode, wxString::Format(WX_03U, i), m_framegeneral[i]);
+      sequencerNode,
+      sequencer_cmb_yaml_key(frameEntry.first),
+      frameEntry.second);
   put_to_map_if_not_null(yamlNode, SEQUENCER, sequencerNode);
 }
 
@@ -1102,20 +1169,40 @@ void GOSetter::FromYaml(const YAML::Node &yamlNode) {
 
   // restore sequencer
   const YAML::Node sequencerNode = yamlNode[SEQUENCER];
-
-  for (unsigned i = 0; i < FRAME_GENERALS; i++)
-    get_from_map_or_null(sequencerNode, sequencer_cmb_yaml_key(i))
-      >> *m_framegeneral[i];
+  const YAML::Node nullNode;
+
+  // clear all materialized frames first for the frames absent in yaml would
+  // become empty
+  for (auto &frameEntry : m_FrameGenerals)
+    nullNode >> *frameEntry.second;
+  // then walk only the frames that are present in yaml
+  if (sequencerNode.IsDefined() && sequencerNode.IsMap())
+    for (const auto &frameEntry : sequencerNode) {
+      const wxString key = frameEntry.first.as<wxString>();
+      long idx;
+
+      if (key.ToLong(&idx) && idx >= 0 && idx < FRAME_GENERALS)
+        frameEntry.second >> GetFrameGeneral((unsigned)idx);
+    }
 }
 
 bool GOSetter::CopyFrameGenerals(
   unsigned fromIdx, unsigned toIdx, bool changedBefore) {
-  const GOGeneralCombination *pNewCmb = m_framegeneral[fromIdx];
-  GOGeneralCombination *pOldCmb = m_framegeneral[toIdx];
-  bool changed = (changedBefore || !pOldCmb->IsEmpty() || !pNewCmb->IsEmpty());
-
-  pOldCmb->Copy(pNewCmb);
-  return changed;
+  const GOGeneralCombination *pNewCmb = FindFrameGeneral(fromIdx);
+  GOGeneralCombination *pOldCmb = FindFrameGeneral(toIdx);
+  bool isNewEmpty = !pNewCmb || pNewCmb->IsEmpty();
+  bool isOldEmpty = !pOldCmb || pOldCmb->IsEmpty();
+
+  // do not materialize the destination only for copying an empty frame to it
+  if (!pOldCmb && !isNewEmpty)
+    pOldCmb = &GetFrameGeneral(toIdx);
+  if (pOldCmb) {
+    if (pNewCmb)
+      pOldCmb->Copy(pNewCmb);
+    else
+      pOldCmb->Clear();
+  }
+  return changedBefore || !isOldEmpty || !isNewEmpty;
 }
 
 // Display entered number on m_PosDisplay in the N__ format
@@ -1139,6 +1226,25 @@ void GOSetter::DisplayPos() {
   m_PosDisplay.SetContent(wxString::Format(wxT("%03d"), m_pos));
 }
 
+void GOSetter::ModifyPitch(float cents) {
+  GOPipeConfigNode &rootNode = m_OrganController->GetRootPipeConfigNode();
+
+  if (!mp_PitchBatch) {
+    mp_PitchBatch = std::make_unique<GOPipeConfigNode::UpdateBatch>(rootNode);
+    m_OrganController->GetTimer()->SetRelativeTimer(
+      PITCH_UPDATE_INTERVAL, this);
+  }
+  rootNode.ModifyManualTuning(cents);
+  rootNode.ModifyAutoTuningCorrection(cents);
+}
+
+void GOSetter::FlushPitch() {
+  if (mp_PitchBatch) {
+    m_OrganController->GetTimer()->DeleteTimer(this);
+    mp_PitchBatch.reset();
+  }
+}
+
 void GOSetter::ButtonStateChanged(int id, bool newState) {
   switch (id) {
 
@@ -1216,7 +1322,7 @@ void GOSetter::ButtonStateChanged(int id, bool newState) {
   case ID_SETTER_DELETE: {
     bool changed = false;
 
-    for (unsigned j = m_pos; j < m_framegeneral.size() - 1; j++)
+    for (unsigned j = m_pos; j < FRAME_GENERALS - 1; j++)
       changed = CopyFrameGenerals(j + 1, j, changed);
     UpdateAllButtonsLight(nullptr, -1);
     NotifyCmbPushed(changed, true);
@@ -1225,7 +1331,7 @@ void GOSetter::ButtonStateChanged(int id, bool newState) {
   case ID_SETTER_INSERT: {
     bool changed = false;
 
-    for (unsigned j = m_framegeneral.size() - 1; j > m_pos; j--)
+    for (unsigned j = FRAME_GENERALS - 1; j > m_pos; j--)
       changed = CopyFrameGenerals(j - 1, j, changed);
     UpdateAllButtonsLight(nullptr, -1);
     SetPosition(m_pos);
@@ -1372,28 +1478,22 @@ void GOSetter::ButtonStateChanged(int id, bool newState) {
     break;
   }
   case ID_SETTER_PITCH_M1:
-    m_OrganController->GetRootPipeConfigNode().ModifyManualTuning(-1);
-    m_OrganController->GetRootPipeConfigNode().ModifyAutoTuningCorrection(-1);
+    ModifyPitch(-1);
     break;
   case ID_SETTER_PITCH_M10:
-    m_OrganController->GetRootPipeConfigNode().ModifyManualTuning(-10);
-    m_OrganController->GetRootPipeConfigNode().ModifyAutoTuningCorrection(-10);
+    ModifyPitch(-10);
     break;
   case ID_SETTER_PITCH_M100:
-    m_OrganController->GetRootPipeConfigNode().ModifyManualTuning(-100);
-    m_OrganController->GetRootPipeConfigNode().ModifyAutoTuningCorrection(-100);
+    ModifyPitch(-100);
     break;
   case ID_SETTER_PITCH_P1:
-    m_OrganController->GetRootPipeConfigNode().ModifyManualTuning(1);
-    m_OrganController->GetRootPipeConfigNode().ModifyAutoTuningCorrection(1);
+    ModifyPitch(1);
     break;
   case ID_SETTER_PITCH_P10:
-    m_OrganController->GetRootPipeConfigNode().ModifyManualTuning(10);
-    m_OrganController->GetRootPipeConfigNode().ModifyAutoTuningCorrection(10);
+    ModifyPitch(10);
     break;
   case ID_SETTER_PITCH_P100:
-    m_OrganController->GetRootPipeConfigNode().ModifyManualTuning(100);
-    m_OrganController->GetRootPipeConfigNode().ModifyAutoTuningCorrection(100);
+    ModifyPitch(100);
     break;
   case ID_SETTER_SAVE_SETTINGS:
     m_OrganController->Save();
@@ -1569,12 +1669,23 @@ void GOSetter::SetPosition(int pos, bool push) {
   wxString buffer;
   int old_pos = m_pos;
   while (pos < 0)
-    pos += m_framegeneral.size();
-  while (pos >= (int)m_framegeneral.size())
-    pos -= m_framegeneral.size();
+    pos += FRAME_GENERALS;
+  while (pos >= FRAME_GENERALS)
+    pos -= FRAME_GENERALS;
   m_pos = pos;
   if (push) {
-    PushGeneral(*m_framegeneral[m_pos], m_buttons[ID_SETTER_L0 + m_pos % 10]);
+    GOButtonControl *pButtonToLight = m_buttons[ID_SETTER_L0 + m_pos % 10];
+    // an absent frame is materialized only when it is going to be stored
+    GOGeneralCombination *pCmb
+      = m_state.m_IsActive ? &GetFrameGeneral(m_pos) : FindFrameGeneral(m_pos);
+
+    if (pCmb)
+      PushGeneral(*pCmb, pButtonToLight);
+    else {
+      // pushing an empty frame changes nothing but the buttons light
+      NotifyCmbPushed(false);
+      UpdateAllSetsButtonsLight(pButtonToLight, -1);
+    }
     m_buttons[ID_SETTER_HOME]->Display(m_pos == 0);
   }
   DisplayPos();
@@ -8,6 +8,8 @@
 #ifndef GOSETTER_H
 #define GOSETTER_H
 
+#include <map>
+#include <memory>
 #include <unordered_set>
 
 #include <wx/arrstr.h>
@@ -24,8 +26,11 @@
 #include "model/GOGeneralCombination.h"
 #include "model/GOOrganLifecycleListener.h"
 #include "model/GOSetterState.h"
+#include "model/pipe-config/GOPipeConfigNode.h"
 #include "yaml/GOSaveableToYaml.h"
 
+#include "GOTimerCallback.h"
+
 #define N_CRESCENDOS 4
 
 class GODivisionalCombination;
@@ -38,7 +43,8 @@ class GOSetter : private GOOrganLifecycleListener,
                  private GOControlChangedHandler,
                  public GOElementCreator,
                  public GOSaveableObject,
-                 public GOSaveableToYaml {
+                 public GOSaveableToYaml,
+                 private GOTimerCallback {
 public:
   enum {
     ID_SETTER_PREV = 0,
@@ -159,6 +165,9 @@ public:
   static const ButtonDefinitionEntry *const P_BUTTON_DEFS;
 
 private:
+  // ms. The pitch changes within this interval are applied to the pipes at once
+  static constexpr unsigned PITCH_UPDATE_INTERVAL = 20;
+
   GOOrganController *m_OrganController;
 
   // working with combination files
@@ -181,7 +190,9 @@ private:
   unsigned m_bank;
   unsigned m_crescendopos;
   unsigned m_crescendobank;
-  ptr_vector<GOGeneralCombination> m_framegeneral;
+  // Maps sequencer positions to materialized frame combinations. Positions
+  // that have never been programmed are absent and are treated as empty
+  std::map<unsigned, GOGeneralCombination *> m_FrameGenerals;
   ptr_vector<GOGeneralCombination> m_general;
   ptr_vector<GOGeneralCombination> m_crescendo;
   bool m_CrescendoOverrideMode[N_CRESCENDOS];
@@ -192,6 +203,8 @@ private:
   GOLabelControl m_TransposeDisplay;
   GOLabelControl m_NameDisplay;
   GOEnclosure m_CrescendoCtrl;
+  // the pending pitch changes. Closed by the timer
+  std::unique_ptr<GOPipeConfigNode::UpdateBatch> mp_PitchBatch;
 
   // Show the combination file name
   void DisplayCmbFile(const wxString &fileName);
@@ -210,6 +223,15 @@ private:
   wxString GetCrescendoCmbStateName(uint8_t crescendoIdx) const;
   void Crescendo(int pos, bool force = false);
 
+  // returns the frame combination at the position or nullptr if it is absent
+  GOGeneralCombination *FindFrameGeneral(unsigned idx) const;
+
+  // returns the frame combination at the position. Creates it if it is absent
+  GOGeneralCombination &GetFrameGeneral(unsigned idx);
+
+  // delete all frame combinations from m_FrameGenerals
+  void ClearFrameGenerals();
+
   /**
    * Copy the sequencer combination
    * @param fromIdx - position of the source combination
@@ -226,11 +248,22 @@ private:
   // Display the current sequencer position on m_PosDisplay in the 00N format
   void DisplayPos();
 
+  /**
+   * Changes the pitch of the whole organ. Repeated changes within
+   * PITCH_UPDATE_INTERVAL are propagated to the pipes only once
+   */
+  void ModifyPitch(float cents);
+  // Applies the pending pitch changes
+  void FlushPitch();
+
+  void HandleTimer() override { FlushPitch(); }
+
   void ButtonStateChanged(int id, bool newState) override;
 
   void ControlChanged(GOControl *control) override;
 
   void PreparePlayback() override;
+  void AbortPlayback() override { FlushPitch(); }
 
   /**
    * Called after at least one combination is changed
@@ -298,6 +331,8 @@ public:
   void FromYaml(const YAML::Node &yamlNode) override;
   void Load(GOConfigReader &cfg) override;
   void Save(GOConfigWriter &cfg) override;
+  // loads the sequencer combinations from the preset file
+  void LoadCombination(GOConfigReader &cfg) override;
   GOEnclosure *GetEnclosure(const wxString &name, bool is_panel) override;
   GOLabelControl *GetLabelControl(const wxString &name, bool is_panel) override;
 
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2025 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -257,6 +257,11 @@ bool GOCombination::isCmbOnFile(GOConfigReader &cfg, const wxString &group) {
     || is_cmb_on_file(cfg, CMBSetting, group);
 }
 
+bool GOCombination::isCmbOnFile(
+  GOConfigReader &cfg, GOSettingType settingType, const wxString &group) {
+  return is_cmb_on_file(cfg, settingType, group);
+}
+
 unsigned GOCombination::ReadNumberOfStops(
   GOConfigReader &cfg, GOSettingType srcType, unsigned maxStops) const {
   int nOfStopsInt = read_number_of_stops(srcType, cfg, m_group, maxStops, true);
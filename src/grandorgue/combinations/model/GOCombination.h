@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -64,8 +64,6 @@ protected:
     GOConfigReader &cfg, GOSettingType srcType, unsigned maxStops) const;
   void WriteNumberOfStops(GOConfigWriter &cfg, unsigned stopCount) const;
 
-  static bool isCmbOnFile(GOConfigReader &cfg, const wxString &group);
-
   /**
    * Set the combination element state when loading. If the element is not found
    * or it's state has already been set the logs an error
@@ -133,6 +131,12 @@ public:
     GOOrganModel &organModel, const GOCombinationDefinition &cmbDef);
   virtual ~GOCombination();
 
+  // checks if a combination exists in the odf or in the cmb with the group
+  static bool isCmbOnFile(GOConfigReader &cfg, const wxString &group);
+  // checks if a combination exists in the specified file with the group
+  static bool isCmbOnFile(
+    GOConfigReader &cfg, GOSettingType settingType, const wxString &group);
+
   const wxString &GetCombinationStateName() const {
     return m_CombinationStateName;
   }
@@ -140,6 +144,7 @@ public:
     m_CombinationStateName = combinationStateName;
   }
 
+  bool IsProtected() const { return m_Protected; }
   bool IsEmpty() const;
   GOBool3 GetElementState(unsigned no) const { return m_ElementStates[no]; }
 
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -26,8 +26,7 @@ GOGeneralCombination::GOGeneralCombination(
   : GOCombination(organModel, organModel.GetGeneralTemplate()),
     m_IsSetter(isSetter) {}
 
-void GOGeneralCombination::Load(GOConfigReader &cfg, const wxString &group) {
-  r_OrganModel.RegisterSaveableObject(this);
+void GOGeneralCombination::Init(GOConfigReader &cfg, const wxString &group) {
   m_group = group;
 
   m_Protected
@@ -38,6 +37,11 @@ void GOGeneralCombination::Load(GOConfigReader &cfg, const wxString &group) {
     LoadCombination(cfg, ODFSetting);
 }
 
+void GOGeneralCombination::Load(GOConfigReader &cfg, const wxString &group) {
+  r_OrganModel.RegisterSaveableObject(this);
+  Init(cfg, group);
+}
+
 const wxString WX_SWITCH_MANUAL_03D = wxT("SwitchManual%03d");
 
 void GOGeneralCombination::LoadCombinationInt(
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -38,6 +38,12 @@ private:
 
 public:
   GOGeneralCombination(GOOrganModel &organModel, bool isSetter);
+
+  /**
+   * Initialises the combination without registering it as a saveable object.
+   * Used for combinations that are saved by their owner
+   */
+  void Init(GOConfigReader &cfg, const wxString &group);
   void Load(GOConfigReader &cfg, const wxString &group);
 };
 
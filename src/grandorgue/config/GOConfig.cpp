@@ -286,8 +286,12 @@ GOConfig::GOConfig(
     OrganSettingsPath(this, GENERAL, wxT("SettingPath"), wxEmptyString),
     OrganCachePath(this, GENERAL, wxT("CachePath"), wxEmptyString),
     Concurrency(this, GENERAL, wxT("Concurrency"), 0, MAX_CPU, 1),
+    AdaptiveConcurrency(this, GENERAL, wxT("AdaptiveConcurrency"), true),
     ReleaseConcurrency(this, GENERAL, wxT("ReleaseConcurrency"), 1, MAX_CPU, 1),
     LoadConcurrency(this, GENERAL, wxT("LoadConcurrency"), 0, MAX_CPU, 1),
+    WatchdogTimeout(this, GENERAL, wxT("WatchdogTimeout"), 0, 60000, 0),
+    LatencyProbe(this, GENERAL, wxT("LatencyProbe"), false),
+    MeasureRenderTime(this, GENERAL, wxT("MeasureRenderTime"), false),
     m_InterpolationType(
       this,
       GENERAL,
@@ -300,6 +304,7 @@ GOConfig::GOConfig(
     AttackLoad(this, GENERAL, wxT("AttackLoad"), 0, 1, 1),
     LoopLoad(this, GENERAL, wxT("LoopLoad"), 0, 2, 2),
     ReleaseLoad(this, GENERAL, wxT("ReleaseLoad"), 0, 1, 1),
+    TruncateReleases(this, GENERAL, wxT("TruncateReleases"), false),
     ManageCache(this, GENERAL, wxT("ManageCache"), true),
     CompressCache(this, GENERAL, wxT("CompressCache"), false),
     LoadLastFile(
@@ -312,6 +317,7 @@ GOConfig::GOConfig(
     ODFHw1Check(this, GENERAL, wxT("ODFHw1Check"), false),
     LoadChannels(this, GENERAL, wxT("Channels"), 0, 2, 2),
     LosslessCompression(this, GENERAL, wxT("LosslessCompression"), false),
+    MidSideCompression(this, GENERAL, wxT("MidSideCompression"), false),
     ManagePolyphony(this, GENERAL, wxT("ManagePolyphony"), true),
     ScaleRelease(this, GENERAL, wxT("ScaleRelease"), true),
     RandomizeSpeaking(this, GENERAL, wxT("RandomizeSpeaking"), true),
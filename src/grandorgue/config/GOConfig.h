@@ -94,8 +94,15 @@ public:
   GOSettingDirectory OrganCachePath;
 
   GOSettingUnsigned Concurrency;
+  GOSettingBool AdaptiveConcurrency;
   GOSettingUnsigned ReleaseConcurrency;
   GOSettingUnsigned LoadConcurrency;
+  // how long a thread may stay stuck before it is reported. 0 - never
+  GOSettingUnsigned WatchdogTimeout;
+  // whether the key-to-sound latency is measured
+  GOSettingBool LatencyProbe;
+  // whether the render time is accounted to the pipes
+  GOSettingBool MeasureRenderTime;
 
   GOSettingUnsigned m_InterpolationType;
   GOSettingUnsigned WaveFormatBytesPerSample;
@@ -104,6 +111,7 @@ public:
   GOSettingUnsigned AttackLoad;
   GOSettingUnsigned LoopLoad;
   GOSettingUnsigned ReleaseLoad;
+  GOSettingBool TruncateReleases;
 
   GOSettingBool ManageCache;
   GOSettingBool CompressCache;
@@ -113,6 +121,8 @@ public:
 
   GOSettingUnsigned LoadChannels;
   GOSettingBool LosslessCompression;
+  // whether the compressed stereo samples are stored as mid/side
+  GOSettingBool MidSideCompression;
   GOSettingBool ManagePolyphony;
   GOSettingBool ScaleRelease;
   GOSettingBool RandomizeSpeaking;
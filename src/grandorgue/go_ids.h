@@ -2,7 +2,7 @@
  * GrandOrgue - a free pipe organ simulator
  *
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  *
  * This program is free software; you can redistribute it and/or
  * modify it under the terms of the GNU General Public License as
@@ -39,13 +39,16 @@ enum {
   ID_LOAD_LRU_LAST = ID_LOAD_LRU_FIRST + 9,
 
   ID_FILE_RELOAD,
+  ID_FILE_RELOAD_DEFINITION,
   ID_FILE_REVERT,
   ID_FILE_IMPORT_COMBINATIONS,
   ID_FILE_EXPORT_COMBINATIONS,
   ID_FILE_IMPORT_SETTINGS,
   ID_FILE_EXPORT,
+  ID_FILE_EXPORT_STATISTIC,
   ID_FILE_CACHE,
   ID_FILE_CACHE_DELETE,
+  ID_FILE_VERIFY,
   ID_FILE_PROPERTIES,
   ID_FILE_SAVE,
   ID_FILE_CLOSE,
@@ -7,6 +7,8 @@
 
 #include "GOGuiApp.h"
 
+#include <algorithm>
+
 #include <wx/cmdline.h>
 
 #if wxDEBUG_LEVEL && defined(GO_HAS_CPPTRACE)
@@ -15,12 +17,17 @@
 #include <wx/filesys.h>
 #include <wx/fs_zip.h>
 #include <wx/regex.h>
+#include <wx/timer.h>
 
 #include "config/GOConfig.h"
 #include "frames/GOAppWindow.h"
+#include "sound/GOSoundLatencyProbe.h"
 #include "sound/GOSoundSystem.h"
+#include "threading/GORealtimeLog.h"
+#include "threading/GOThreadWatchdog.h"
 
 #include "GOGuiLog.h"
+#include "GORandom.h"
 #include "GOStdPath.h"
 #include "go_defs.h"
 
@@ -34,6 +41,20 @@
 
 IMPLEMENT_APP(GOGuiApp)
 
+/**
+ * Beats the heartbeat of the main loop. The timer fires only when the main
+ * loop processes events, so a stalled main loop misses the watchdog deadline
+ */
+class GOMainLoopHeartbeat : public wxTimer {
+private:
+  GOThreadWatchdog::Heartbeat m_heartbeat;
+
+public:
+  GOMainLoopHeartbeat() : m_heartbeat("main loop") {}
+
+  void Notify() override { m_heartbeat.Beat(); }
+};
+
 GOGuiApp::~GOGuiApp() = default;
 
 /**
@@ -156,7 +177,7 @@ bool GOGuiApp::OnInit() {
   wxImage::AddHandler(new wxPNGHandler);
   wxImage::AddHandler(new wxBMPHandler);
   wxImage::AddHandler(new wxICOHandler);
-  srand(::wxGetUTCTime());
+  GORandom::setSeed(::wxGetUTCTime());
 
 #ifdef __WIN32__
   SetThreadExecutionState(
@@ -191,6 +212,19 @@ bool GOGuiApp::OnInit() {
   // mp_TemporaryLog), which wxWidgets won't delete because it's no longer
   // active. Delete it explicitly now that we are done with it.
   delete wxLog::SetActiveTarget(mp_log.get());
+  // the messages from the audio and loader threads go through GOGuiLog too
+  GORealtimeLog::startDraining();
+
+  const unsigned watchdogTimeout = mp_config->WatchdogTimeout();
+
+  if (watchdogTimeout) {
+    GOThreadWatchdog::start(std::chrono::milliseconds(watchdogTimeout));
+    mp_MainLoopHeartbeat = std::make_unique<GOMainLoopHeartbeat>();
+    mp_MainLoopHeartbeat->Notify();
+    mp_MainLoopHeartbeat->Start(std::max(watchdogTimeout / 4, 1u));
+  }
+  if (mp_config->LatencyProbe())
+    GOSoundLatencyProbe::getInstance().Start();
   p_AppWindow->Init(m_FileName, m_IsGuiOnly);
 
   return true;
@@ -206,6 +240,16 @@ void GOGuiApp::MacOpenFile(const wxString &filename) {
 int GOGuiApp::OnRun() { return wxApp::OnRun(); }
 
 int GOGuiApp::OnExit() {
+  mp_MainLoopHeartbeat.reset();
+  GOThreadWatchdog::stop();
+
+  GOSoundLatencyProbe &latencyProbe = GOSoundLatencyProbe::getInstance();
+
+  if (latencyProbe.IsStarted()) {
+    wxLogMessage(wxT("%s"), latencyProbe.GetReport());
+    latencyProbe.Stop();
+  }
+  GORealtimeLog::stopDraining();
   wxLog::FlushActive();
   wxLog::SetActiveTarget(nullptr);
 
@@ -29,6 +29,7 @@
 class GOConfig;
 class GOAppWindow;
 class GOGuiLog;
+class GOMainLoopHeartbeat;
 class GOSoundSystem;
 
 class GOGuiApp : public wxApp {
@@ -60,6 +61,7 @@ protected:
   std::unique_ptr<GOConfig> mp_config;
   std::unique_ptr<GOSoundSystem> mp_SoundSystem;
   std::unique_ptr<GOGuiLog> mp_log;
+  std::unique_ptr<GOMainLoopHeartbeat> mp_MainLoopHeartbeat;
   wxString m_FileName;
   std::string m_InstanceName;
   std::string m_ConfigFilePath;
@@ -7,6 +7,8 @@
 
 #include "GOGuiOrgan.h"
 
+#include <memory>
+
 #include <wx/app.h>
 
 #include "config/GOConfig.h"
@@ -51,13 +53,22 @@ GOOrganController *GOGuiOrgan::LoadOrgan(
   const GOOrgan &organ,
   const wxString &cmb,
   bool isGuiOnly,
-  GOProgressMonitor &monitor) {
+  GOProgressMonitor &monitor,
+  bool isToReuseSamples) {
   wxBusyCursor busy;
   GOConfig &cfg = m_sound.GetSettings();
+  std::unique_ptr<GOOrganController> pDonor;
 
-  CloseOrgan();
+  if (isToReuseSamples)
+    pDonor.reset(DetachOrgan());
+  else
+    CloseOrgan();
   m_OrganController = new GOOrganController(cfg, true);
-  wxString error = m_OrganController->Load(organ, cmb, isGuiOnly, monitor);
+  wxString error = m_OrganController->Load(
+    organ, cmb, isGuiOnly, monitor, pDonor.get());
+
+  // free the samples that have not been taken
+  pDonor.reset();
 
   if (error.IsEmpty()) {
     cfg.AddOrgan(m_OrganController->GetOrganInfo());
@@ -132,7 +143,7 @@ bool GOGuiOrgan::Export(const wxString &cmb) {
   return m_OrganController->Export(cmb);
 }
 
-void GOGuiOrgan::CloseOrgan() {
+GOOrganController *GOGuiOrgan::DetachOrgan() {
   m_listener.SetCallback(NULL);
   m_sound.AssignOrganFile(NULL);
   // m_sound.CloseSound();
@@ -141,14 +152,21 @@ void GOGuiOrgan::CloseOrgan() {
 
   m_OrganFileReady = false;
   GOMutexLocker locker(m_lock);
-  if (m_OrganController) {
-    delete m_OrganController;
-    m_OrganController = 0;
-  }
+  GOOrganController *pOrganController = m_OrganController;
+
+  m_OrganController = 0;
 
   wxCommandEvent event(wxEVT_WINTITLE, 0);
   event.SetString(wxEmptyString);
   wxTheApp->GetTopWindow()->GetEventHandler()->AddPendingEvent(event);
+  return pOrganController;
+}
+
+void GOGuiOrgan::CloseOrgan() {
+  GOOrganController *pOrganController = DetachOrgan();
+
+  if (pOrganController)
+    delete pOrganController;
 }
 
 void GOGuiOrgan::OnMidiEvent(const GOMidiEvent &event) {
@@ -37,6 +37,8 @@ private:
   void OnMidiEvent(const GOMidiEvent &event) override;
 
   void SyncState();
+  // Closes the windows and disconnects the organ. Returns it for deletion
+  GOOrganController *DetachOrgan();
   void CloseOrgan();
 
 public:
@@ -56,11 +58,14 @@ public:
   // Returns the loaded organ controller, or nullptr on failure.
   // Note: on failure CloseOrgan() is called, which also clears
   // m_OrganController.
+  // If isToReuseSamples then the samples of the unchanged pipes are taken from
+  // the currently loaded organ instead of loading them.
   GOOrganController *LoadOrgan(
     const GOOrgan &organ,
     const wxString &cmb,
     bool isGuiOnly,
-    GOProgressMonitor &monitor);
+    GOProgressMonitor &monitor,
+    bool isToReuseSamples = false);
   bool UpdateCache(bool compress, GOProgressMonitor &monitor);
 
   void ShowMIDIEventDialog(
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2025 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -171,6 +171,24 @@ GOPropertiesDialog::GOPropertiesDialog(
     wxTOP,
     5);
 
+  const GOMemoryPool::FragmentationStat fragmentation
+    = m_OrganController->GetMemoryPool().GetFragmentationStat();
+
+  sizer->Add(
+    GOPropertiesText(this, 0, _("Free memory inside the pool")), 0, wxTOP, 5);
+  sizer->Add(
+    GOPropertiesText(
+      this,
+      0,
+      wxString::Format(
+        _("%.3f MB in %u blocks, the largest %.3f MB"),
+        fragmentation.m_FreeSize / (1024.0 * 1024.0),
+        (unsigned)fragmentation.m_NFreeBlocks,
+        fragmentation.m_LargestFreeBlock / (1024.0 * 1024.0))),
+    0,
+    wxTOP,
+    5);
+
   sizer->Add(GOPropertiesText(this, 0, _("ODF Path")), 0, wxTOP, 5);
   sizer->Add(
     GOPropertiesText(this, 300, m_OrganController->GetOrganPathInfo()),
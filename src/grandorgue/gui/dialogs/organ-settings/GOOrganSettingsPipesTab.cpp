@@ -37,9 +37,10 @@ class GOOrganSettingsPipesTab::TreeItemData : public wxTreeItemData {
 public:
   GOPipeConfigNode &r_node;
   GOPipeConfig &r_config;
+  bool m_AreChildrenAdded;
 
   TreeItemData(GOPipeConfigNode &node)
-    : r_node(node), r_config(node.GetPipeConfig()) {}
+    : r_node(node), r_config(node.GetPipeConfig()), m_AreChildrenAdded(false) {}
 };
 
 enum {
@@ -71,6 +72,8 @@ enum {
 DEFINE_LOCAL_EVENT_TYPE(wxEVT_TREE_UPDATED)
 
 BEGIN_EVENT_TABLE(GOOrganSettingsPipesTab, wxPanel)
+EVT_TREE_ITEM_EXPANDING(
+  ID_EVENT_TREE, GOOrganSettingsPipesTab::OnTreeExpanding)
 EVT_TREE_SEL_CHANGING(ID_EVENT_TREE, GOOrganSettingsPipesTab::OnTreeChanging)
 EVT_TREE_SEL_CHANGED(ID_EVENT_TREE, GOOrganSettingsPipesTab::OnTreeChanged)
 EVT_COMMAND(
@@ -156,6 +159,14 @@ GOOrganSettingsPipesTab::GOOrganSettingsPipesTab(
     5);
   m_BitDisplay = new wxStaticText(this, wxID_ANY, wxEmptyString);
   grid->Add(m_BitDisplay);
+
+  grid->Add(
+    new wxStaticText(this, wxID_ANY, _("Render time:")),
+    0,
+    wxALIGN_RIGHT | wxALIGN_CENTER_VERTICAL | wxBOTTOM,
+    5);
+  m_RenderDisplay = new wxStaticText(this, wxID_ANY, wxEmptyString);
+  grid->Add(m_RenderDisplay);
   box1->Add(grid, 0, wxEXPAND | wxALL, 5);
   mainSizer->Add(
     box1, wxGBPosition(0, 1), wxDefaultSpan, wxEXPAND | wxRIGHT, 5);
@@ -393,19 +404,50 @@ GOOrganSettingsPipesTab::GOOrganSettingsPipesTab(
 
 static const wxString WX_SPACE = wxT(" ");
 
-wxTreeItemId GOOrganSettingsPipesTab::FillTree(
-  wxTreeItemId parent, GOPipeConfigNode &config) {
-  wxTreeItemData *data = new TreeItemData(config);
+wxTreeItemId GOOrganSettingsPipesTab::AddTreeItem(
+  wxTreeItemId parent, GOPipeConfigNode &node) {
+  wxTreeItemData *data = new TreeItemData(node);
   wxTreeItemId e;
   if (!parent.IsOk())
-    e = m_Tree->AddRoot(config.GetName(), -1, -1, data);
+    e = m_Tree->AddRoot(node.GetName(), -1, -1, data);
   else
-    e = m_Tree->AppendItem(parent, config.GetName(), -1, -1, data);
-  for (unsigned i = 0; i < config.GetChildCount(); i++)
-    FillTree(e, *config.GetChild(i));
+    e = m_Tree->AppendItem(parent, node.GetName(), -1, -1, data);
+  if (node.GetChildCount())
+    m_Tree->SetItemHasChildren(e, true);
   return e;
 }
 
+void GOOrganSettingsPipesTab::FillTreeChildren(wxTreeItemId item) {
+  TreeItemData *data = (TreeItemData *)m_Tree->GetItemData(item);
+
+  if (data && !data->m_AreChildrenAdded) {
+    GOPipeConfigNode &node = data->r_node;
+
+    data->m_AreChildrenAdded = true;
+    for (unsigned i = 0; i < node.GetChildCount(); i++)
+      AddTreeItem(item, *node.GetChild(i));
+  }
+}
+
+void GOOrganSettingsPipesTab::OnTreeExpanding(wxTreeEvent &e) {
+  FillTreeChildren(e.GetItem());
+}
+
+const GOSampleStatistic &GOOrganSettingsPipesTab::GetStatistic(
+  const GOPipeConfigNode &node) {
+  auto found = m_Statistics.find(&node);
+
+  if (found == m_Statistics.end()) {
+    // the own statistic of the node without the subtree
+    GOSampleStatistic stat = node.GOPipeConfigNode::GetStatistic();
+
+    for (unsigned i = 0; i < node.GetChildCount(); i++)
+      stat.Cumulate(GetStatistic(*node.GetChild(i)));
+    found = m_Statistics.emplace(&node, stat).first;
+  }
+  return found->second;
+}
+
 bool GOOrganSettingsPipesTab::TransferDataToWindow() {
   m_AudioGroup->Clear();
   for (const auto &group : r_config.GetAudioGroups())
@@ -413,7 +455,10 @@ bool GOOrganSettingsPipesTab::TransferDataToWindow() {
   m_AudioGroup->ChangeValue(WX_SPACE);
   m_LastAudioGroup = WX_SPACE;
 
-  wxTreeItemId idRoot = FillTree(wxTreeItemId(), r_RootNode);
+  m_Statistics.clear();
+  wxTreeItemId idRoot = AddTreeItem(wxTreeItemId(), r_RootNode);
+
+  FillTreeChildren(idRoot);
 
   NotifyModified(false);
 
@@ -507,19 +552,29 @@ void GOOrganSettingsPipesTab::Load(bool isForce) {
 
   GOSampleStatistic stat;
 
+  // the render time grows while the organ is playing, so the statistics are
+  // collected again each time they are displayed
+  m_Statistics.clear();
   for (unsigned l = selectedItemIds.size(), i = 0; i < l; i++)
     if (m_Tree->GetItemData(selectedItemIds[i]))
-      stat.Cumulate(((TreeItemData *)m_Tree->GetItemData(selectedItemIds[i]))
-                      ->r_node.GetStatistic());
+      stat.Cumulate(GetStatistic(
+        ((TreeItemData *)m_Tree->GetItemData(selectedItemIds[i]))->r_node));
 
   if (!stat.IsValid()) {
     m_MemoryDisplay->SetLabel(_("--- MB (--- MB end)"));
     m_BitDisplay->SetLabel(_("-- bits (- used)"));
+    m_RenderDisplay->SetLabel(_("---"));
   } else {
-    m_MemoryDisplay->SetLabel(wxString::Format(
+    wxString memoryLabel = wxString::Format(
       _("%.3f MB  (%.3f MB end)"),
       stat.GetMemorySize() / (1024.0 * 1024.0),
-      stat.GetEndSegmentSize() / (1024.0 * 1024.0)));
+      stat.GetEndSegmentSize() / (1024.0 * 1024.0));
+
+    if (stat.GetTruncatedSize())
+      memoryLabel += wxString::Format(
+        _(", %.3f MB saved by release truncation"),
+        stat.GetTruncatedSize() / (1024.0 * 1024.0));
+    m_MemoryDisplay->SetLabel(memoryLabel);
     wxString buf;
     if (stat.GetMinBitPerSample() == stat.GetMaxBitPerSample())
       buf = wxString::Format(_("%d bits"), stat.GetMinBitPerSample());
@@ -530,6 +585,17 @@ void GOOrganSettingsPipesTab::Load(bool isForce) {
         stat.GetMaxBitPerSample());
     m_BitDisplay->SetLabel(
       buf + wxString::Format(_(" (%.3f used)"), stat.GetUsedBits()));
+
+    const uint64_t organRenderNs = GetStatistic(r_RootNode).GetRenderNs();
+
+    if (organRenderNs)
+      m_RenderDisplay->SetLabel(wxString::Format(
+        _("%.1f%% of the organ (%.3f s, %llu voice periods)"),
+        stat.GetRenderNs() * 100.0 / organRenderNs,
+        stat.GetRenderNs() / 1.0e9,
+        (unsigned long long)stat.GetNRenderedPeriods()));
+    else
+      m_RenderDisplay->SetLabel(_("not measured"));
   }
 
   if (selectedItemIds.size() == 0) {
@@ -751,21 +817,17 @@ void GOOrganSettingsPipesTab::Load(bool isForce) {
 }
 
 void GOOrganSettingsPipesTab::UpdateAudioGroup(
-  const std::vector<wxString> &audio_group, unsigned &pos, wxTreeItemId item) {
-  TreeItemData *e = (TreeItemData *)m_Tree->GetItemData(item);
-  if (e) {
-    e->r_config.SetAudioGroup(audio_group[pos]);
-    pos++;
-    if (pos >= audio_group.size())
-      pos = 0;
-  }
-
-  wxTreeItemIdValue it;
-  wxTreeItemId child = m_Tree->GetFirstChild(item, it);
-  while (child.IsOk()) {
-    UpdateAudioGroup(audio_group, pos, child);
-    child = m_Tree->GetNextChild(item, it);
-  }
+  const std::vector<wxString> &audio_group,
+  unsigned &pos,
+  GOPipeConfigNode &node) {
+  node.GetPipeConfig().SetAudioGroup(audio_group[pos]);
+  pos++;
+  if (pos >= audio_group.size())
+    pos = 0;
+
+  // the children may have no tree items yet, so the model is walked
+  for (unsigned i = 0; i < node.GetChildCount(); i++)
+    UpdateAudioGroup(audio_group, pos, *node.GetChild(i));
 }
 
 void GOOrganSettingsPipesTab::OnTreeChanging(wxTreeEvent &e) {
@@ -967,28 +1029,57 @@ void GOOrganSettingsPipesTab::DistributeAudio() {
   wxArrayTreeItemIds entries;
   m_Tree->GetSelections(entries);
   unsigned pos = 0;
-  for (unsigned i = 0; i < entries.size(); i++)
-    UpdateAudioGroup(group_list, pos, entries[i]);
+  for (unsigned i = 0; i < entries.size(); i++) {
+    TreeItemData *e = (TreeItemData *)m_Tree->GetItemData(entries[i]);
+
+    if (e)
+      UpdateAudioGroup(group_list, pos, e->r_node);
+  }
   p_LastTreeItemData = NULL;
   Load(false);
 }
 
+void GOOrganSettingsPipesTab::CheckReleaseTailsLengthened(
+  const std::vector<GOPipeConfigNode *> &nodes,
+  const std::vector<unsigned> &oldReleaseTails) {
+  if (!r_config.TruncateReleases())
+    return;
+
+  bool isLengthened = false;
+
+  for (unsigned i = 0; i < nodes.size() && !isLengthened; i++) {
+    const unsigned oldTail = oldReleaseTails[i];
+    const unsigned newTail = nodes[i]->GetEffectiveReleaseTail();
+
+    isLengthened = oldTail && (!newTail || newTail > oldTail);
+  }
+  if (isLengthened)
+    GOMessageBox(
+      _("The releases are truncated at load time.\n"
+        "The longer release tail will take effect after reloading the organ."),
+      _("Release tail"),
+      wxOK | wxICON_INFORMATION,
+      this);
+}
+
 void GOOrganSettingsPipesTab::ResetToDefault() {
   wxArrayTreeItemIds entries;
   m_Tree->GetSelections(entries);
 
-  std::unordered_set<TreeItemData *> oiSet;
+  std::unordered_set<GOPipeConfigNode *> nodeSet;
+  // the nodes in the order of adding. Used for scanning the children
+  std::vector<GOPipeConfigNode *> nodes;
   bool hasChildren = false;
 
-  // Fill idSet with entries
+  // Fill nodeSet with entries
   for (const wxTreeItemId id : entries) {
     TreeItemData *p = (TreeItemData *)m_Tree->GetItemData(id);
-    wxTreeItemIdValue cookie;
 
-    if (p)
-      oiSet.insert(p);
-    if (!hasChildren && m_Tree->GetFirstChild(id, cookie).IsOk())
-      hasChildren = true;
+    if (p && nodeSet.insert(&p->r_node).second) {
+      nodes.push_back(&p->r_node);
+      if (p->r_node.GetChildCount())
+        hasChildren = true;
+    }
   }
 
   int wxForChildren = hasChildren
@@ -1003,42 +1094,52 @@ void GOOrganSettingsPipesTab::ResetToDefault() {
     : wxNO;
 
   if (wxForChildren != wxCANCEL) {
-    // add the children
+    // add the children. They are taken from the model because the tree items
+    // of the collapsed nodes do not exist
     if (wxForChildren == wxYES) {
-      // entries.size() it may not be precalculated because it is increased
-      for (unsigned i = 0; i < entries.size(); i++) {
-        const wxTreeItemId id = entries[i];
-        wxTreeItemIdValue cookie;
-
-        for (wxTreeItemId c = m_Tree->GetFirstChild(id, cookie); c.IsOk();
-             c = m_Tree->GetNextChild(id, cookie)) {
-          TreeItemData *p = (TreeItemData *)m_Tree->GetItemData(c);
-
-          if (p && oiSet.find(p) == oiSet.end()) {
-            oiSet.insert(p);
-            entries.push_back(c);
-            // c's children will be scanned later in the loop
-          }
+      // nodes.size() it may not be precalculated because it is increased
+      for (unsigned i = 0; i < nodes.size(); i++) {
+        GOPipeConfigNode *node = nodes[i];
+
+        for (unsigned j = 0; j < node->GetChildCount(); j++) {
+          GOPipeConfigNode *c = node->GetChild(j);
+
+          if (nodeSet.insert(c).second)
+            nodes.push_back(c);
+          // c's children will be scanned later in the loop
         }
       }
     }
 
-    for (TreeItemData *e : oiSet) {
-      e->r_config.SetAmplitude(e->r_config.GetDefaultAmplitude());
-      e->r_config.SetGain(e->r_config.GetDefaultGain());
-      e->r_config.SetManualTuning(0);
-      e->r_config.SetAutoTuningCorrection(0);
-      e->r_config.SetDelay(e->r_config.GetDefaultDelay());
-      e->r_config.SetReleaseTail(0);
-      e->r_config.SetToneBalanceValue(0);
-      e->r_config.SetBitsPerSample(-1);
-      e->r_config.SetChannels(-1);
-      e->r_config.SetLoopLoad(-1);
-      e->r_config.SetCompress(BOOL3_DEFAULT);
-      e->r_config.SetAttackLoad(BOOL3_DEFAULT);
-      e->r_config.SetReleaseLoad(BOOL3_DEFAULT);
-      e->r_config.SetIgnorePitch(BOOL3_DEFAULT);
+    std::vector<unsigned> oldReleaseTails;
+
+    for (GOPipeConfigNode *node : nodes)
+      oldReleaseTails.push_back(node->GetEffectiveReleaseTail());
+
+    {
+      // the pipes are updated once after all nodes are reset
+      GOPipeConfigNode::UpdateBatch batch(r_RootNode);
+
+      for (GOPipeConfigNode *node : nodes) {
+        GOPipeConfig &config = node->GetPipeConfig();
+
+        config.SetAmplitude(config.GetDefaultAmplitude());
+        config.SetGain(config.GetDefaultGain());
+        config.SetManualTuning(0);
+        config.SetAutoTuningCorrection(0);
+        config.SetDelay(config.GetDefaultDelay());
+        config.SetReleaseTail(0);
+        config.SetToneBalanceValue(0);
+        config.SetBitsPerSample(-1);
+        config.SetChannels(-1);
+        config.SetLoopLoad(-1);
+        config.SetCompress(BOOL3_DEFAULT);
+        config.SetAttackLoad(BOOL3_DEFAULT);
+        config.SetReleaseLoad(BOOL3_DEFAULT);
+        config.SetIgnorePitch(BOOL3_DEFAULT);
+      }
     }
+    CheckReleaseTailsLengthened(nodes, oldReleaseTails);
 
     p_LastTreeItemData = NULL;
     Load(true);
@@ -1119,64 +1220,83 @@ void GOOrganSettingsPipesTab::ApplyChanges() {
     return;
   }
 
-  for (unsigned i = 0; i < entries.size(); i++) {
-    TreeItemData *e = (TreeItemData *)m_Tree->GetItemData(entries[i]);
-    if (!e)
-      continue;
+  std::vector<GOPipeConfigNode *> nodes;
+  std::vector<unsigned> oldReleaseTails;
 
-    GOPipeConfigNode *parent = e->r_node.GetParent();
-
-    if (m_Amplitude->IsModified())
-      e->r_config.SetAmplitude(amp);
-    if (m_Gain->IsModified())
-      e->r_config.SetGain(gain);
-    if (m_ManualTuning->IsModified())
-      e->r_config.SetManualTuning(manualTuning);
-    if (m_AutoTuningCorrection->IsModified())
-      e->r_config.SetAutoTuningCorrection(autoTuningCorrection);
-    if (m_Delay->IsModified())
-      e->r_config.SetDelay(delay);
-    if (isReleaseLengthPresent && m_ReleaseLength->IsModified()) {
-      long parentReleaseLength = parent ? parent->GetEffectiveReleaseTail() : 0;
-      bool isLessThanParent = releaseLength > 0
-        && (!parentReleaseLength || releaseLength < parentReleaseLength);
-
-      // calculate new effective release length
-      if (!isLessThanParent)
-        releaseLength = parentReleaseLength;
-      e->r_config.SetReleaseTail(isLessThanParent ? releaseLength : 0);
+  for (const wxTreeItemId id : entries) {
+    TreeItemData *e = (TreeItemData *)m_Tree->GetItemData(id);
+
+    if (e) {
+      nodes.push_back(&e->r_node);
+      oldReleaseTails.push_back(e->r_node.GetEffectiveReleaseTail());
     }
-    if (m_ToneBalance->IsModified())
-      e->r_config.SetToneBalanceValue(toneBalance);
-    if (m_AudioGroup->GetValue() != m_LastAudioGroup)
-      e->r_config.SetAudioGroup(m_AudioGroup->GetValue().Trim());
-    if (m_BitsPerSample->GetSelection() != m_LastBitsPerSample)
-      e->r_config.SetBitsPerSample(
-        m_BitsPerSample->GetSelection() == 0
-          ? (int8_t)-1
-          : (int8_t)(m_BitsPerSample->GetSelection() + 7));
-    if (m_Channels->GetSelection() != m_LastChannels)
-      e->r_config.SetChannels((int8_t)(m_Channels->GetSelection() - 1));
-    if (m_LoopLoad->GetSelection() != m_LastLoopLoad)
-      e->r_config.SetLoopLoad((int8_t)(m_LoopLoad->GetSelection() - 1));
-    if (m_Compress->GetSelection() != m_LastCompress)
-      e->r_config.SetCompress(to_bool3(m_Compress->GetSelection() - 1));
-    if (m_AttackLoad->GetSelection() != m_LastAttackLoad)
-      e->r_config.SetAttackLoad(to_bool3(m_AttackLoad->GetSelection() - 1));
-    if (m_ReleaseLoad->GetSelection() != m_LastReleaseLoad)
-      e->r_config.SetReleaseLoad(to_bool3(m_ReleaseLoad->GetSelection() - 1));
-
-    bool ignorePitch = m_IgnorePitch->IsChecked();
-
-    if (ignorePitch != m_LastIgnorePitch) {
-      bool parentIgnorePitch
-        = parent ? parent->GetEffectiveIgnorePitch() : false;
-
-      e->r_config.SetIgnorePitch(
-        ignorePitch == parentIgnorePitch ? BOOL3_DEFAULT
-                                         : to_bool3(ignorePitch));
+  }
+
+  {
+    // the pipes are updated once after all selected nodes are changed
+    GOPipeConfigNode::UpdateBatch batch(r_RootNode);
+
+    for (unsigned i = 0; i < entries.size(); i++) {
+      TreeItemData *e = (TreeItemData *)m_Tree->GetItemData(entries[i]);
+      if (!e)
+        continue;
+
+      GOPipeConfigNode *parent = e->r_node.GetParent();
+
+      if (m_Amplitude->IsModified())
+        e->r_config.SetAmplitude(amp);
+      if (m_Gain->IsModified())
+        e->r_config.SetGain(gain);
+      if (m_ManualTuning->IsModified())
+        e->r_config.SetManualTuning(manualTuning);
+      if (m_AutoTuningCorrection->IsModified())
+        e->r_config.SetAutoTuningCorrection(autoTuningCorrection);
+      if (m_Delay->IsModified())
+        e->r_config.SetDelay(delay);
+      if (isReleaseLengthPresent && m_ReleaseLength->IsModified()) {
+        long parentReleaseLength
+          = parent ? parent->GetEffectiveReleaseTail() : 0;
+        bool isLessThanParent = releaseLength > 0
+          && (!parentReleaseLength || releaseLength < parentReleaseLength);
+
+        // calculate new effective release length
+        if (!isLessThanParent)
+          releaseLength = parentReleaseLength;
+        e->r_config.SetReleaseTail(isLessThanParent ? releaseLength : 0);
+      }
+      if (m_ToneBalance->IsModified())
+        e->r_config.SetToneBalanceValue(toneBalance);
+      if (m_AudioGroup->GetValue() != m_LastAudioGroup)
+        e->r_config.SetAudioGroup(m_AudioGroup->GetValue().Trim());
+      if (m_BitsPerSample->GetSelection() != m_LastBitsPerSample)
+        e->r_config.SetBitsPerSample(
+          m_BitsPerSample->GetSelection() == 0
+            ? (int8_t)-1
+            : (int8_t)(m_BitsPerSample->GetSelection() + 7));
+      if (m_Channels->GetSelection() != m_LastChannels)
+        e->r_config.SetChannels((int8_t)(m_Channels->GetSelection() - 1));
+      if (m_LoopLoad->GetSelection() != m_LastLoopLoad)
+        e->r_config.SetLoopLoad((int8_t)(m_LoopLoad->GetSelection() - 1));
+      if (m_Compress->GetSelection() != m_LastCompress)
+        e->r_config.SetCompress(to_bool3(m_Compress->GetSelection() - 1));
+      if (m_AttackLoad->GetSelection() != m_LastAttackLoad)
+        e->r_config.SetAttackLoad(to_bool3(m_AttackLoad->GetSelection() - 1));
+      if (m_ReleaseLoad->GetSelection() != m_LastReleaseLoad)
+        e->r_config.SetReleaseLoad(to_bool3(m_ReleaseLoad->GetSelection() - 1));
+
+      bool ignorePitch = m_IgnorePitch->IsChecked();
+
+      if (ignorePitch != m_LastIgnorePitch) {
+        bool parentIgnorePitch
+          = parent ? parent->GetEffectiveIgnorePitch() : false;
+
+        e->r_config.SetIgnorePitch(
+          ignorePitch == parentIgnorePitch ? BOOL3_DEFAULT
+                                           : to_bool3(ignorePitch));
+      }
     }
   }
+  CheckReleaseTailsLengthened(nodes, oldReleaseTails);
   if (m_Amplitude->IsModified()) {
     m_Amplitude->ChangeValue(wxString::Format(wxT("%.1f"), amp));
     m_Amplitude
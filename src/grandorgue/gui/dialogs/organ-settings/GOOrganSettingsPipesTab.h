@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2025 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -8,12 +8,14 @@
 #ifndef GOORGANSETTINGSPIPESTAB_H
 #define GOORGANSETTINGSPIPESTAB_H
 
+#include <unordered_map>
 #include <vector>
 
 #include <wx/event.h>
 #include <wx/panel.h>
 
 #include "GOOrganSettingsTab.h"
+#include "GOSampleStatistic.h"
 
 class wxCheckBox;
 class wxChoice;
@@ -39,6 +41,7 @@ private:
   wxTreeCtrl *m_Tree;
   wxStaticText *m_MemoryDisplay;
   wxStaticText *m_BitDisplay;
+  wxStaticText *m_RenderDisplay;
   wxTextCtrl *m_Amplitude;
   wxSpinButton *m_AmplitudeSpin;
   wxTextCtrl *m_Gain;
@@ -72,17 +75,35 @@ private:
 
   TreeItemData *p_LastTreeItemData;
   unsigned m_LoadChangeCnt;
-
-  wxTreeItemId FillTree(wxTreeItemId parent, GOPipeConfigNode &config);
+  // the statistics of the subtrees calculated once per Load()
+  std::unordered_map<const GOPipeConfigNode *, GOSampleStatistic> m_Statistics;
+
+  /**
+   * Adds an item for the node. The children items are added only when the
+   * item is expanded
+   */
+  wxTreeItemId AddTreeItem(wxTreeItemId parent, GOPipeConfigNode &node);
+  void FillTreeChildren(wxTreeItemId item);
+  const GOSampleStatistic &GetStatistic(const GOPipeConfigNode &node);
   bool TransferDataToWindow() override;
 
   void SetEmpty(wxChoice *choice);
   void RemoveEmpty(wxChoice *choice);
 
   void Load(bool isForce);
+  /**
+   * Tells the user that a reload is needed if the release tail of some node
+   * has become longer while the releases are truncated at load time
+   */
+  void CheckReleaseTailsLengthened(
+    const std::vector<GOPipeConfigNode *> &nodes,
+    const std::vector<unsigned> &oldReleaseTails);
   void UpdateAudioGroup(
-    const std::vector<wxString> &audio_group, unsigned &pos, wxTreeItemId item);
+    const std::vector<wxString> &audio_group,
+    unsigned &pos,
+    GOPipeConfigNode &node);
 
+  void OnTreeExpanding(wxTreeEvent &e);
   void OnTreeChanging(wxTreeEvent &e);
   void OnTreeChanged(wxTreeEvent &e);
   void OnTreeUpdated(wxCommandEvent &e) { Load(false); }
@@ -29,10 +29,14 @@ GOSettingsOptions::GOSettingsOptions(GOConfig &settings, wxWindow *parent)
 
   m_OldChannels = m_config.LoadChannels();
   m_OldLosslessCompression = m_config.LosslessCompression();
+  m_OldMidSideCompression = m_config.MidSideCompression();
   m_OldBitsPerSample = m_config.BitsPerSample();
   m_OldLoopLoad = m_config.LoopLoad();
   m_OldAttackLoad = m_config.AttackLoad();
   m_OldReleaseLoad = m_config.ReleaseLoad();
+  m_OldTruncateReleases = m_config.TruncateReleases();
+  m_OldWatchdogTimeout = m_config.WatchdogTimeout();
+  m_OldLatencyProbe = m_config.LatencyProbe();
 
   wxBoxSizer *topSizer = new wxBoxSizer(wxVERTICAL);
   wxBoxSizer *item0 = new wxBoxSizer(wxHORIZONTAL);
@@ -213,13 +217,48 @@ GOSettingsOptions::GOSettingsOptions(GOConfig &settings, wxWindow *parent)
       this, ID_WAVE_FORMAT, wxDefaultPosition, wxDefaultSize, choices),
     0,
     wxALL);
+  grid->Add(
+    new wxStaticText(
+      this, wxID_ANY, _("Report threads stuck longer than (ms, 0 - off):")),
+    0,
+    wxALIGN_CENTER_VERTICAL | wxALIGN_RIGHT);
+  grid->Add(
+    m_WatchdogTimeout = new wxSpinCtrl(
+      this,
+      ID_WATCHDOG_TIMEOUT,
+      wxEmptyString,
+      wxDefaultPosition,
+      SPINCTRL_SIZE),
+    0,
+    wxALL);
+  m_WatchdogTimeout->SetRange(0, 60000);
   item6->Add(grid, 0, wxEXPAND | wxALL, 5);
+  item6->Add(
+    m_AdaptiveConcurrency = new wxCheckBox(
+      this,
+      ID_ADAPTIVE_CONCURRENCY,
+      _("Use only as many CPU cores as the current load requires")),
+    0,
+    wxEXPAND | wxALL,
+    5);
   item6->Add(
     m_RecordDownmix
     = new wxCheckBox(this, ID_RECORD_DOWNMIX, _("Record stereo downmix")),
     0,
     wxEXPAND | wxALL,
     5);
+  item6->Add(
+    m_LatencyProbe = new wxCheckBox(
+      this, ID_LATENCY_PROBE, _("Measure the key-to-sound latency")),
+    0,
+    wxEXPAND | wxALL,
+    5);
+  item6->Add(
+    m_MeasureRenderTime = new wxCheckBox(
+      this, ID_MEASURE_RENDER_TIME, _("Measure the render time of the ranks")),
+    0,
+    wxEXPAND | wxALL,
+    5);
 
   item6 = new wxStaticBoxSizer(wxVERTICAL, this, _("&Default volume"));
   grid = new wxFlexGridSizer(2, 5, 5);
@@ -240,10 +279,14 @@ GOSettingsOptions::GOSettingsOptions(GOConfig &settings, wxWindow *parent)
 
   m_Interpolation->Select(m_config.m_InterpolationType());
   m_Concurrency->Select(m_config.Concurrency() - 1);
+  m_AdaptiveConcurrency->SetValue(m_config.AdaptiveConcurrency());
   m_ReleaseConcurrency->Select(m_config.ReleaseConcurrency() - 1);
   m_LoadConcurrency->Select(m_config.LoadConcurrency());
+  m_WatchdogTimeout->SetValue(m_config.WatchdogTimeout());
   m_WaveFormat->Select(m_config.WaveFormatBytesPerSample() - 1);
   m_RecordDownmix->SetValue(m_config.RecordDownmix());
+  m_LatencyProbe->SetValue(m_config.LatencyProbe());
+  m_MeasureRenderTime->SetValue(m_config.MeasureRenderTime());
 
   item9 = new wxBoxSizer(wxVERTICAL);
 
@@ -257,6 +300,24 @@ GOSettingsOptions::GOSettingsOptions(GOConfig &settings, wxWindow *parent)
     wxEXPAND | wxALL,
     5);
   m_LosslessCompression->SetValue(m_config.LosslessCompression());
+  item6->Add(
+    m_MidSideCompression = new wxCheckBox(
+      this,
+      ID_MID_SIDE_COMPRESSION,
+      _("Store compressed stereo samples as mid/side")),
+    0,
+    wxEXPAND | wxALL,
+    5);
+  m_MidSideCompression->SetValue(m_config.MidSideCompression());
+  item6->Add(
+    m_TruncateReleases = new wxCheckBox(
+      this,
+      ID_TRUNCATE_RELEASES,
+      _("Don't load releases beyond the release length")),
+    0,
+    wxEXPAND | wxALL,
+    5);
+  m_TruncateReleases->SetValue(m_config.TruncateReleases());
 
   grid = new wxFlexGridSizer(2, 5, 5);
   item6->Add(grid, 0, wxEXPAND | wxALL, 5);
@@ -402,6 +463,7 @@ GOSettingsOptions::GOSettingsOptions(GOConfig &settings, wxWindow *parent)
 
 bool GOSettingsOptions::TransferDataFromWindow() {
   m_config.LosslessCompression(m_LosslessCompression->IsChecked());
+  m_config.MidSideCompression(m_MidSideCompression->IsChecked());
   m_config.ManagePolyphony(m_Limit->IsChecked());
   m_config.CompressCache(m_CompressCache->IsChecked());
   m_config.ManageCache(m_ManageCache->IsChecked());
@@ -409,18 +471,23 @@ bool GOSettingsOptions::TransferDataFromWindow() {
   m_config.ODFCheck(m_ODFCheck->IsChecked());
   m_config.ODFHw1Check(m_ODFHw1Check->IsChecked());
   m_config.RecordDownmix(m_RecordDownmix->IsChecked());
+  m_config.LatencyProbe(m_LatencyProbe->IsChecked());
+  m_config.MeasureRenderTime(m_MeasureRenderTime->IsChecked());
   m_config.Volume(m_Volume->GetValue());
   m_config.ScaleRelease(m_Scale->IsChecked());
   m_config.RandomizeSpeaking(m_Random->IsChecked());
   m_config.NewBasMelBehaviour(m_NewBasMel->IsChecked());
   m_config.Concurrency(m_Concurrency->GetSelection() + 1);
+  m_config.AdaptiveConcurrency(m_AdaptiveConcurrency->IsChecked());
   m_config.ReleaseConcurrency(m_ReleaseConcurrency->GetSelection() + 1);
   m_config.LoadConcurrency(m_LoadConcurrency->GetSelection());
+  m_config.WatchdogTimeout(m_WatchdogTimeout->GetValue());
   m_config.WaveFormatBytesPerSample(m_WaveFormat->GetSelection() + 1);
   m_config.BitsPerSample(m_BitsPerSample->GetSelection() * 4 + 8);
   m_config.LoopLoad(m_LoopLoad->GetSelection());
   m_config.AttackLoad(m_AttackLoad->GetSelection());
   m_config.ReleaseLoad(m_ReleaseLoad->GetSelection());
+  m_config.TruncateReleases(m_TruncateReleases->IsChecked());
   m_config.LoadChannels(m_Channels->GetSelection());
   m_config.m_InterpolationType(m_Interpolation->GetSelection());
   m_config.MemoryLimit(m_MemoryLimit->GetValue());
@@ -436,13 +503,17 @@ bool GOSettingsOptions::TransferDataFromWindow() {
 
 bool GOSettingsOptions::NeedReload() {
   return m_OldLosslessCompression != m_config.LosslessCompression()
+    || m_OldMidSideCompression != m_config.MidSideCompression()
     || m_OldBitsPerSample != m_config.BitsPerSample()
     || m_OldLoopLoad != m_config.LoopLoad()
     || m_OldAttackLoad != m_config.AttackLoad()
     || m_OldReleaseLoad != m_config.ReleaseLoad()
+    || m_OldTruncateReleases != m_config.TruncateReleases()
     || m_OldChannels != m_config.LoadChannels();
 }
 
 bool GOSettingsOptions::NeedRestart() {
-  return m_OldLanguageCode != m_config.LanguageCode();
+  return m_OldLanguageCode != m_config.LanguageCode()
+    || m_OldWatchdogTimeout != m_config.WatchdogTimeout()
+    || m_OldLatencyProbe != m_config.LatencyProbe();
 }
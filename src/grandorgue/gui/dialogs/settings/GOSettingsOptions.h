@@ -21,9 +21,12 @@ class GOSettingsOptions : public wxPanel {
   enum {
     ID_WAVE_FORMAT = 200,
     ID_CONCURRENCY,
+    ID_ADAPTIVE_CONCURRENCY,
     ID_RELEASE_CONCURRENCY,
     ID_LOAD_CONCURRENCY,
+    ID_WATCHDOG_TIMEOUT,
     ID_LOSSLESS_COMPRESSION,
+    ID_MID_SIDE_COMPRESSION,
     ID_MANAGE_POLYPHONY,
     ID_COMPRESS_CACHE,
     ID_MANAGE_CACHE,
@@ -34,11 +37,14 @@ class GOSettingsOptions : public wxPanel {
     ID_LOOP_LOAD,
     ID_ATTACK_LOAD,
     ID_RELEASE_LOAD,
+    ID_TRUNCATE_RELEASES,
     ID_CHANNELS,
     ID_INTERPOLATION,
     ID_MEMORY_LIMIT,
     ID_ODF_CHECK,
     ID_RECORD_DOWNMIX,
+    ID_LATENCY_PROBE,
+    ID_MEASURE_RENDER_TIME,
     ID_VOLUME,
     ID_LANGUAGE,
     ID_NEW_BAS_MEL,
@@ -47,10 +53,13 @@ class GOSettingsOptions : public wxPanel {
 private:
   GOConfig &m_config;
   wxChoice *m_Concurrency;
+  wxCheckBox *m_AdaptiveConcurrency;
   wxChoice *m_ReleaseConcurrency;
   wxChoice *m_LoadConcurrency;
+  wxSpinCtrl *m_WatchdogTimeout;
   wxChoice *m_WaveFormat;
   wxCheckBox *m_LosslessCompression;
+  wxCheckBox *m_MidSideCompression;
   wxCheckBox *m_Limit;
   wxCheckBox *m_CompressCache;
   wxCheckBox *m_ManageCache;
@@ -61,11 +70,14 @@ private:
   wxCheckBox *m_ODFCheck;
   wxCheckBox *m_ODFHw1Check;
   wxCheckBox *m_RecordDownmix;
+  wxCheckBox *m_LatencyProbe;
+  wxCheckBox *m_MeasureRenderTime;
   wxSpinCtrl *m_Volume;
   wxChoice *m_BitsPerSample;
   wxChoice *m_LoopLoad;
   wxChoice *m_AttackLoad;
   wxChoice *m_ReleaseLoad;
+  wxCheckBox *m_TruncateReleases;
   wxChoice *m_Channels;
   wxChoice *m_Interpolation;
   wxSpinCtrl *m_MemoryLimit;
@@ -75,10 +87,14 @@ private:
   wxString m_OldLanguageCode;
   unsigned m_OldChannels;
   bool m_OldLosslessCompression;
+  bool m_OldMidSideCompression;
   unsigned m_OldBitsPerSample;
   unsigned m_OldLoopLoad;
   unsigned m_OldAttackLoad;
   unsigned m_OldReleaseLoad;
+  bool m_OldTruncateReleases;
+  unsigned m_OldWatchdogTimeout;
+  bool m_OldLatencyProbe;
 
 public:
   GOSettingsOptions(GOConfig &settings, wxWindow *parent);
@@ -89,14 +89,17 @@ EVT_MENU(ID_FILE_SAVE, GOAppWindow::OnSave)
 EVT_MENU(ID_FILE_CLOSE, GOAppWindow::OnMenuClose)
 EVT_MENU(ID_FILE_EXIT, GOAppWindow::OnExit)
 EVT_MENU(ID_FILE_RELOAD, GOAppWindow::OnReload)
+EVT_MENU(ID_FILE_RELOAD_DEFINITION, GOAppWindow::OnReloadDefinition)
 EVT_MENU(ID_FILE_REVERT, GOAppWindow::OnRevert)
 EVT_MENU(ID_FILE_PROPERTIES, GOAppWindow::OnProperties)
 EVT_MENU(ID_FILE_IMPORT_COMBINATIONS, GOAppWindow::OnImportCombinations)
 EVT_MENU(ID_FILE_EXPORT_COMBINATIONS, GOAppWindow::OnExportCombinations)
 EVT_MENU(ID_FILE_IMPORT_SETTINGS, GOAppWindow::OnImportSettings)
 EVT_MENU(ID_FILE_EXPORT, GOAppWindow::OnExport)
+EVT_MENU(ID_FILE_EXPORT_STATISTIC, GOAppWindow::OnExportStatistic)
 EVT_MENU(ID_FILE_CACHE, GOAppWindow::OnCache)
 EVT_MENU(ID_FILE_CACHE_DELETE, GOAppWindow::OnCacheDelete)
+EVT_MENU(ID_FILE_VERIFY, GOAppWindow::OnVerify)
 EVT_MENU(ID_ORGAN_EDIT, GOAppWindow::OnOrganSettings)
 EVT_MENU(ID_MIDI_LIST, GOAppWindow::OnMidiList)
 EVT_MENU(ID_STOPS, GOAppWindow::OnStops)
@@ -222,9 +225,19 @@ GOAppWindow::GOAppWindow(
     ID_FILE_CACHE, _("&Update Cache..."), wxEmptyString, wxITEM_NORMAL);
   m_file_menu->Append(
     ID_FILE_CACHE_DELETE, _("Delete &Cache..."), wxEmptyString, wxITEM_NORMAL);
+  m_file_menu->Append(
+    ID_FILE_VERIFY,
+    _("&Verify Organ Packages..."),
+    wxEmptyString,
+    wxITEM_NORMAL);
   m_file_menu->AppendSeparator();
   m_file_menu->Append(
     ID_FILE_RELOAD, _("Re&load"), wxEmptyString, wxITEM_NORMAL);
+  m_file_menu->Append(
+    ID_FILE_RELOAD_DEFINITION,
+    _("Reload Organ &Definition"),
+    wxEmptyString,
+    wxITEM_NORMAL);
   m_file_menu->Append(
     ID_FILE_REVERT, _("Reset to &Defaults"), wxEmptyString, wxITEM_NORMAL);
   m_file_menu->AppendSeparator();
@@ -245,6 +258,11 @@ GOAppWindow::GOAppWindow(
     wxITEM_NORMAL);
   m_file_menu->Append(
     ID_FILE_EXPORT, _("&Export Settings"), wxEmptyString, wxITEM_NORMAL);
+  m_file_menu->Append(
+    ID_FILE_EXPORT_STATISTIC,
+    _("Export Rank &Statistics..."),
+    wxEmptyString,
+    wxITEM_NORMAL);
   m_file_menu->AppendSeparator();
   m_file_menu->Append(
     ID_SETTINGS, wxT("&Settings..."), wxEmptyString, wxITEM_NORMAL);
@@ -625,28 +643,35 @@ void GOAppWindow::EnsureOrganStopped() {
   }
 }
 
+bool GOAppWindow::SaveModifiedOrgan(bool isForce) {
+  bool isOk = true;
+
+  if (mp_organ && mp_organ->IsModified()) {
+    int choice = isForce ? wxYES
+                         : wxMessageBox(
+                           _("The organ settings have been modified\n"
+                             "Do you want to save them?"),
+                           _("Save organ settings"),
+                           wxYES_NO | wxCANCEL | wxCENTRE,
+                           this);
+
+    switch (choice) {
+    case wxYES:
+      isOk = mp_organ->Save();
+      break;
+    case wxCANCEL:
+      isOk = false;
+      break;
+    }
+  }
+  return isOk;
+}
+
 bool GOAppWindow::CloseOrgan(bool isForce) {
   bool isClosed = true;
 
   if (mp_organ) {
-    if (mp_organ->IsModified()) {
-      int choice = isForce ? wxYES
-                           : wxMessageBox(
-                             _("The organ settings have been modified\n"
-                               "Do you want to save them?"),
-                             _("Save organ settings"),
-                             wxYES_NO | wxCANCEL | wxCENTRE,
-                             this);
-
-      switch (choice) {
-      case wxYES:
-        isClosed = mp_organ->Save();
-        break;
-      case wxCANCEL:
-        isClosed = false;
-        break;
-      }
-    }
+    isClosed = SaveModifiedOrgan(isForce);
 
     if (isClosed) {
       GOMutexLocker m_locker(m_mutex, true);
@@ -664,11 +689,13 @@ bool GOAppWindow::CloseOrgan(bool isForce) {
   return isClosed;
 }
 
-void GOAppWindow::LoadOrgan(const GOOrgan &organ, const wxString &cmb) {
+void GOAppWindow::LoadOrgan(
+  const GOOrgan &organ, const wxString &cmb, bool isToReuseSamples) {
   if (mp_organ) {
     GOProgressDialog dlg;
 
-    p_OrganController = mp_organ->LoadOrgan(organ, cmb, m_IsGuiOnly, dlg);
+    p_OrganController = mp_organ->LoadOrgan(
+      organ, cmb, m_IsGuiOnly, dlg, isToReuseSamples);
     OnIsModifiedChanged(false);
 
     if (p_OrganController)
@@ -860,6 +887,9 @@ void GOAppWindow::OnUpdateLoaded(wxUpdateUIEvent &event) {
     event.Enable(p_OrganController && p_OrganController->CachePresent());
   else if (event.GetId() == ID_FILE_CACHE)
     event.Enable(p_OrganController && p_OrganController->IsCacheable());
+  else if (event.GetId() == ID_FILE_VERIFY)
+    event.Enable(
+      p_OrganController && p_OrganController->GetFileStore().AreArchivesUsed());
   else if (event.GetId() == ID_MIDI_MONITOR)
     event.Enable(true);
   else
@@ -1066,6 +1096,37 @@ wxString formatSize(wxLongLong &size) {
   return wxString::Format(wxT("%.2f %s"), n, wxGetTranslation(sizes[i]));
 }
 
+void GOAppWindow::OnExportStatistic(wxCommandEvent &event) {
+  if (p_OrganController) {
+    wxFileDialog dlg(
+      this,
+      _("Export Rank Statistics"),
+      r_config.ExportImportPath(),
+      wxEmptyString,
+      _("CSV files (*.csv)|*.csv"),
+      wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+
+    if (dlg.ShowModal() == wxID_OK) {
+      wxString exportedFilePath = dlg.GetPath();
+
+      if (!exportedFilePath.EndsWith(wxT(".csv"), NULL))
+        exportedFilePath += wxT(".csv");
+      const wxString errMsg
+        = p_OrganController->ExportStatistic(exportedFilePath);
+
+      if (!errMsg.IsEmpty())
+        GOMessageBox(
+          wxString::Format(
+            _("Failed to export the statistics to '%s': %s"),
+            exportedFilePath,
+            errMsg),
+          _("Error"),
+          wxOK | wxICON_ERROR,
+          this);
+    }
+  }
+}
+
 void GOAppWindow::OnCache(wxCommandEvent &event) {
   bool res = true;
   GOMutexLocker m_locker(m_mutex, true);
@@ -1089,6 +1150,34 @@ void GOAppWindow::OnCacheDelete(wxCommandEvent &event) {
     p_OrganController->DeleteCache();
 }
 
+void GOAppWindow::OnVerify(wxCommandEvent &event) {
+  GOMutexLocker m_locker(m_mutex, true);
+
+  if (!m_locker.IsLocked() || !p_OrganController)
+    return;
+
+  unsigned nCorrupted;
+
+  {
+    GOProgressDialog dlg;
+
+    nCorrupted = p_OrganController->VerifyPackages(dlg);
+  }
+  if (nCorrupted)
+    GOMessageBox(
+      wxString::Format(
+        _("%u files of the organ packages are corrupted"), nCorrupted),
+      _("Error"),
+      wxOK | wxICON_ERROR,
+      this);
+  else
+    GOMessageBox(
+      _("No corrupted files found in the organ packages"),
+      _("Verify Organ Packages"),
+      wxOK | wxICON_INFORMATION,
+      this);
+}
+
 void GOAppWindow::OnReload(wxCommandEvent &event) {
   if (p_OrganController) {
     GOOrgan organ = p_OrganController->GetOrganInfo();
@@ -1098,6 +1187,21 @@ void GOAppWindow::OnReload(wxCommandEvent &event) {
   }
 }
 
+void GOAppWindow::OnReloadDefinition(wxCommandEvent &event) {
+  if (p_OrganController && SaveModifiedOrgan(false)) {
+    GOOrgan organ = p_OrganController->GetOrganInfo();
+    GOMutexLocker m_locker(m_mutex, true);
+
+    if (m_locker.IsLocked()) {
+      EnsureOrganStopped();
+      p_OrganController->SetModificationListener(nullptr);
+      p_OrganController = nullptr;
+      UpdatePanelMenu();
+      LoadOrgan(organ, wxEmptyString, true);
+    }
+  }
+}
+
 void GOAppWindow::OnMenuClose(wxCommandEvent &event) {
   if (mp_organ)
     CloseOrgan(false);
@@ -115,7 +115,15 @@ private:
   // updates some controls according the organ model changes
   void OnIsModifiedChanged(bool modified) override;
 
-  void LoadOrgan(const GOOrgan &organ, const wxString &cmb = wxEmptyString);
+  /**
+   * Loads the organ into the current document
+   * @param isToReuseSamples whether the samples of the unchanged pipes are
+   *   taken from the currently loaded organ instead of loading them
+   */
+  void LoadOrgan(
+    const GOOrgan &organ,
+    const wxString &cmb = wxEmptyString,
+    bool isToReuseSamples = false);
 
   void OnMeters(wxCommandEvent &event);
   void OnLoadFile(wxCommandEvent &event);
@@ -131,9 +139,12 @@ private:
   void OnExportCombinations(wxCommandEvent &event);
   void OnImportSettings(wxCommandEvent &event);
   void OnExport(wxCommandEvent &event);
+  void OnExportStatistic(wxCommandEvent &event);
   void OnCache(wxCommandEvent &event);
   void OnCacheDelete(wxCommandEvent &event);
+  void OnVerify(wxCommandEvent &event);
   void OnReload(wxCommandEvent &event);
+  void OnReloadDefinition(wxCommandEvent &event);
   void OnRevert(wxCommandEvent &event);
   void OnProperties(wxCommandEvent &event);
 
@@ -187,6 +198,11 @@ private:
   void OnNewReleaseInfoRequested(wxCommandEvent &event);
   void OnNewReleaseDownload(wxCommandEvent &event);
 
+  /**
+   * If the organ settings are modified then asks whether to save them and saves
+   * @return false if the user has cancelled or saving has failed
+   */
+  bool SaveModifiedOrgan(bool isForce);
   bool CloseOrgan(bool isForce = false);
   bool CloseProgram(bool isForce = false);
   void Open(const GOOrgan &organ);
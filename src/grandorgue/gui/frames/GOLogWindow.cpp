@@ -1,24 +1,70 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
 
 #include "GOLogWindow.h"
 
-#include <wx/app.h>
+#include <algorithm>
+
 #include <wx/artprov.h>
+#include <wx/choice.h>
 #include <wx/clipbrd.h>
 #include <wx/dataobj.h>
 #include <wx/imaglist.h>
 #include <wx/listctrl.h>
 #include <wx/menu.h>
+#include <wx/sizer.h>
+#include <wx/stattext.h>
+
+#include "threading/GOMutexLocker.h"
 
 DEFINE_LOCAL_EVENT_TYPE(wxEVT_ADD_LOG_MESSAGE)
 
+#define GO_LOG_FLUSH_TIMER_ID (9998)
+#define GO_LOG_LEVEL_CHOICE_ID (9997)
+
+static const int IMG_SIZE = 16;
+static const int MIN_MESSAGE_WIDTH = 300;
+
+/**
+ * The virtual list showing the entries of the window. It asks the window only
+ * for the rows that are visible
+ */
+class GOLogWindow::LogList : public wxListCtrl {
+private:
+  const GOLogWindow &r_window;
+
+protected:
+  wxString OnGetItemText(long item, long column) const override {
+    const Entry &entry = r_window.GetRowEntry(item);
+
+    return column == 1 ? wxDateTime(entry.m_time).Format()
+                       : GetEntryText(entry);
+  }
+
+  int OnGetItemImage(long item) const override {
+    return r_window.GetRowEntry(item).m_level;
+  }
+
+public:
+  LogList(GOLogWindow &window)
+    : wxListCtrl(
+      &window,
+      wxID_ANY,
+      wxDefaultPosition,
+      wxDefaultSize,
+      wxBORDER_SIMPLE | wxLC_REPORT | wxLC_NO_HEADER | wxLC_SINGLE_SEL
+        | wxLC_VIRTUAL),
+      r_window(window) {}
+};
+
 BEGIN_EVENT_TABLE(GOLogWindow, wxFrame)
 EVT_COMMAND(0, wxEVT_ADD_LOG_MESSAGE, GOLogWindow::OnLog)
+EVT_TIMER(GO_LOG_FLUSH_TIMER_ID, GOLogWindow::OnFlushTimer)
+EVT_CHOICE(GO_LOG_LEVEL_CHOICE_ID, GOLogWindow::OnLevelChoice)
 EVT_CLOSE(GOLogWindow::OnCloseWindow)
 EVT_CONTEXT_MENU(GOLogWindow::OnPopup)
 EVT_MENU(wxID_COPY, GOLogWindow::OnCopy)
@@ -32,46 +78,88 @@ GOLogWindow::GOLogWindow(
   const wxPoint &pos,
   const wxSize &size,
   long style)
-  : wxFrame(parent, id, title, pos, size, style) {
-  m_List = new wxListCtrl(
-    this,
-    wxID_ANY,
-    wxDefaultPosition,
-    wxDefaultSize,
-    wxBORDER_SIMPLE | wxLC_REPORT | wxLC_NO_HEADER | wxLC_SINGLE_SEL);
+  : wxFrame(parent, id, title, pos, size, style),
+    m_FirstSeq(0),
+    m_MaxLevel(2),
+    m_FlushTimer(this, GO_LOG_FLUSH_TIMER_ID) {
+  wxBoxSizer *topSizer = new wxBoxSizer(wxVERTICAL);
+  wxBoxSizer *filterSizer = new wxBoxSizer(wxHORIZONTAL);
+  wxArrayString levels;
+
+  levels.Add(_("All messages"));
+  levels.Add(_("Warnings and errors"));
+  levels.Add(_("Errors only"));
+  m_LevelChoice = new wxChoice(
+    this, GO_LOG_LEVEL_CHOICE_ID, wxDefaultPosition, wxDefaultSize, levels);
+  m_LevelChoice->SetSelection(0);
+  filterSizer->Add(
+    new wxStaticText(this, wxID_ANY, _("Show:")),
+    0,
+    wxALIGN_CENTER_VERTICAL | wxRIGHT,
+    5);
+  filterSizer->Add(m_LevelChoice, 0, wxALIGN_CENTER_VERTICAL);
+  topSizer->Add(filterSizer, 0, wxALL, 5);
+
+  m_List = new LogList(*this);
   m_List->InsertColumn(0, wxT("Message"));
   m_List->InsertColumn(1, wxT("Time"));
+  topSizer->Add(m_List, 1, wxEXPAND);
 
-  const int img_size = 16;
-  wxImageList *imgs = new wxImageList(img_size, img_size);
+  wxImageList *imgs = new wxImageList(IMG_SIZE, IMG_SIZE);
   imgs->Add(wxArtProvider::GetBitmap(
-    wxART_ERROR, wxART_MESSAGE_BOX, wxSize(img_size, img_size)));
+    wxART_ERROR, wxART_MESSAGE_BOX, wxSize(IMG_SIZE, IMG_SIZE)));
   imgs->Add(wxArtProvider::GetBitmap(
-    wxART_WARNING, wxART_MESSAGE_BOX, wxSize(img_size, img_size)));
+    wxART_WARNING, wxART_MESSAGE_BOX, wxSize(IMG_SIZE, IMG_SIZE)));
   imgs->Add(wxArtProvider::GetBitmap(
-    wxART_INFORMATION, wxART_MESSAGE_BOX, wxSize(img_size, img_size)));
+    wxART_INFORMATION, wxART_MESSAGE_BOX, wxSize(IMG_SIZE, IMG_SIZE)));
   m_List->AssignImageList(imgs, wxIMAGE_LIST_SMALL);
 
-  m_List->SetColumnWidth(0, wxLIST_AUTOSIZE);
-  m_List->SetColumnWidth(1, wxLIST_AUTOSIZE);
+  // wxLIST_AUTOSIZE would measure the rows, so the widths are calculated
+  m_List->SetColumnWidth(0, MIN_MESSAGE_WIDTH);
+  m_List->SetColumnWidth(
+    1, m_List->GetTextExtent(wxDateTime::Now().Format()).x + IMG_SIZE);
+  SetSizer(topSizer);
+}
+
+GOLogWindow::~GOLogWindow() { m_FlushTimer.Stop(); }
+
+wxString GOLogWindow::GetEntryText(const Entry &entry) {
+  return entry.m_count > 1
+    ? wxString::Format(
+      _("%s (repeated %u times)"), entry.m_message, entry.m_count)
+    : entry.m_message;
+}
+
+const GOLogWindow::Entry &GOLogWindow::GetRowEntry(long row) const {
+  return m_entries[m_ShownSeqs[m_ShownSeqs.size() - 1 - row] - m_FirstSeq];
 }
 
-GOLogWindow::~GOLogWindow() {}
+void GOLogWindow::RebuildShownEntries() {
+  m_ShownSeqs.clear();
+  for (unsigned i = 0; i < m_entries.size(); i++)
+    if (m_entries[i].m_level <= m_MaxLevel)
+      m_ShownSeqs.push_back(m_FirstSeq + i);
+  m_List->SetItemCount(m_ShownSeqs.size());
+  m_List->Refresh();
+}
+
+void GOLogWindow::ClearEntries() {
+  m_entries.clear();
+  m_ShownSeqs.clear();
+  m_FirstSeq = 0;
+  m_List->SetItemCount(0);
+  m_List->Refresh();
+}
 
 void GOLogWindow::OnCopy(wxCommandEvent &event) {
   wxString text;
   for (long i = m_List->GetItemCount() - 1; i >= 0; i--) {
-    wxListItem i1, i2;
-    i1.SetId(i);
-    i1.SetColumn(1);
-    i2.SetId(i);
-    i2.SetColumn(0);
-    i1.SetMask(wxLIST_MASK_TEXT);
-    i2.SetMask(wxLIST_MASK_TEXT);
-    m_List->GetItem(i1);
-    m_List->GetItem(i2);
+    const Entry &entry = GetRowEntry(i);
+
     text += wxString::Format(
-      _("%s: %s\n"), i1.GetText().c_str(), i2.GetText().c_str());
+      _("%s: %s\n"),
+      wxDateTime(entry.m_time).Format(),
+      GetEntryText(entry));
   }
 
   if (wxTheClipboard->Open()) {
@@ -88,17 +176,55 @@ void GOLogWindow::OnPopup(wxContextMenuEvent &event) {
   PopupMenu(&popup);
 }
 
-void GOLogWindow::OnClear(wxCommandEvent &event) { m_List->DeleteAllItems(); }
+void GOLogWindow::OnClear(wxCommandEvent &event) { ClearEntries(); }
+
+void GOLogWindow::OnLevelChoice(wxCommandEvent &event) {
+  m_MaxLevel = 2 - m_LevelChoice->GetSelection();
+  RebuildShownEntries();
+}
 
 void GOLogWindow::OnLog(wxCommandEvent &event) {
-  wxDateTime time((time_t)event.GetTimestamp());
-  wxString timestr = time.Format();
+  // collect the messages arriving in a short time into one batch
+  if (!m_FlushTimer.IsRunning())
+    m_FlushTimer.StartOnce(FLUSH_INTERVAL);
+}
+
+void GOLogWindow::OnFlushTimer(wxTimerEvent &event) { FlushPending(); }
 
-  long line = m_List->InsertItem(0, event.GetString(), event.GetInt());
-  m_List->SetItem(line, 1, timestr);
+void GOLogWindow::FlushPending() {
+  std::deque<Entry> batch;
 
-  m_List->SetColumnWidth(0, wxLIST_AUTOSIZE);
-  m_List->SetColumnWidth(1, wxLIST_AUTOSIZE);
+  {
+    GOMutexLocker lock(m_PendingMutex);
+
+    batch.swap(m_PendingEntries);
+  }
+  if (batch.empty())
+    return;
+
+  int maxWidth = 0;
+
+  for (Entry &entry : batch) {
+    if (!m_entries.empty() && m_entries.back().IsSameAs(entry)) {
+      m_entries.back().Repeat(entry);
+      continue;
+    }
+    if (m_entries.size() >= MAX_ENTRIES) {
+      if (!m_ShownSeqs.empty() && m_ShownSeqs.front() == m_FirstSeq)
+        m_ShownSeqs.pop_front();
+      m_entries.pop_front();
+      m_FirstSeq++;
+    }
+    if (entry.m_level <= m_MaxLevel) {
+      m_ShownSeqs.push_back(m_FirstSeq + m_entries.size());
+      maxWidth = std::max(maxWidth, m_List->GetTextExtent(entry.m_message).x);
+    }
+    m_entries.push_back(std::move(entry));
+  }
+  m_List->SetItemCount(m_ShownSeqs.size());
+  m_List->Refresh();
+  if (maxWidth + 2 * IMG_SIZE > m_List->GetColumnWidth(0))
+    m_List->SetColumnWidth(0, maxWidth + 2 * IMG_SIZE);
 
   if (!IsShown())
     Show();
@@ -106,30 +232,43 @@ void GOLogWindow::OnLog(wxCommandEvent &event) {
 
 void GOLogWindow::OnCloseWindow(wxCloseEvent &event) {
   Show(false);
-  m_List->DeleteAllItems();
+  ClearEntries();
 }
 
 void GOLogWindow::LogMsg(
   wxLogLevel level, const wxString &msg, time_t timestamp) {
-  static unsigned count = 0;
-  int l;
+  Entry entry;
+  bool isFirstPending;
+
   switch (level) {
   case wxLOG_FatalError:
   case wxLOG_Error:
-    l = 0;
+    entry.m_level = 0;
     break;
   case wxLOG_Warning:
-    l = 1;
+    entry.m_level = 1;
     break;
   default:
-    l = 2;
+    entry.m_level = 2;
+  }
+  entry.m_message = msg;
+  entry.m_time = timestamp;
+  entry.m_count = 1;
+  {
+    GOMutexLocker lock(m_PendingMutex);
+
+    isFirstPending = m_PendingEntries.empty();
+    if (!isFirstPending && m_PendingEntries.back().IsSameAs(entry))
+      m_PendingEntries.back().Repeat(entry);
+    else {
+      if (m_PendingEntries.size() >= MAX_ENTRIES)
+        m_PendingEntries.pop_front();
+      m_PendingEntries.push_back(entry);
+    }
+  }
+  // one event is enough for the whole batch
+  if (isFirstPending) {
+    wxCommandEvent e(wxEVT_ADD_LOG_MESSAGE, 0);
+    GetEventHandler()->AddPendingEvent(e);
   }
-  wxCommandEvent e(wxEVT_ADD_LOG_MESSAGE, 0);
-  e.SetString(msg);
-  e.SetInt(l);
-  e.SetTimestamp(timestamp);
-  GetEventHandler()->AddPendingEvent(e);
-  count++;
-  if ((count % 100) == 0)
-    wxTheApp->Yield(true);
 }
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -8,18 +8,80 @@
 #ifndef GOLOGWINDOW_H
 #define GOLOGWINDOW_H
 
+#include <cstdint>
+#include <deque>
+
 #include <wx/frame.h>
 #include <wx/log.h>
+#include <wx/timer.h>
+
+#include "threading/GOMutex.h"
 
-class wxListCtrl;
+class wxChoice;
 
 DECLARE_LOCAL_EVENT_TYPE(wxEVT_ADD_LOG_MESSAGE, -1)
 
+/**
+ * Shows the log messages.
+ *
+ * LogMsg only appends the message to the pending batch. The batch is moved to
+ * the window at most once per FLUSH_INTERVAL, so the cost of logging does not
+ * depend on how many messages are already shown. The window keeps at most
+ * MAX_ENTRIES messages dropping the oldest ones. A message repeating the
+ * previous one is not added again but its counter is increased.
+ */
 class GOLogWindow : public wxFrame {
+public:
+  static constexpr unsigned MAX_ENTRIES = 10000;
+  // ms
+  static constexpr unsigned FLUSH_INTERVAL = 50;
+
 private:
-  wxListCtrl *m_List;
+  class LogList;
+
+  struct Entry {
+    // the image index: 0 - error, 1 - warning, 2 - info
+    int m_level;
+    wxString m_message;
+    // the time of the last repetition
+    time_t m_time;
+    unsigned m_count;
+
+    bool IsSameAs(const Entry &other) const {
+      return m_level == other.m_level && m_message == other.m_message;
+    }
+    void Repeat(const Entry &other) {
+      m_count += other.m_count;
+      m_time = other.m_time;
+    }
+  };
+
+  // the messages logged but not shown yet. Guarded by m_PendingMutex
+  GOMutex m_PendingMutex;
+  std::deque<Entry> m_PendingEntries;
+
+  std::deque<Entry> m_entries;
+  // the sequence number of m_entries.front()
+  uint64_t m_FirstSeq;
+  // the sequence numbers of the entries passing the level filter, ascending
+  std::deque<uint64_t> m_ShownSeqs;
+  // the maximal image index shown
+  int m_MaxLevel;
+
+  wxChoice *m_LevelChoice;
+  LogList *m_List;
+  wxTimer m_FlushTimer;
+
+  static wxString GetEntryText(const Entry &entry);
+  // the entry shown in the row. The newest entry is in the row 0
+  const Entry &GetRowEntry(long row) const;
+  void FlushPending();
+  void RebuildShownEntries();
+  void ClearEntries();
 
   void OnLog(wxCommandEvent &event);
+  void OnFlushTimer(wxTimerEvent &event);
+  void OnLevelChoice(wxCommandEvent &event);
   void OnCopy(wxCommandEvent &event);
   void OnClear(wxCommandEvent &event);
   void OnPopup(wxContextMenuEvent &event);
@@ -35,6 +97,7 @@ public:
     long style = wxDEFAULT_FRAME_STYLE);
   ~GOLogWindow();
 
+  // may be called from any thread
   void LogMsg(wxLogLevel level, const wxString &msg, time_t time);
 
   DECLARE_EVENT_TABLE()
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -114,6 +114,18 @@ GOGUIPanel *GOGUIRecorderPanel::CreateRecorderPanel(GOConfigReader &cfg) {
   button->Init(cfg, wxT("MidiPlayerPause"), 4, 102);
   panel->AddControl(button);
 
+  button = new GOGUIButton(
+    panel, m_OrganController->GetButtonControl(wxT("MidiPlayerRewind")), false);
+  button->Init(cfg, wxT("MidiPlayerRewind"), 2, 103);
+  panel->AddControl(button);
+
+  button = new GOGUIButton(
+    panel,
+    m_OrganController->GetButtonControl(wxT("MidiPlayerForward")),
+    false);
+  button->Init(cfg, wxT("MidiPlayerForward"), 3, 103);
+  panel->AddControl(button);
+
   label = new GOGUILabel(
     panel, m_OrganController->GetLabel(wxT("MidiPlayerLabel")));
   label->Init(cfg, wxT("MidiPlayerLabel"), 310, 185, wxT(""));
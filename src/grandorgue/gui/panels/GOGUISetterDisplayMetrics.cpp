@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2025 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -99,8 +99,8 @@ GOGUISetterDisplayMetrics::GOGUISetterDisplayMetrics(
 
   case GOGUI_RECORDER:
     x_size = 400;
-    y_size = 270;
-    drawstop_rows = 3;
+    y_size = 340;
+    drawstop_rows = 4;
     drawstop_cols = 5;
     button_cols = 10;
     button_rows = 0;
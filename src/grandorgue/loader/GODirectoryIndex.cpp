@@ -0,0 +1,114 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GODirectoryIndex.h"
+
+#include <filesystem>
+#include <system_error>
+
+#include <wx/filename.h>
+#include <wx/strconv.h>
+#include <wx/tokenzr.h>
+
+#include "threading/GOMutexLocker.h"
+
+void GODirectoryIndex::SetRoot(const wxString &root) {
+  GOMutexLocker locker(m_mutex);
+
+  m_root = root;
+  m_directories.clear();
+}
+
+GODirectoryIndex::Directory &GODirectoryIndex::GetDirectory(
+  const wxString &relPath) const {
+  auto found = m_directories.find(relPath);
+
+  if (found != m_directories.end())
+    return *found->second;
+
+  auto pDir = std::make_unique<Directory>();
+  const wxString fullPath = relPath.IsEmpty()
+    ? m_root
+    : m_root + wxFileName::GetPathSeparator() + relPath;
+  std::error_code ec;
+
+  // the entry types are usually known from the listing itself without stat()
+  for (std::filesystem::directory_iterator
+         it(std::filesystem::path(fullPath.fn_str().data()), ec),
+       end;
+       !ec && it != end;
+       it.increment(ec)) {
+    const wxString name(it->path().filename().c_str(), *wxConvFileName);
+    std::error_code typeEc;
+    const bool isDir = it->is_directory(typeEc);
+
+    pDir->m_entries[name] = isDir;
+    // keep the first name if several differ in case only
+    pDir->m_LowerNames.emplace(name.Lower(), name);
+  }
+
+  Directory &dir = *pDir;
+
+  m_directories[relPath] = std::move(pDir);
+  return dir;
+}
+
+wxString GODirectoryIndex::FindFile(
+  const wxString &relPath, std::vector<CaseMismatch> &newMismatches) const {
+  wxStringTokenizer tokenizer(relPath, wxT("/\\"), wxTOKEN_STRTOK);
+  wxString dirPath;
+  // the same path as requested
+  wxString requestedPath;
+  bool isDir = true;
+
+  GOMutexLocker locker(m_mutex);
+
+  while (tokenizer.HasMoreTokens()) {
+    const wxString component = tokenizer.GetNextToken();
+
+    if (component == wxT("."))
+      continue;
+    if (!isDir)
+      return wxEmptyString;
+    if (component == wxT("..")) {
+      // the path leaves the indexed tree, so check it as is
+      wxString fullPath = relPath;
+
+      fullPath.Replace(wxT("\\"), wxString(wxFileName::GetPathSeparator()));
+      if (!m_root.IsEmpty())
+        fullPath = m_root + wxFileName::GetPathSeparator() + fullPath;
+      return wxFileExists(fullPath) ? fullPath : wxString();
+    }
+
+    Directory &dir = GetDirectory(dirPath);
+    wxString name = component;
+    auto entry = dir.m_entries.find(name);
+    bool isNewMismatch = false;
+
+    if (entry == dir.m_entries.end()) {
+      auto lower = dir.m_LowerNames.find(component.Lower());
+
+      if (lower == dir.m_LowerNames.end())
+        return wxEmptyString;
+      name = lower->second;
+      entry = dir.m_entries.find(name);
+      isNewMismatch = dir.m_ReportedNames.insert(component).second;
+    }
+    isDir = entry->second;
+    if (!dirPath.IsEmpty()) {
+      dirPath += wxFileName::GetPathSeparator();
+      requestedPath += wxFileName::GetPathSeparator();
+    }
+    dirPath += name;
+    requestedPath += component;
+    if (isNewMismatch)
+      newMismatches.push_back({requestedPath, dirPath});
+  }
+  if (dirPath.IsEmpty() || isDir)
+    return wxEmptyString;
+  return m_root.IsEmpty() ? dirPath
+                          : m_root + wxFileName::GetPathSeparator() + dirPath;
+}
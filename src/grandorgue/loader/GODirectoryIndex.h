@@ -0,0 +1,84 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GODIRECTORYINDEX_H
+#define GODIRECTORYINDEX_H
+
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <wx/hashmap.h>
+#include <wx/string.h>
+
+#include "threading/GOMutex.h"
+
+/**
+ * An in-memory index of the files under a root directory.
+ *
+ * Each directory is listed once when a path inside it is looked up for the
+ * first time, so resolving the paths of thousands of samples takes one
+ * directory listing per directory instead of one stat() per file. The
+ * directories that are never referenced are not listed.
+ *
+ * A path component that does not exist with the exact case is matched ignoring
+ * the case, so the sample sets created on case insensitive file systems can be
+ * loaded on case sensitive ones. Each such component is reported only once.
+ *
+ * FindFile() may be called from several threads.
+ */
+class GODirectoryIndex {
+public:
+  struct CaseMismatch {
+    // the path up to the mismatched component as it was requested
+    wxString m_RequestedPath;
+    // the same path as it exists relative to the root
+    wxString m_ActualPath;
+  };
+
+private:
+  struct Directory {
+    // the entry names -> whether the entry is a directory
+    std::unordered_map<wxString, bool, wxStringHash, wxStringEqual> m_entries;
+    // the lower case entry names -> the entry names
+    std::unordered_map<wxString, wxString, wxStringHash, wxStringEqual>
+      m_LowerNames;
+    // the requested names that differ in case and have been reported
+    std::unordered_set<wxString, wxStringHash, wxStringEqual> m_ReportedNames;
+  };
+
+  wxString m_root;
+  mutable GOMutex m_mutex;
+  // the directories listed so far by their paths relative to m_root
+  mutable std::unordered_map<
+    wxString,
+    std::unique_ptr<Directory>,
+    wxStringHash,
+    wxStringEqual>
+    m_directories;
+
+  // returns the directory listing reading it if necessary. Must be called
+  // under m_mutex
+  Directory &GetDirectory(const wxString &relPath) const;
+
+public:
+  void SetRoot(const wxString &root);
+  const wxString &GetRoot() const { return m_root; }
+
+  /**
+   * Finds a file by its path relative to the root
+   * @param relPath the path. The components may be separated with '/' or '\'.
+   *   A path containing '..' is not resolved with the index but checked as is
+   * @param newMismatches the path components that differ in case and have not
+   *   been returned by the previous calls are appended here
+   * @return the full path of the file or an empty string if it is not found
+   */
+  wxString FindFile(
+    const wxString &relPath, std::vector<CaseMismatch> &newMismatches) const;
+};
+
+#endif /* GODIRECTORYINDEX_H */
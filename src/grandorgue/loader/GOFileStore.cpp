@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -15,6 +15,7 @@
 #include "config/GOConfig.h"
 
 #include "GOOrganList.h"
+#include "GOProgressMonitor.h"
 
 GOFileStore::GOFileStore(const GOConfig &config)
   : m_ResourceDirectory(config.GetResourceDirectory()) {}
@@ -23,6 +24,7 @@ void GOFileStore::SetDirectory(const wxString &directory) {
   // we do not support if both m_directory and m_archives are filled
   m_archives.clear();
   m_directory = directory;
+  m_DirectoryIndex.SetRoot(directory);
 }
 
 bool GOFileStore::LoadArchive(
@@ -96,3 +98,39 @@ void GOFileStore::CloseArchives() {
   for (auto a : m_archives)
     a->Close();
 }
+
+unsigned GOFileStore::VerifyArchives(GOProgressMonitor &monitor) {
+  // the progress is counted in megabytes for fitting in unsigned
+  constexpr unsigned UNIT_SHIFT = 20;
+  std::vector<GOArchive *> openedArchives;
+  uint64_t total = 0;
+
+  for (auto a : m_archives) {
+    // the archives are closed after loading the organ
+    const wxString path = a->GetPath();
+
+    if (a->OpenArchive(path)) {
+      openedArchives.push_back(a);
+      total += a->GetUncheckedLength();
+    }
+  }
+  monitor.Setup(
+    (long)(total >> UNIT_SHIFT), _("Verifying the organ packages"));
+
+  uint64_t done = 0;
+  unsigned nCorrupted = 0;
+  bool isCancelled = false;
+
+  for (auto a : openedArchives) {
+    const wxString &path = a->GetPath();
+
+    if (!isCancelled)
+      nCorrupted += a->VerifyContent([&](size_t len) {
+        done += len;
+        isCancelled = !monitor.Update((unsigned)(done >> UNIT_SHIFT), path);
+        return !isCancelled;
+      });
+    a->Close();
+  }
+  return nCorrupted;
+}
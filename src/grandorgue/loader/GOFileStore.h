@@ -12,8 +12,11 @@
 
 #include "ptrvector.h"
 
+#include "GODirectoryIndex.h"
+
 class GOArchive;
 class GOOrganList;
+class GOProgressMonitor;
 
 /**
  * This class represents a container that contains other files
@@ -27,6 +30,8 @@ private:
   wxString m_ResourceDirectory;
 
   wxString m_directory;
+  // resolves the file names relative to m_directory
+  GODirectoryIndex m_DirectoryIndex;
   ptr_vector<GOArchive> m_archives;
   bool LoadArchive(
     GOOrganList &organList,
@@ -42,6 +47,7 @@ public:
   const wxString &GetResourceDirectory() const { return m_ResourceDirectory; }
   const wxString &GetDirectory() const { return m_directory; }
   void SetDirectory(const wxString &directory);
+  const GODirectoryIndex &GetDirectoryIndex() const { return m_DirectoryIndex; }
   bool AreArchivesUsed() const { return m_archives.size() > 0; }
   const GOArchive *GetMainArchive() const {
     return AreArchivesUsed() ? m_archives[0] : nullptr;
@@ -74,6 +80,15 @@ public:
   GOArchive *FindArchiveContaining(const wxString fileName) const;
 
   void CloseArchives();
+
+  /**
+   * Reads all the content of the archives that has not been compared with the
+   * crc yet. The results are remembered in the archive indexes, so the
+   * content is not checked more
+   * @param monitor - shows the progress and allows to cancel the checking
+   * @return the number of corrupted files
+   */
+  unsigned VerifyArchives(GOProgressMonitor &monitor);
 };
 
 #endif /* GOFILESTORE_H */
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -17,6 +17,9 @@ bool GOLoadThread::CheckExceptions() {
 void GOLoadThread::Entry() {
   GOCacheObject *obj = nullptr;
 
-  while (!ShouldStop() && LoadNextObject(obj)) {
-  }
+  // each object must be loaded before the watchdog deadline
+  m_Heartbeat.Beat();
+  while (!ShouldStop() && LoadNextObject(obj))
+    m_Heartbeat.Beat();
+  m_Heartbeat.Idle();
 }
@@ -9,11 +9,14 @@
 #define GOLOADTHREAD_H
 
 #include "threading/GOThread.h"
+#include "threading/GOThreadWatchdog.h"
 
 #include "GOLoadWorker.h"
 
 class GOLoadThread : private GOLoadWorker, private GOThread {
 private:
+  GOThreadWatchdog::Heartbeat m_Heartbeat;
+
   /* the main loading loop. It takes objects from the m_CacheObjects
    * concurrently with other threads loads them
    */
@@ -24,7 +27,8 @@ public:
     const GOFileStore &fileStore,
     GOMemoryPool &pool,
     GOCacheObjectDistributor &distributor)
-    : GOLoadWorker(fileStore, pool, distributor) {}
+    : GOLoadWorker(fileStore, pool, distributor),
+      m_Heartbeat("GOLoadThread") {}
   ~GOLoadThread() { Stop(); }
 
   void Run() { Start(); }
@@ -45,12 +45,29 @@ std::unique_ptr<GOOpenedFile> GOLoaderFilename::Open(
       throw wxString::Format(
         _("File %s is not found in the organ package archives"), m_path);
     file = archive->OpenFile(m_path);
+  } else if (m_RootKind == ROOT_ODF) {
+    if (m_path.IsEmpty())
+      throw _("File name is empty");
+
+    std::vector<GODirectoryIndex::CaseMismatch> caseMismatches;
+    const wxString fullPath
+      = fileStore.GetDirectoryIndex().FindFile(m_path, caseMismatches);
+
+    // each mismatched component is reported once for all files under it
+    for (const auto &mismatch : caseMismatches)
+      wxLogWarning(
+        _("Path '%s' differs in case from '%s'"),
+        mismatch.m_RequestedPath,
+        mismatch.m_ActualPath);
+    if (fullPath.IsEmpty())
+      throw wxString::Format(
+        _("File '%s' does not exist"),
+        generateFullPath(m_path, fileStore.GetDirectory()));
+    file = new GOStandardFile(fullPath, m_path);
   } else {
     wxString baseDir;
 
-    if (m_RootKind == ROOT_ODF)
-      baseDir = fileStore.GetDirectory();
-    else if (m_RootKind == ROOT_RESOURCE)
+    if (m_RootKind == ROOT_RESOURCE)
       baseDir = fileStore.GetResourceDirectory();
 
     wxString fullPath = generateFullPath(m_path, baseDir);
@@ -1,48 +1,56 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
 
 #include "GOCache.h"
 
+#include <string.h>
+
+#include <algorithm>
+
 #include <wx/wfstream.h>
-#include <wx/zstream.h>
 
 #include "GOAlloc.h"
+#include "GOCacheRecord.h"
+#include "GOLzCodec.h"
 #include "GOMemoryPool.h"
 #include "go_defs.h"
 
+// the oldest cache version that can be read
+static constexpr uint32_t MIN_CACHE_VERSION = 1;
+
 GOCache::GOCache(wxFile &cache_file, GOMemoryPool &pool)
   : m_stream(0),
-    m_fstream(0),
-    m_zstream(0),
     m_pool(pool),
     m_Mapable(false),
-    m_OK(false) {
+    m_OK(false),
+    m_IsCompressed(false),
+    m_version(0),
+    m_FramePos(0) {
   int magic;
 
-  m_stream = m_fstream = new wxFileInputStream(cache_file);
+  m_stream = new wxFileInputStream(cache_file);
 
-  m_fstream->Read(&magic, sizeof(magic));
-  if (
-    m_fstream->LastRead() == sizeof(magic) && magic == GRANDORGUE_CACHE_MAGIC) {
-    m_Mapable = true;
-    m_OK = true;
-  } else {
-    m_fstream->SeekI(0, wxFromStart);
-    m_stream = m_zstream = new wxZlibInputStream(*m_fstream);
-    if (m_fstream->IsOk() && m_zstream->IsOk()) {
-      m_zstream->Read(&magic, sizeof(magic));
-      if (
-        m_zstream->LastRead() == sizeof(magic)
-        && magic == GRANDORGUE_CACHE_MAGIC) {
-        m_Mapable = false;
-        m_OK = true;
-      }
+  m_stream->Read(&magic, sizeof(magic));
+  if (m_stream->LastRead() == sizeof(magic)) {
+    if (magic == GRANDORGUE_CACHE_MAGIC) {
+      m_Mapable = true;
+      m_OK = true;
+    } else if (magic == GRANDORGUE_CACHE_LZ_MAGIC) {
+      m_IsCompressed = true;
+      m_OK = Read(&magic, sizeof(magic)) && magic == GRANDORGUE_CACHE_MAGIC;
     }
   }
+  if (m_OK) {
+    GOCacheRecord header;
+
+    m_OK = ReadRecord(header) && header.GetUInt(m_version)
+      && m_version >= MIN_CACHE_VERSION
+      && m_version <= GRANDORGUE_CACHE_VERSION;
+  }
 
   if (!m_OK || m_stream->TellI() == wxInvalidOffset)
     m_Mapable = false;
@@ -55,21 +63,91 @@ GOCache::~GOCache() { Close(); }
 bool GOCache::ReadHeader() { return m_OK; }
 
 void GOCache::Close() {
-  if (m_zstream)
-    delete m_zstream;
-  m_zstream = 0;
-  if (m_fstream)
-    delete m_fstream;
-  m_fstream = 0;
+  if (m_stream)
+    delete m_stream;
+  m_stream = 0;
+}
+
+bool GOCache::DecodeFrame(const GOCacheFrameHeader &header, uint8_t *dst) {
+  if (header.m_method == GOCacheFrameHeader::METHOD_STORED) {
+    if (header.m_StoredSize != header.m_RawSize)
+      return false;
+    m_stream->Read(dst, header.m_RawSize);
+    return m_stream->LastRead() == header.m_RawSize;
+  }
+  if (header.m_StoredSize > header.m_RawSize)
+    return false;
+  m_StoredData.resize(header.m_StoredSize);
+  m_stream->Read(m_StoredData.data(), header.m_StoredSize);
+  if (
+    m_stream->LastRead() != header.m_StoredSize
+    || !GOLzCodec::decompress(
+      m_StoredData.data(), header.m_StoredSize, dst, header.m_RawSize))
+    return false;
+  if (header.m_method == GOCacheFrameHeader::METHOD_DELTA_LZ) {
+    if (!header.m_stride)
+      return false;
+    GOLzCodec::decodeDelta(dst, header.m_RawSize, header.m_stride);
+  } else if (header.m_method != GOCacheFrameHeader::METHOD_LZ)
+    return false;
+  return true;
+}
+
+bool GOCache::ReadDecompressed(uint8_t *data, unsigned length) {
+  while (length) {
+    if (m_FramePos < m_frame.size()) {
+      const unsigned n
+        = std::min<unsigned>(length, m_frame.size() - m_FramePos);
+
+      memcpy(data, m_frame.data() + m_FramePos, n);
+      m_FramePos += n;
+      data += n;
+      length -= n;
+      continue;
+    }
+
+    GOCacheFrameHeader header;
+
+    m_stream->Read(&header, sizeof(header));
+    if (
+      m_stream->LastRead() != sizeof(header) || !header.m_RawSize
+      || header.m_RawSize > GOCacheFrameHeader::MAX_RAW_SIZE)
+      return false;
+    if (header.m_RawSize <= length) {
+      if (!DecodeFrame(header, data))
+        return false;
+      data += header.m_RawSize;
+      length -= header.m_RawSize;
+    } else {
+      m_frame.resize(header.m_RawSize);
+      m_FramePos = 0;
+      if (!DecodeFrame(header, m_frame.data())) {
+        m_frame.clear();
+        return false;
+      }
+    }
+  }
+  return true;
 }
 
 bool GOCache::Read(void *data, unsigned length) {
+  if (m_IsCompressed)
+    return ReadDecompressed((uint8_t *)data, length);
   m_stream->Read(data, length);
   if (m_stream->LastRead() != length)
     return false;
   return true;
 }
 
+bool GOCache::ReadRecord(GOCacheRecord &record) {
+  GOCacheRecord sizeRecord;
+  uint32_t size;
+
+  return Read(sizeRecord.PrepareForReading(4), 4) && sizeRecord.GetUInt(size)
+    && size <= GOCacheRecord::MAX_SIZE
+    && Read(record.PrepareForReading(size), size);
+}
+
 void GOCache::FreeCacheFile() {
   m_Mapable = false;
   m_pool.FreeCacheFile();
@@ -87,8 +165,7 @@ void *GOCache::ReadBlock(unsigned length) {
   if (data == NULL)
     throw GOOutOfMemory();
 
-  m_stream->Read(data, length);
-  if (m_stream->LastRead() != length) {
+  if (!Read(data, length)) {
     m_pool.Free(data);
     return NULL;
   }
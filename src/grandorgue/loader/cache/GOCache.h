@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -8,17 +8,36 @@
 #ifndef GOCACHE_H_
 #define GOCACHE_H_
 
+#include <cstdint>
+#include <vector>
+
+#include "GOCacheFrame.h"
+
+class GOCacheRecord;
 class GOMemoryPool;
 class wxFile;
 class wxInputStream;
 
 class GOCache {
   wxInputStream *m_stream;
-  wxInputStream *m_fstream;
-  wxInputStream *m_zstream;
   GOMemoryPool &m_pool;
   bool m_Mapable;
   bool m_OK;
+  bool m_IsCompressed;
+  // the GRANDORGUE_CACHE_VERSION the cache has been written with
+  uint32_t m_version;
+  // the decompressed frame and the position of the unread data in it
+  std::vector<uint8_t> m_frame;
+  unsigned m_FramePos;
+  std::vector<uint8_t> m_StoredData;
+
+  // Reads the data of the frame and decompresses it to dst
+  bool DecodeFrame(const GOCacheFrameHeader &header, uint8_t *dst);
+  /**
+   * Reads the data of a compressed cache. The frames fitting in the rest of
+   * the data are decompressed directly to it
+   */
+  bool ReadDecompressed(uint8_t *data, unsigned length);
 
 public:
   GOCache(wxFile &cache_file, GOMemoryPool &pool);
@@ -27,7 +46,12 @@ public:
   bool ReadHeader();
   void FreeCacheFile();
 
+  bool IsCompressed() const { return m_IsCompressed; }
+  uint32_t GetVersion() const { return m_version; }
+
   bool Read(void *data, unsigned length);
+  // Read a record written by WriteRecord
+  bool ReadRecord(GOCacheRecord &record);
   /* Allocate and read a block written by WriteBlock */
   void *ReadBlock(unsigned length);
 
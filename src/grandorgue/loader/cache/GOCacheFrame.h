@@ -0,0 +1,41 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOCACHEFRAME_H
+#define GOCACHEFRAME_H
+
+#include <cstdint>
+
+/**
+ * A compressed cache file starts with GRANDORGUE_CACHE_LZ_MAGIC followed by
+ * frames. Each frame is a GOCacheFrameHeader and the stored data. The frames
+ * are decompressed independently of each other, and their concatenated
+ * content is the same as the content of an uncompressed cache file.
+ *
+ * A big block written by GOCacheWriter::WriteBlock() always starts a new frame,
+ * so it may be decompressed directly to its memory.
+ */
+struct GOCacheFrameHeader {
+  enum Method : uint8_t {
+    // the data is stored as is
+    METHOD_STORED,
+    // the data is compressed with GOLzCodec
+    METHOD_LZ,
+    // the data is filtered with GOLzCodec::encodeDelta() and then compressed
+    METHOD_DELTA_LZ,
+  };
+
+  static constexpr unsigned MAX_RAW_SIZE = 256 * 1024;
+
+  uint32_t m_RawSize;
+  uint32_t m_StoredSize;
+  uint8_t m_method;
+  // the distance of the delta filter in bytes
+  uint8_t m_stride;
+  uint16_t m_reserved;
+};
+
+#endif /* GOCACHEFRAME_H */
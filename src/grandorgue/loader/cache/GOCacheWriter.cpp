@@ -1,52 +1,175 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
 
 #include "GOCacheWriter.h"
 
-#include <wx/zstream.h>
+#include <algorithm>
 
+#include <wx/stream.h>
+
+#include "GOCacheFrame.h"
+#include "GOCacheRecord.h"
+#include "GOLzCodec.h"
 #include "go_defs.h"
 
+// The compressed data is decompressed slower than the stored one is read, so
+// the compression is used only if it saves at least 1/LZ_MIN_GAIN of the size.
+// The delta filter slows down the decompression more
+static constexpr unsigned LZ_MIN_GAIN = 32;
+static constexpr unsigned FILTER_MIN_GAIN = 8;
+
 GOCacheWriter::GOCacheWriter(wxOutputStream &stream, bool compressed)
-  : m_zstream(0), m_stream(&stream) {
-  if (compressed) {
-    m_zstream = new wxZlibOutputStream(stream);
-    m_stream = m_zstream;
-  }
-}
+  : m_stream(&stream),
+    m_IsCompressed(compressed),
+    m_RawSize(0),
+    m_StoredSize(0) {}
 
 GOCacheWriter::~GOCacheWriter() { Close(); }
 
+bool GOCacheWriter::WriteToStream(const void *data, unsigned length) {
+  m_stream->Write(data, length);
+  m_StoredSize += length;
+  if (m_stream->LastWrite() != length)
+    return false;
+  return true;
+}
+
 bool GOCacheWriter::WriteHeader() {
+  if (m_IsCompressed) {
+    int lzMagic = GRANDORGUE_CACHE_LZ_MAGIC;
+
+    if (!WriteToStream(&lzMagic, sizeof(lzMagic)))
+      return false;
+  }
+
   int magic = GRANDORGUE_CACHE_MAGIC;
   if (!Write(&magic, sizeof(magic)))
     return false;
-  return true;
+
+  GOCacheRecord header;
+
+  header.PutUInt(GRANDORGUE_CACHE_VERSION);
+  return WriteRecord(header);
+}
+
+bool GOCacheWriter::WriteFrame(
+  const uint8_t *data, unsigned length, unsigned stride) {
+  GOCacheFrameHeader header;
+  const uint8_t *stored = data;
+
+  header.m_RawSize = length;
+  header.m_StoredSize = length;
+  header.m_method = GOCacheFrameHeader::METHOD_STORED;
+  header.m_stride = 0;
+  header.m_reserved = 0;
+  m_FrameData.resize(length);
+
+  const size_t lzSize = GOLzCodec::compress(
+    data, length, m_FrameData.data(), length - length / LZ_MIN_GAIN);
+
+  if (lzSize) {
+    header.m_StoredSize = lzSize;
+    header.m_method = GOCacheFrameHeader::METHOD_LZ;
+    stored = m_FrameData.data();
+  }
+  if (stride && stride <= UINT8_MAX && stride < length) {
+    m_FilteredData.assign(data, data + length);
+    GOLzCodec::encodeDelta(m_FilteredData.data(), length, stride);
+    m_FilteredFrame.resize(length);
+
+    const size_t filteredSize = GOLzCodec::compress(
+      m_FilteredData.data(),
+      length,
+      m_FilteredFrame.data(),
+      header.m_StoredSize - header.m_StoredSize / FILTER_MIN_GAIN);
+
+    if (filteredSize) {
+      header.m_StoredSize = filteredSize;
+      header.m_method = GOCacheFrameHeader::METHOD_DELTA_LZ;
+      header.m_stride = (uint8_t)stride;
+      stored = m_FilteredFrame.data();
+    }
+  }
+  return WriteToStream(&header, sizeof(header))
+    && WriteToStream(stored, header.m_StoredSize);
+}
+
+bool GOCacheWriter::FlushPending() {
+  bool isOk = true;
+
+  if (!m_pending.empty()) {
+    isOk = WriteFrame(m_pending.data(), m_pending.size(), 0);
+    m_pending.clear();
+  }
+  return isOk;
 }
 
 bool GOCacheWriter::Write(const void *data, unsigned length) {
-  m_stream->Write(data, length);
-  if (m_stream->LastWrite() != length)
-    return false;
+  m_RawSize += length;
+  if (!m_IsCompressed)
+    return WriteToStream(data, length);
+
+  const uint8_t *pos = (const uint8_t *)data;
+
+  while (length) {
+    const unsigned n = std::min<unsigned>(
+      length, GOCacheFrameHeader::MAX_RAW_SIZE - m_pending.size());
+
+    m_pending.insert(m_pending.end(), pos, pos + n);
+    pos += n;
+    length -= n;
+    if (m_pending.size() >= GOCacheFrameHeader::MAX_RAW_SIZE && !FlushPending())
+      return false;
+  }
   return true;
 }
 
-bool GOCacheWriter::WriteBlock(const void *data, unsigned length) {
-  m_stream->Write(data, length);
-  if (m_stream->LastWrite() != length)
+bool GOCacheWriter::WriteRecord(const GOCacheRecord &record) {
+  GOCacheRecord size;
+
+  size.PutUInt(record.GetSize());
+  return Write(size.GetData(), size.GetSize())
+    && Write(record.GetData(), record.GetSize());
+}
+
+bool GOCacheWriter::WriteBlock(
+  const void *data, unsigned length, unsigned stride) {
+  m_RawSize += length;
+  if (!m_IsCompressed)
+    return WriteToStream(data, length);
+  if (!FlushPending())
     return false;
+
+  const uint8_t *pos = (const uint8_t *)data;
+
+  // the frame size is a multiple of stride, so all frames are filtered alike
+  const unsigned maxFrameSize = stride
+    ? GOCacheFrameHeader::MAX_RAW_SIZE / stride * stride
+    : GOCacheFrameHeader::MAX_RAW_SIZE;
+
+  while (length) {
+    const unsigned n = std::min(length, maxFrameSize);
+
+    if (!WriteFrame(pos, n, stride))
+      return false;
+    pos += n;
+    length -= n;
+  }
   return true;
 }
 
-void GOCacheWriter::Close() {
-  if (m_stream)
-    m_stream->Close();
-  if (m_zstream)
-    delete m_zstream;
-  m_zstream = 0;
+bool GOCacheWriter::Close() {
+  bool isOk = true;
+
+  if (m_stream) {
+    if (m_IsCompressed)
+      isOk = FlushPending();
+    isOk = m_stream->Close() && isOk;
+  }
   m_stream = 0;
+  return isOk;
 }
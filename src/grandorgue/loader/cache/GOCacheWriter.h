@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -8,11 +8,36 @@
 #ifndef GOCACHEWRITER_H_
 #define GOCACHEWRITER_H_
 
+#include <cstdint>
+#include <vector>
+
+class GOCacheRecord;
 class wxOutputStream;
 
+/**
+ * Writes the cache file. If it is compressed then the data is split into
+ * frames described in GOCacheFrame.h
+ */
 class GOCacheWriter {
-  wxOutputStream *m_zstream;
   wxOutputStream *m_stream;
+  bool m_IsCompressed;
+  // the data written with Write() and not yet put into a frame
+  std::vector<uint8_t> m_pending;
+  // the buffers for compressing a frame
+  std::vector<uint8_t> m_FrameData;
+  std::vector<uint8_t> m_FilteredData;
+  std::vector<uint8_t> m_FilteredFrame;
+  // the total size of the data written and of the frames stored
+  uint64_t m_RawSize;
+  uint64_t m_StoredSize;
+
+  bool WriteToStream(const void *data, unsigned length);
+  /**
+   * Compresses the data to a frame with the best of the methods
+   * @param stride the delta filter distance. 0 - do not try the filter
+   */
+  bool WriteFrame(const uint8_t *data, unsigned length, unsigned stride);
+  bool FlushPending();
 
 public:
   GOCacheWriter(wxOutputStream &stream, bool compressed);
@@ -20,10 +45,20 @@ public:
 
   bool WriteHeader();
   bool Write(const void *data, unsigned length);
-  /* Write an bigger malloced block */
-  bool WriteBlock(const void *data, unsigned length);
+  // Write the record prefixed with its size
+  bool WriteRecord(const GOCacheRecord &record);
+  /**
+   * Write an bigger malloced block
+   * @param stride the size of a sample frame if the block contains PCM samples
+   *   or 0. The compressed cache may use it for filtering the data
+   */
+  bool WriteBlock(const void *data, unsigned length, unsigned stride = 0);
+
+  uint64_t GetRawSize() const { return m_RawSize; }
+  uint64_t GetStoredSize() const { return m_StoredSize; }
 
-  void Close();
+  // Returns false if the rest of the data could not be written
+  bool Close();
 };
 
 #endif
@@ -25,8 +25,13 @@ enum {
   ID_MIDI_PLAYER_PLAY = 0,
   ID_MIDI_PLAYER_STOP,
   ID_MIDI_PLAYER_PAUSE,
+  ID_MIDI_PLAYER_REWIND,
+  ID_MIDI_PLAYER_FORWARD,
 };
 
+// how far the rewind and forward buttons move the playing position
+static constexpr unsigned SEEK_STEP = 10; // seconds
+
 static const GOMidiObjectContext MIDI_CONTEXT(
   wxT("MidiPlayer"), _("MidiPlayer"));
 
@@ -49,6 +54,18 @@ const GOElementCreator::ButtonDefinitionEntry BUTTON_DEFS[] = {
    true,
    false,
    &MIDI_CONTEXT},
+  {wxT("MidiPlayerRewind"),
+   ID_MIDI_PLAYER_REWIND,
+   false,
+   true,
+   false,
+   &MIDI_CONTEXT},
+  {wxT("MidiPlayerForward"),
+   ID_MIDI_PLAYER_FORWARD,
+   false,
+   true,
+   false,
+   &MIDI_CONTEXT},
   {wxT(""), -1, false, false, false},
 };
 
@@ -81,6 +98,10 @@ void GOMidiPlayer::Load(GOConfigReader &cfg) {
   m_buttons[ID_MIDI_PLAYER_STOP]->Init(cfg, wxT("MidiPlayerStop"), _("STOP"));
   m_buttons[ID_MIDI_PLAYER_PAUSE]->Init(
     cfg, wxT("MidiPlayerPause"), _("PAUSE"));
+  m_buttons[ID_MIDI_PLAYER_REWIND]->Init(
+    cfg, wxT("MidiPlayerRewind"), _("<<"));
+  m_buttons[ID_MIDI_PLAYER_FORWARD]->Init(
+    cfg, wxT("MidiPlayerForward"), _(">>"));
   m_PlayingTime.Init(cfg, wxT("MidiPlayerTime"), _("MIDI playing time"));
 }
 
@@ -97,6 +118,14 @@ void GOMidiPlayer::ButtonStateChanged(int id, bool newState) {
   case ID_MIDI_PLAYER_PAUSE:
     Pause();
     break;
+
+  case ID_MIDI_PLAYER_REWIND:
+    Seek(m_PlayingSeconds > SEEK_STEP ? m_PlayingSeconds - SEEK_STEP : 0);
+    break;
+
+  case ID_MIDI_PLAYER_FORWARD:
+    Seek(m_IsPlaying ? m_PlayingSeconds + SEEK_STEP : SEEK_STEP);
+    break;
   }
 }
 
@@ -172,26 +201,65 @@ void GOMidiPlayer::PlayMidiEvent(const GOMidiEvent &e) {
     pMidi->PlayEvent(e);
 }
 
-void GOMidiPlayer::StopPlaying() {
-  if (m_IsPlaying) {
-    for (unsigned i = 1; i < 16; i++) {
-      GOMidiEvent e;
-      e.SetMidiType(GOMidiEvent::MIDI_CTRL_CHANGE);
-      e.SetChannel(i);
-      e.SetKey(MIDI_CTRL_NOTES_OFF);
-      e.SetValue(0);
-      e.SetDevice(m_DeviceID);
-      e.SetTime(wxGetLocalTimeMillis());
-      e.SetAllowedToReload(false);
-      PlayMidiEvent(e);
-    }
+void GOMidiPlayer::SendNotesOff() {
+  for (unsigned i = 1; i < 16; i++) {
+    GOMidiEvent e;
+    e.SetMidiType(GOMidiEvent::MIDI_CTRL_CHANGE);
+    e.SetChannel(i);
+    e.SetKey(MIDI_CTRL_NOTES_OFF);
+    e.SetValue(0);
+    e.SetDevice(m_DeviceID);
+    e.SetTime(wxGetLocalTimeMillis());
+    e.SetAllowedToReload(false);
+    PlayMidiEvent(e);
   }
+}
+
+void GOMidiPlayer::StopPlaying() {
+  if (m_IsPlaying)
+    SendNotesOff();
 
   m_IsPlaying = false;
   ResetUI();
   r_timer.DeleteTimer(this);
 }
 
+void GOMidiPlayer::Seek(unsigned seconds) {
+  if (!m_IsPlaying)
+    Play();
+  if (!m_IsPlaying)
+    return;
+
+  std::vector<GOMidiEvent> chased;
+  const bool hasMoreEvents = m_content.Seek(GOTime(seconds) * 1000, chased);
+
+  r_timer.DeleteTimer(this);
+  SendNotesOff();
+  // restore the state at the new position in one batch
+  for (GOMidiEvent &e : chased) {
+    e.SetDevice(m_DeviceID);
+    e.SetTime(wxGetLocalTimeMillis());
+    e.SetAllowedToReload(false);
+    PlayMidiEvent(e);
+  }
+  if (!hasMoreEvents) {
+    StopPlaying();
+    return;
+  }
+  m_PlayingSeconds = seconds;
+
+  const GOTime elapsed = m_Speed * seconds * 1000;
+
+  // while paused m_Start holds the elapsed time
+  if (m_Pause)
+    m_Start = elapsed;
+  else {
+    m_Start = wxGetLocalTimeMillis() - elapsed;
+    HandleTimer();
+  }
+  UpdateDisplay();
+}
+
 bool GOMidiPlayer::IsPlaying() { return m_IsPlaying; }
 
 void GOMidiPlayer::UpdateDisplay() {
@@ -54,6 +54,7 @@ private:
    * @param event the event to process
    */
   void PlayMidiEvent(const GOMidiEvent &e);
+  void SendNotesOff();
   void HandleTimer() override;
 
 public:
@@ -74,6 +75,14 @@ public:
   void StopPlaying();
   bool IsPlaying();
 
+  /**
+   * Continues playing from the position. The registration, the enclosures and
+   * the held notes at the position are restored first. Starts playing if it is
+   * not started yet
+   * @param seconds the position from the beginning of the file
+   */
+  void Seek(unsigned seconds);
+
   void Load(GOConfigReader &cfg) override;
   GOEnclosure *GetEnclosure(const wxString &name, bool is_panel) override;
   GOLabelControl *GetLabelControl(const wxString &name, bool is_panel) override;
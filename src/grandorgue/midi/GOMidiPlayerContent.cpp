@@ -7,6 +7,10 @@
 
 #include "GOMidiPlayerContent.h"
 
+#include <algorithm>
+#include <map>
+#include <tuple>
+
 #include "midi/events/GOMidiEvent.h"
 #include "midi/files/GOMidiFileReader.h"
 
@@ -28,21 +32,11 @@ bool GOMidiPlayerContent::IsLoaded() { return m_Events.size() > 0; }
 
 void GOMidiPlayerContent::ReadFileContent(
   GOMidiFileReader &reader, std::vector<GOMidiEvent> &events) {
-  unsigned pos = 0;
   GOMidiEvent e;
-  while (reader.ReadEvent(e)) {
-    while (pos > 0 && events[pos - 1].GetTime() > e.GetTime()) {
-      pos--;
-    }
-    while (pos < events.size() && events[pos].GetTime() < e.GetTime()) {
-      pos++;
-    }
-    if (pos <= events.size())
-      events.insert(events.begin() + pos, e);
-    else
-      events.push_back(e);
-    pos++;
-  }
+
+  // the reader merges the tracks itself, so the events come ordered by time
+  while (reader.ReadEvent(e))
+    events.push_back(e);
 }
 
 void GOMidiPlayerContent::SetupManual(
@@ -100,3 +94,65 @@ bool GOMidiPlayerContent::Next() {
   m_Pos++;
   return m_Pos < m_Events.size();
 }
+
+bool GOMidiPlayerContent::Seek(GOTime time, std::vector<GOMidiEvent> &chased) {
+  using ChaseKey = std::tuple<int, int, int>;
+
+  const auto target = std::lower_bound(
+    m_Events.begin(),
+    m_Events.end(),
+    time,
+    [](const GOMidiEvent &e, GOTime t) { return e.GetTime() < t; });
+  // the indices of the events to replay. Only the last event for a key
+  std::map<ChaseKey, unsigned> lastEvents;
+  // the held notes by (channel, key)
+  std::map<std::pair<int, int>, unsigned> heldNotes;
+  // the events replayed always in order
+  std::vector<unsigned> indices;
+
+  m_Pos = target - m_Events.begin();
+  for (unsigned i = 0; i < m_Pos; i++) {
+    const GOMidiEvent &e = m_Events[i];
+    const GOMidiEvent::MidiType type = e.GetMidiType();
+
+    switch (type) {
+    case GOMidiEvent::MIDI_RESET:
+    case GOMidiEvent::MIDI_SYSEX_GO_CLEAR:
+    case GOMidiEvent::MIDI_SYSEX_GO_SETUP:
+      indices.push_back(i);
+      break;
+
+    case GOMidiEvent::MIDI_NOTE:
+      if (e.GetValue() > 0)
+        heldNotes[{e.GetChannel(), e.GetKey()}] = i;
+      else
+        heldNotes.erase({e.GetChannel(), e.GetKey()});
+      break;
+
+    case GOMidiEvent::MIDI_CTRL_CHANGE:
+      if (
+        e.GetKey() == MIDI_CTRL_NOTES_OFF
+        || e.GetKey() == MIDI_CTRL_SOUNDS_OFF) {
+        const int channel = e.GetChannel();
+
+        std::erase_if(heldNotes, [channel](const auto &entry) {
+          return entry.first.first == channel;
+        });
+      }
+      [[fallthrough]];
+
+    default:
+      lastEvents[{type, e.GetChannel(), e.GetKey()}] = i;
+    }
+  }
+  for (const auto &entry : lastEvents)
+    indices.push_back(entry.second);
+  for (const auto &entry : heldNotes)
+    indices.push_back(entry.second);
+  // replay in the original order
+  std::sort(indices.begin(), indices.end());
+  chased.clear();
+  for (unsigned i : indices)
+    chased.push_back(m_Events[i]);
+  return m_Pos < m_Events.size();
+}
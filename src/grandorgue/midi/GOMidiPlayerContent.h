@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -12,6 +12,8 @@
 
 #include <vector>
 
+#include "GOTime.h"
+
 class GOMidiEvent;
 class GOMidiMap;
 class GOMidiFileReader;
@@ -21,7 +23,7 @@ private:
   std::vector<GOMidiEvent> m_Events;
   unsigned m_Pos;
 
-  void ReadFileContent(
+  static void ReadFileContent(
     GOMidiFileReader &reader, std::vector<GOMidiEvent> &events);
   void SetupManual(GOMidiMap &map, unsigned channel, wxString ID);
 
@@ -37,6 +39,14 @@ public:
 
   const GOMidiEvent &GetCurrentEvent();
   bool Next();
+
+  /**
+   * Moves the current position to the first event not earlier than time.
+   * Fills chased with the events that restore the state at this position:
+   * the setup events, the last value of each control and the notes still held
+   * @return false if there are no events after time
+   */
+  bool Seek(GOTime time, std::vector<GOMidiEvent> &chased);
 };
 
 #endif
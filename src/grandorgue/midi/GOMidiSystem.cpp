@@ -14,6 +14,7 @@
 #include "midi/events/GOMidiWxEvent.h"
 #include "ports/GOMidiInPort.h"
 #include "ports/GOMidiOutPort.h"
+#include "sound/GOSoundLatencyProbe.h"
 
 BEGIN_EVENT_TABLE(GOMidiSystem, wxEvtHandler)
 EVT_MIDI(GOMidiSystem::OnMidiEvent)
@@ -89,7 +90,15 @@ bool GOMidiSystem::HasActiveDevice() {
   return false;
 }
 
+static bool is_probed_note(const GOMidiEvent &e) {
+  return GOSoundLatencyProbe::getInstance().IsStarted()
+    && e.GetMidiType() == GOMidiEvent::MIDI_NOTE && e.GetValue() > 0;
+}
+
 void GOMidiSystem::Recv(const GOMidiEvent &e) {
+  if (is_probed_note(e))
+    GOSoundLatencyProbe::getInstance().OnNoteReceived();
+
   GOMidiWxEvent event(e);
   AddPendingEvent(event);
 }
@@ -101,7 +110,14 @@ void GOMidiSystem::PlayEvent(const GOMidiEvent &e) {
 }
 
 void GOMidiSystem::OnMidiEvent(GOMidiWxEvent &e) {
-  PlayEvent(e.GetMidiEvent());
+  const GOMidiEvent &midiEvent = e.GetMidiEvent();
+  const bool isProbed = is_probed_note(midiEvent);
+
+  if (isProbed)
+    GOSoundLatencyProbe::getInstance().OnEventDispatched();
+  PlayEvent(midiEvent);
+  if (isProbed)
+    GOSoundLatencyProbe::getInstance().LogReportIfDue();
 }
 
 void GOMidiSystem::Send(const GOMidiEvent &e) {
@@ -1,38 +1,39 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2025 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
 
 #include "GOMidiFileReader.h"
 
+#include <algorithm>
+
 #include <wx/file.h>
 #include <wx/intl.h>
 #include <wx/log.h>
 
-#include "midi/events/GOMidiEvent.h"
-
 #include "GOMidiFile.h"
 
 GOMidiFileReader::GOMidiFileReader(GOMidiMap &map)
   : m_Map(map),
     m_Data(),
-    m_Tracks(0),
-    m_Speed(0),
-    m_Pos(0),
-    m_TrackEnd(0),
-    m_IsFirstTrackComplete(false),
-    m_LastStatus(0),
-    m_CurrentSpeed(0),
-    m_CurrentSpeedTo(-1),
-    m_LastTime(0),
-    m_PPQ(0) {}
+    m_PPQ(0),
+    m_TempoMap(),
+    m_tracks(),
+    m_heap(),
+    m_IsGarbageFound(false),
+    m_IsDecodingFailed(false) {}
 
 GOMidiFileReader::~GOMidiFileReader() { m_Data.free(); }
 
 bool GOMidiFileReader::Open(wxString filename) {
   m_Data.free();
+  m_tracks.clear();
+  m_heap.clear();
+  m_TempoMap.clear();
+  m_IsGarbageFound = false;
+  m_IsDecodingFailed = false;
 
   wxFile file;
   if (!file.Open(filename, wxFile::read)) {
@@ -54,8 +55,6 @@ bool GOMidiFileReader::Open(wxString filename) {
     wxLogError(_("MIDI header missing"));
     return false;
   }
-  m_Pos = sizeof(MIDIHeaderChunk);
-  m_TrackEnd = 0;
   MIDIHeaderChunk *h = (MIDIHeaderChunk *)m_Data.get();
   if (
     memcmp(h->header.type, "MThd", sizeof(h->header.type))
@@ -63,17 +62,17 @@ bool GOMidiFileReader::Open(wxString filename) {
     wxLogError(_("Malformed MIDI header"));
     return false;
   }
-  m_Tracks = h->tracks;
+  unsigned tracks = h->tracks;
   switch (h->type) {
   case 0:
-    if (m_Tracks != 1) {
+    if (tracks != 1) {
       wxLogError(_("MIDI file type 0 only supports one track"));
       return false;
     }
     break;
 
   case 1:
-    if (m_Tracks < 1) {
+    if (tracks < 1) {
       wxLogError(_("MIDI file type 1 has not tracks"));
       return false;
     }
@@ -90,244 +89,342 @@ bool GOMidiFileReader::Open(wxString filename) {
 
   unsigned tempo = 0x7A120; // 120 BPM
   unsigned ppq = h->ppq;
+  float speed;
 
   if (ppq & 0x8000) {
     unsigned frames = 1 + ((-ppq >> 8) & 0x7F);
     unsigned res = ppq & 0xFF;
-    m_Speed = 1000.0 / frames / (res ? res : 1);
+    speed = 1000.0 / frames / (res ? res : 1);
     m_PPQ = 0;
   } else {
     m_PPQ = ppq;
-    m_Speed = tempo / 1000.0 / (m_PPQ ? m_PPQ : 1);
+    speed = tempo / 1000.0 / (m_PPQ ? m_PPQ : 1);
   }
-  m_TempoMap.clear();
+  if (!FindTracks(tracks))
+    return false;
+  BuildTempoMap(speed);
+
+  // prepare the merge: take the first event of each track
+  for (Track &track : m_tracks)
+    if (FetchEvent(track)) {
+      m_heap.push_back(track.m_index);
+      std::push_heap(
+        m_heap.begin(), m_heap.end(), [this](unsigned i1, unsigned i2) {
+          return IsLater(i1, i2);
+        });
+    }
   return true;
 }
 
-bool GOMidiFileReader::StartTrack() {
-  do {
-    if (m_Pos >= m_Data.GetCount())
-      return false;
-    if (m_Pos + sizeof(MIDIFileHeader) > m_Data.GetCount()) {
-      wxLogError(_("Incomplete chunk at offset %d"), m_Pos);
-      m_Pos += sizeof(MIDIFileHeader);
-      return false;
+void GOMidiFileReader::InitTrack(
+  Track &track, unsigned index, unsigned pos, unsigned end) {
+  track.m_index = index;
+  track.m_pos = pos;
+  track.m_end = end;
+  track.m_LastStatus = 0;
+  track.m_tick = 0;
+  track.m_TempoIndex = 0;
+  track.m_IsFinished = false;
+  track.m_EventTick = 0;
+}
+
+bool GOMidiFileReader::FindTracks(unsigned declaredTrackCount) {
+  const unsigned size = m_Data.GetCount();
+  unsigned pos = sizeof(MIDIHeaderChunk);
+
+  while (pos < size) {
+    if (pos + sizeof(MIDIFileHeader) > size) {
+      wxLogError(_("Incomplete chunk at offset %d"), pos);
+      m_IsGarbageFound = true;
+      break;
     }
-    MIDIFileHeader *h = (MIDIFileHeader *)&m_Data[m_Pos];
-    if (memcmp(h->type, "MTrk", sizeof(h->type))) {
-      wxLogError(_("Not recognized MIDI chunk at offset %d"), m_Pos);
-      m_Pos += sizeof(MIDIFileHeader) + h->len;
-      if (m_Pos >= m_Data.GetCount()) {
-        wxLogError(_("Incomplete chunk"));
-        return false;
-      }
-    } else {
-      m_TrackEnd = m_Pos + sizeof(MIDIFileHeader) + h->len;
-      if (m_Pos >= m_Data.GetCount()) {
-        wxLogError(_("Incomplete chunk"));
-        return false;
-      }
-      if (!m_Tracks)
-        wxLogError(_("Incorrect track count"));
-      else
-        m_Tracks--;
-      m_Pos += sizeof(MIDIFileHeader);
-      m_LastStatus = 0;
-      m_LastTime = 0;
-      m_CurrentSpeed = m_Speed;
-      m_CurrentSpeedTo = -1;
-      if (m_IsFirstTrackComplete) {
-        // find the first tempo change from the tempo map
-        auto mapIter = m_TempoMap.lower_bound(0);
-
-        if (mapIter != m_TempoMap.end())
-          m_CurrentSpeedTo = mapIter->first;
-      }
-      return true;
+
+    MIDIFileHeader *h = (MIDIFileHeader *)&m_Data[pos];
+    const unsigned start = pos + sizeof(MIDIFileHeader);
+    unsigned end = start + h->len;
+
+    if (end > size || end < start) {
+      wxLogError(_("Incomplete chunk"));
+      m_IsDecodingFailed = true;
+      end = size;
+    }
+    if (memcmp(h->type, "MTrk", sizeof(h->type)))
+      wxLogError(_("Not recognized MIDI chunk at offset %d"), pos);
+    else {
+      m_tracks.emplace_back();
+      InitTrack(m_tracks.back(), m_tracks.size() - 1, start, end);
     }
-  } while (true);
+    pos = end;
+  }
+  if (m_tracks.size() < declaredTrackCount)
+    wxLogError(_("Some tracks are missing"));
+  else if (m_tracks.size() > declaredTrackCount)
+    wxLogError(_("Incorrect track count"));
+  return !m_tracks.empty();
 }
 
-unsigned GOMidiFileReader::DecodeTime() {
-  unsigned time = 0;
-  if (m_Pos >= m_TrackEnd) {
-    wxLogError(_("Incomplete timestamp at offset %d"), m_Pos);
-    return 0;
+bool GOMidiFileReader::DecodeTime(Track &track, unsigned &time) {
+  time = 0;
+  if (track.m_pos >= track.m_end) {
+    wxLogError(_("Incomplete timestamp at offset %d"), track.m_pos);
+    return false;
   }
-  uint8_t c = m_Data[m_Pos++];
+  uint8_t c = m_Data[track.m_pos++];
   while ((c & 0x80)) {
     time = (time << 7) | (c & 0x7F);
-    if (m_Pos >= m_TrackEnd) {
-      wxLogError(_("Incomplete timestamp at offset %d"), m_Pos);
-      return 0;
+    if (track.m_pos >= track.m_end) {
+      wxLogError(_("Incomplete timestamp at offset %d"), track.m_pos);
+      return false;
     }
-    c = m_Data[m_Pos++];
+    c = m_Data[track.m_pos++];
   }
   time = (time << 7) | (c & 0x7F);
-  return time;
+  return true;
 }
 
-bool GOMidiFileReader::ReadEvent(GOMidiEvent &e) {
-  do {
-    std::vector<unsigned char> msg;
-    if (m_Pos >= m_Data.GetCount())
-      return false;
-    if (m_TrackEnd && m_Pos >= m_TrackEnd) {
-      wxLogError(_("End of track marker missing at offset %d"), m_Pos);
-      m_Pos = m_TrackEnd;
-      m_TrackEnd = 0;
-      m_IsFirstTrackComplete = true;
-    }
-    if (!m_TrackEnd)
-      if (!StartTrack())
-        return false;
-    unsigned rel_time = DecodeTime();
-    if (m_Pos >= m_TrackEnd)
-      return false;
-    unsigned len;
-    if (m_Data[m_Pos] & 0x80) {
-      msg.push_back(m_Data[m_Pos]);
-      m_Pos++;
-    } else if (m_LastStatus)
-      msg.push_back(m_LastStatus);
-    else {
-      wxLogError(_("Status byte missing at offset %d"), m_Pos);
-      return false;
-    }
-    m_LastStatus = 0;
-    switch (msg[0] & 0xF0) {
-    case 0x80:
-    case 0x90:
-    case 0xA0:
-    case 0xB0:
-    case 0xE0:
-      m_LastStatus = msg[0];
-      len = 2;
+bool GOMidiFileReader::ReadMessage(
+  Track &track, std::vector<unsigned char> &msg) {
+  msg.clear();
+  if (track.m_pos >= track.m_end) {
+    wxLogError(_("End of track marker missing at offset %d"), track.m_pos);
+    return false;
+  }
+
+  unsigned rel_time;
+
+  if (!DecodeTime(track, rel_time) || track.m_pos >= track.m_end) {
+    m_IsDecodingFailed = true;
+    return false;
+  }
+
+  unsigned len;
+  if (m_Data[track.m_pos] & 0x80) {
+    msg.push_back(m_Data[track.m_pos]);
+    track.m_pos++;
+  } else if (track.m_LastStatus)
+    msg.push_back(track.m_LastStatus);
+  else {
+    wxLogError(_("Status byte missing at offset %d"), track.m_pos);
+    m_IsDecodingFailed = true;
+    return false;
+  }
+  track.m_LastStatus = 0;
+  switch (msg[0] & 0xF0) {
+  case 0x80:
+  case 0x90:
+  case 0xA0:
+  case 0xB0:
+  case 0xE0:
+    track.m_LastStatus = msg[0];
+    len = 2;
+    break;
+
+  case 0xC0:
+  case 0xD0:
+    track.m_LastStatus = msg[0];
+    len = 1;
+    break;
+
+  case 0xF0:
+    switch (msg[0]) {
+    case 0xF6:
+    case 0xF8:
+    case 0xF9:
+    case 0xFA:
+    case 0xFB:
+    case 0xFC:
+    case 0xFE:
+      len = 0;
       break;
 
-    case 0xC0:
-    case 0xD0:
-      m_LastStatus = msg[0];
+    case 0xF1:
+    case 0xF3:
       len = 1;
       break;
+    case 0xF2:
+      len = 2;
+      break;
 
     case 0xF0:
-      switch (msg[0]) {
-      case 0xF6:
-      case 0xF8:
-      case 0xF9:
-      case 0xFA:
-      case 0xFB:
-      case 0xFC:
-      case 0xFE:
-        len = 0;
-        break;
-
-      case 0xF1:
-      case 0xF3:
-        len = 1;
-        break;
-      case 0xF2:
-        len = 2;
-        break;
-
-      case 0xF0:
-      case 0xF7:
-        if (m_Pos + 1 > m_TrackEnd) {
-          wxLogError(_("Incomplete MIDI message at %d"), m_Pos - 1);
-          return false;
-        }
-        len = m_Data[m_Pos];
-        m_Pos += 1;
-        break;
-
-      case 0xFF:
-        if (m_Pos + 2 > m_TrackEnd) {
-          wxLogError(_("Incomplete MIDI message at %d"), m_Pos - 1);
-          return false;
-        }
-        msg.push_back(m_Data[m_Pos]);
-        msg.push_back(m_Data[m_Pos + 1]);
-        len = m_Data[m_Pos + 1];
-        m_Pos += 2;
-        break;
-
-      default:
-        wxLogError(_("Unknown MIDI message %02X at %d"), msg[0], m_Pos - 1);
+    case 0xF7:
+      if (track.m_pos + 1 > track.m_end) {
+        wxLogError(_("Incomplete MIDI message at %d"), track.m_pos - 1);
+        m_IsDecodingFailed = true;
+        return false;
+      }
+      len = m_Data[track.m_pos];
+      track.m_pos += 1;
+      break;
+
+    case 0xFF:
+      if (track.m_pos + 2 > track.m_end) {
+        wxLogError(_("Incomplete MIDI message at %d"), track.m_pos - 1);
+        m_IsDecodingFailed = true;
         return false;
       }
+      msg.push_back(m_Data[track.m_pos]);
+      msg.push_back(m_Data[track.m_pos + 1]);
+      len = m_Data[track.m_pos + 1];
+      track.m_pos += 2;
       break;
 
     default:
-      wxLogError(_("Unknown MIDI message %02X at %d"), msg[0], m_Pos - 1);
-      return false;
-    }
-    if (m_Pos + len > m_TrackEnd) {
-      wxLogError(_("Incomplete MIDI message at %d"), m_Pos - msg.size());
+      wxLogError(
+        _("Unknown MIDI message %02X at %d"), msg[0], track.m_pos - 1);
+      m_IsDecodingFailed = true;
       return false;
     }
-    for (unsigned i = 0; i < len; i++)
-      msg.push_back(m_Data[m_Pos++]);
-    m_LastTime += rel_time * m_CurrentSpeed;
-
-    if (msg[0] == 0xFF && msg[1] == 0x2F && msg[2] == 0x00) {
-      if (m_Pos != m_TrackEnd)
-        wxLogError(_("Events after end of track marker at %d"), m_Pos);
-
-      m_Pos = m_TrackEnd;
-      m_TrackEnd = 0;
-      m_IsFirstTrackComplete = true;
-      continue;
-    }
+    break;
+
+  default:
+    wxLogError(_("Unknown MIDI message %02X at %d"), msg[0], track.m_pos - 1);
+    m_IsDecodingFailed = true;
+    return false;
+  }
+  if (track.m_pos + len > track.m_end) {
+    wxLogError(_("Incomplete MIDI message at %d"), track.m_pos - msg.size());
+    m_IsDecodingFailed = true;
+    return false;
+  }
+  for (unsigned i = 0; i < len; i++)
+    msg.push_back(m_Data[track.m_pos++]);
+  track.m_tick += rel_time;
+
+  if (msg[0] == 0xFF && msg[1] == 0x2F && msg[2] == 0x00) {
+    if (track.m_pos != track.m_end)
+      wxLogError(_("Events after end of track marker at %d"), track.m_pos);
+    track.m_pos = track.m_end;
+    return false;
+  }
+  return true;
+}
 
-    // Look up the tempo map: should we change the tempo?
-    if (
-      m_IsFirstTrackComplete && m_CurrentSpeedTo >= 0
-      && m_LastTime >= m_CurrentSpeedTo) {
-      // inherit tempo changes from the first track
-      // find the next tempo from m_TempoMap
-      auto mapIter = m_TempoMap.lower_bound(m_CurrentSpeedTo);
-
-      assert(mapIter != m_TempoMap.end()); // due the rule for m_CurrentSpeedTo
-      if (mapIter->first > m_LastTime)     // not yet
-        mapIter--;
-
-      // now mapIter points to the greatest entry <= m_LastTime
-      m_CurrentSpeed = mapIter->second;
-      mapIter++; // to the next tempo change
-      m_CurrentSpeedTo = mapIter != m_TempoMap.end() ? mapIter->first : -1;
+static bool is_tempo_change(const std::vector<unsigned char> &msg) {
+  return msg.size() == 6 && msg[0] == 0xFF && msg[1] == 0x51 && msg[2] == 0x03;
+}
+
+/*
+ * The tempo changes are global for the file, so they are collected from all
+ * tracks before any event is read
+ */
+void GOMidiFileReader::BuildTempoMap(float initialSpeed) {
+  m_TempoMap.clear();
+  m_TempoMap.push_back({0, 0, initialSpeed});
+  // with the SMPTE time division the time does not depend on the tempo
+  if (!m_PPQ)
+    return;
+
+  std::vector<std::pair<uint64_t, unsigned>> changes;
+  std::vector<unsigned char> msg;
+
+  {
+    // the errors will be reported when the events are read
+    wxLogNull noLog;
+    const bool wasDecodingFailed = m_IsDecodingFailed;
+
+    for (const Track &origTrack : m_tracks) {
+      Track track = origTrack;
+
+      while (ReadMessage(track, msg))
+        if (is_tempo_change(msg))
+          changes.emplace_back(
+            track.m_tick, (msg[3] << 16) | (msg[4] << 8) | (msg[5]));
     }
+    m_IsDecodingFailed = wasDecodingFailed;
+  }
+  // at the same tick the change from the latter track wins
+  std::stable_sort(
+    changes.begin(), changes.end(), [](const auto &c1, const auto &c2) {
+      return c1.first < c2.first;
+    });
+  for (const auto &change : changes) {
+    const TempoChange &last = m_TempoMap.back();
+    const float speed = change.second / 1000.0 / m_PPQ;
+
+    if (change.first == last.m_tick)
+      m_TempoMap.back().m_speed = speed;
+    else
+      m_TempoMap.push_back(
+        {change.first,
+         last.m_time + (change.first - last.m_tick) * last.m_speed,
+         speed});
+  }
+}
+
+float GOMidiFileReader::GetTime(uint64_t tick) const {
+  auto next = std::upper_bound(
+    m_TempoMap.begin(),
+    m_TempoMap.end(),
+    tick,
+    [](uint64_t t, const TempoChange &change) { return t < change.m_tick; });
+  const TempoChange &change = *(next - 1);
 
-    // try to process tempo changes from the current track of the midi file
-    if (msg[0] == 0xFF && msg[1] == 0x51 && msg[2] == 0x03) {
-      unsigned tempo = (msg[3] << 16) | (msg[4] << 8) | (msg[5]);
+  return change.m_time + (tick - change.m_tick) * change.m_speed;
+}
+
+float GOMidiFileReader::GetTrackTime(Track &track) {
+  // the ticks of a track only grow, so the tempo map is walked forward
+  while (track.m_TempoIndex + 1 < m_TempoMap.size()
+         && m_TempoMap[track.m_TempoIndex + 1].m_tick <= track.m_tick)
+    track.m_TempoIndex++;
+
+  const TempoChange &change = m_TempoMap[track.m_TempoIndex];
 
-      m_CurrentSpeed = tempo / 1000.0 / (m_PPQ ? m_PPQ : 1);
+  return change.m_time + (track.m_tick - change.m_tick) * change.m_speed;
+}
 
-      if (!m_IsFirstTrackComplete) {
-        // fill out the tempo map
-        m_TempoMap[m_LastTime] = m_CurrentSpeed;
+bool GOMidiFileReader::FetchEvent(Track &track) {
+  std::vector<unsigned char> msg;
+
+  while (!track.m_IsFinished) {
+    if (!ReadMessage(track, msg))
+      track.m_IsFinished = true;
+    else if (!is_tempo_change(msg)) {
+      track.m_event.FromMidi(msg, m_Map);
+      if (track.m_event.GetMidiType() != GOMidiEvent::MIDI_NONE) {
+        track.m_EventTick = track.m_tick;
+        track.m_event.SetTime(GetTrackTime(track));
+        return true;
       }
-      continue;
     }
+  }
+  return false;
+}
 
-    e.FromMidi(msg, m_Map);
-    e.SetTime(m_LastTime);
-    if (e.GetMidiType() != GOMidiEvent::MIDI_NONE)
-      return true;
-  } while (true);
+bool GOMidiFileReader::IsLater(
+  unsigned trackIndex1, unsigned trackIndex2) const {
+  const Track &t1 = m_tracks[trackIndex1];
+  const Track &t2 = m_tracks[trackIndex2];
+
+  // the events of the same time keep the order of the tracks
+  return t1.m_EventTick > t2.m_EventTick
+    || (t1.m_EventTick == t2.m_EventTick && trackIndex1 > trackIndex2);
+}
+
+bool GOMidiFileReader::ReadEvent(GOMidiEvent &e) {
+  if (m_heap.empty())
+    return false;
+
+  auto isLater = [this](unsigned i1, unsigned i2) { return IsLater(i1, i2); };
+
+  std::pop_heap(m_heap.begin(), m_heap.end(), isLater);
+
+  Track &track = m_tracks[m_heap.back()];
+
+  e = track.m_event;
+  if (FetchEvent(track))
+    std::push_heap(m_heap.begin(), m_heap.end(), isLater);
+  else
+    m_heap.pop_back();
+  return true;
 }
 
 bool GOMidiFileReader::Close() {
-  if (m_Tracks)
-    wxLogError(_("Some tracks are missing"));
-  if (m_TrackEnd)
-    wxLogError(_("Last track is missing the end marker"));
-  if (m_Pos < m_TrackEnd) {
+  if (m_IsDecodingFailed) {
     wxLogError(_("Error decoding a track"));
     return false;
   }
-  if (m_Pos < m_Data.GetCount()) {
+  if (m_IsGarbageFound) {
     wxLogError(_("Garbage detected in the MIDI file"));
     return false;
   }
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -8,41 +8,86 @@
 #ifndef GOMIDIFILEREADER_H
 #define GOMIDIFILEREADER_H
 
-#include <map>
 #include <stdint.h>
 
+#include <vector>
+
 #include <wx/string.h>
 
+#include "midi/events/GOMidiEvent.h"
+
 #include "GOBuffer.h"
 
-class GOMidiEvent;
 class GOMidiMap;
 
+/**
+ * Reads the events of a MIDI file of type 0 or 1.
+ *
+ * Open() finds all tracks and builds the tempo map from the tempo changes of
+ * all tracks. ReadEvent() then merges the tracks: each track is a stream of
+ * events ordered by time, and the next event is taken from the track with the
+ * earliest one. So reading the whole file takes O(n log k) for n events in k
+ * tracks.
+ */
 class GOMidiFileReader {
+public:
+  struct TempoChange {
+    uint64_t m_tick;
+    // ms since the beginning of the file
+    float m_time;
+    // ms per tick since m_tick
+    float m_speed;
+  };
+
 private:
+  struct Track {
+    unsigned m_index;
+    unsigned m_pos;
+    unsigned m_end;
+    unsigned m_LastStatus;
+    uint64_t m_tick;
+    // the tempo change the time of m_tick is calculated from
+    unsigned m_TempoIndex;
+    bool m_IsFinished;
+    // the next event of the track and its tick
+    GOMidiEvent m_event;
+    uint64_t m_EventTick;
+  };
+
   GOMidiMap &m_Map;
   GOBuffer<uint8_t> m_Data;
-  unsigned m_Tracks;
-  float m_Speed; // the global speed from the file header
-  unsigned m_Pos;
-  unsigned m_TrackEnd;
-  bool m_IsFirstTrackComplete; // the first track has been read completely
-  unsigned m_LastStatus;
-  float m_CurrentSpeed; // the current speed for the current track
-  float m_CurrentSpeedTo;
-  float m_LastTime;
-  std::map<float, float>
-    m_TempoMap; // maps start time to the speed from the first track
   unsigned m_PPQ;
+  // starts with the initial tempo at the tick 0
+  std::vector<TempoChange> m_TempoMap;
+  std::vector<Track> m_tracks;
+  // the indices of the tracks having the next event. A min-heap by the time
+  std::vector<unsigned> m_heap;
+  bool m_IsGarbageFound;
+  bool m_IsDecodingFailed;
 
-  bool StartTrack();
-  unsigned DecodeTime();
+  void InitTrack(Track &track, unsigned index, unsigned pos, unsigned end);
+  bool FindTracks(unsigned declaredTrackCount);
+  bool DecodeTime(Track &track, unsigned &time);
+  /**
+   * Reads the next message of the track and advances the tick of the track
+   * @return false at the end of the track or if the track is malformed
+   */
+  bool ReadMessage(Track &track, std::vector<unsigned char> &msg);
+  void BuildTempoMap(float initialSpeed);
+  float GetTrackTime(Track &track);
+  // reads the next event of the track. Returns false if there is no more
+  bool FetchEvent(Track &track);
+  bool IsLater(unsigned trackIndex1, unsigned trackIndex2) const;
 
 public:
   GOMidiFileReader(GOMidiMap &map);
   ~GOMidiFileReader();
 
   bool Open(wxString filename);
+  const std::vector<TempoChange> &GetTempoMap() const { return m_TempoMap; }
+  // converts the tick to ms using the tempo map
+  float GetTime(uint64_t tick) const;
+  // returns the next event of all tracks in the order of time
   bool ReadEvent(GOMidiEvent &e);
   bool Close();
 };
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -88,3 +88,11 @@ bool GOCacheObject::LoadFromCacheWithoutExc(
   }
   return m_IsReady;
 }
+
+bool GOCacheObject::TakeDataFrom(GOCacheObject &donor) {
+  InitBeforeLoad();
+  m_IsReady = donor.m_IsReady && TakeData(donor);
+  if (m_IsReady)
+    donor.m_IsReady = false;
+  return m_IsReady;
+}
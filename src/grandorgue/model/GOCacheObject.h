@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -37,6 +37,17 @@ protected:
   virtual void Initialize() = 0;
   virtual void LoadData(const GOFileStore &fileStore, GOMemoryPool &pool) = 0;
   virtual bool LoadCache(GOMemoryPool &pool, GOCache &cache) = 0;
+  /**
+   * Takes the loaded data from the donor object of another organ instead of
+   * loading it. The donor has the same hash and is ready.
+   * Returns false if the object does not support it.
+   */
+  virtual bool TakeData(GOCacheObject &donor) { return false; }
+  /**
+   * Frees the description used only for loading the data. The object must
+   * still be able to calculate its hash after that.
+   */
+  virtual void ReleaseLoadInfo() {}
 
 public:
   virtual ~GOCacheObject() {}
@@ -68,6 +79,22 @@ public:
    */
   bool LoadFromCacheWithoutExc(GOMemoryPool &pool, GOCache &cache);
 
+  /**
+   * Take the loaded data from the object of another organ having the same hash
+   * and sharing the same memory pool. On success the donor becomes not ready.
+   * Returns whether the data has been taken.
+   */
+  bool TakeDataFrom(GOCacheObject &donor);
+
+  /**
+   * Called after the organ is loaded. If the object is ready then it does not
+   * need its load description any more, so it is released.
+   */
+  void FinishLoading() {
+    if (m_IsReady)
+      ReleaseLoadInfo();
+  }
+
   virtual bool SaveCache(GOCacheWriter &cache) const = 0;
   virtual void UpdateHash(GOHash &hash) const = 0;
   virtual const wxString &GetLoadTitle() const = 0;
@@ -48,6 +48,7 @@ GOOrganModel::GOOrganModel(GOConfig &config)
     m_CombinationsStoreNonDisplayedDrawstops(false),
     m_RootPipeConfigNode(nullptr, this, nullptr),
     m_OrganModelModified(false),
+    m_NUnreachableSamples(0),
     m_FirstManual(0),
     m_ODFManualCount(0),
     m_ODFRankCount(0) {
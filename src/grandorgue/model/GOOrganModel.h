@@ -8,6 +8,7 @@
 #ifndef GOORGANMODEL_H
 #define GOORGANMODEL_H
 
+#include <atomic>
 #include <set>
 
 #include "ptrvector.h"
@@ -58,6 +59,9 @@ private:
 
   bool m_OrganModelModified;
 
+  // the number of the sample files not loaded because they are never played
+  std::atomic_uint m_NUnreachableSamples;
+
   /**
    * Walks across all manuals with divisional coupler engaged and returns the
    *   set of manuals where the divisional with the same number should be pushed
@@ -138,6 +142,10 @@ public:
 
   GOPipeConfigNode &GetRootPipeConfigNode() { return m_RootPipeConfigNode; }
 
+  // Called by the pipes from the loader threads
+  void AddUnreachableSamples(unsigned n) { m_NUnreachableSamples += n; }
+  unsigned GetUnreachableSamples() const { return m_NUnreachableSamples; }
+
   bool IsOrganModelModified() const { return m_OrganModelModified; }
   void SetOrganModelModified(bool modified);
   void NotifyPipeConfigModified() override { SetOrganModelModified(true); }
@@ -7,6 +7,8 @@
 
 #include "GOSoundingPipe.h"
 
+#include <typeinfo>
+
 #include <wx/intl.h>
 #include <wx/log.h>
 
@@ -39,12 +41,12 @@ GOSoundingPipe::GOSoundingPipe(
     m_LastStart(0),
     m_LastStop(0),
     m_Instances(0),
-    m_AttackFileInfos(),
-    m_ReleaseFileInfos(),
-    m_Filename(),
     m_WindchestN(windchestN),
     m_AudioGroupID(0),
+    mp_LoadInfo(std::make_unique<LoadInfo>()),
+    m_LoadInfoHash(),
     m_TemperamentOffset(0),
+    m_LoadedReleaseTail(0),
     m_HarmonicNumber(harmonic_number),
     m_MinVolume(min_volume),
     m_MaxVolume(max_volume),
@@ -65,7 +67,7 @@ void GOSoundingPipe::Init(
   const wxString &filename) {
   SetGroupAndPrefix(group, prefix);
   p_OrganModel->RegisterCacheObject(this);
-  m_Filename = filename;
+  mp_LoadInfo->m_Filename = filename;
   m_PipeConfigNode.Init(cfg, group, prefix);
   m_OdfMidiKeyNumber = -1;
   m_OdfMidiPitchFraction = -1.0;
@@ -74,7 +76,7 @@ void GOSoundingPipe::Init(
 
   GOSoundProviderWave::AttackFileInfo ainfo;
 
-  ainfo.filename.AssignResource(m_Filename);
+  ainfo.filename.AssignResource(filename);
   ainfo.m_WaveTremulantStateFor = BOOL3_DEFAULT;
   ainfo.percussive = m_PipeConfigNode.GetEffectivePercussive();
   ainfo.load_release = !ainfo.percussive;
@@ -86,11 +88,11 @@ void GOSoundingPipe::Init(
   ainfo.release_end = -1;
   ainfo.m_LoopCrossfadeLength = 0;
   ainfo.m_ReleaseCrossfadeLength = 0;
-  m_AttackFileInfos.push_back(ainfo);
+  mp_LoadInfo->m_AttackFileInfos.push_back(ainfo);
 
   m_SoundProvider.SetVelocityParameter(m_MinVolume, m_MaxVolume);
   m_PipeConfigNode.SetName(
-    wxString::Format(_("%d: %s"), m_MidiKeyNumber, m_Filename.c_str()));
+    wxString::Format(_("%d: %s"), m_MidiKeyNumber, filename.c_str()));
 }
 
 void GOSoundingPipe::LoadAttackFileInfo(
@@ -174,7 +176,7 @@ void GOSoundingPipe::LoadAttackFileInfo(
                                      0)
                                                       : 0;
 
-  m_AttackFileInfos.push_back(ainfo);
+  mp_LoadInfo->m_AttackFileInfos.push_back(ainfo);
 }
 
 void GOSoundingPipe::LoadReleaseFileInfo(
@@ -210,14 +212,14 @@ void GOSoundingPipe::LoadReleaseFileInfo(
     3000,
     false,
     0);
-  m_ReleaseFileInfos.push_back(rinfo);
+  mp_LoadInfo->m_ReleaseFileInfos.push_back(rinfo);
 }
 
 void GOSoundingPipe::Load(
   GOConfigReader &cfg, const wxString &group, const wxString &prefix) {
   SetGroupAndPrefix(group, prefix);
   p_OrganModel->RegisterCacheObject(this);
-  m_Filename = cfg.ReadStringTrim(ODFSetting, group, prefix);
+  mp_LoadInfo->m_Filename = cfg.ReadStringTrim(ODFSetting, group, prefix);
   m_PipeConfigNode.Load(cfg, group, prefix);
   m_HarmonicNumber = cfg.ReadInteger(
     ODFSetting,
@@ -278,25 +280,33 @@ void GOSoundingPipe::Load(
   m_MaxVolume = cfg.ReadFloat(
     ODFSetting, group, wxT("MaxVelocityVolume"), 0, 1000, false, m_MaxVolume);
   m_SoundProvider.SetVelocityParameter(m_MinVolume, m_MaxVolume);
-  m_PipeConfigNode.SetName(
-    wxString::Format(_("%d: %s"), m_MidiKeyNumber, m_Filename.c_str()));
+  m_PipeConfigNode.SetName(wxString::Format(
+    _("%d: %s"), m_MidiKeyNumber, mp_LoadInfo->m_Filename.c_str()));
 }
 
 void GOSoundingPipe::LoadData(
   const GOFileStore &fileStore, GOMemoryPool &pool) {
+  if (!mp_LoadInfo)
+    throw wxString(_("The sample description has already been released"));
   try {
-    m_SoundProvider.LoadFromMultipleFiles(
+    const unsigned nUnreachable = m_SoundProvider.LoadFromMultipleFiles(
       fileStore,
       pool,
-      m_AttackFileInfos,
-      m_ReleaseFileInfos,
+      mp_LoadInfo->m_AttackFileInfos,
+      mp_LoadInfo->m_ReleaseFileInfos,
       m_PipeConfigNode.GetEffectiveBitsPerSample(),
       m_PipeConfigNode.GetEffectiveChannels(),
       m_PipeConfigNode.GetEffectiveCompress(),
       (GOSoundProviderWave::LoopLoadType)
         m_PipeConfigNode.GetEffectiveLoopLoad(),
       m_PipeConfigNode.GetEffectiveAttackLoad(),
-      m_PipeConfigNode.GetEffectiveReleaseLoad());
+      m_PipeConfigNode.GetEffectiveReleaseLoad(),
+      IsWaveTremulantUsed(),
+      GetLoadReleaseTail(),
+      p_OrganModel->GetConfig().MidSideCompression());
+
+    p_OrganModel->AddUnreachableSamples(nUnreachable);
+    SetLoadedReleaseTail(GetLoadReleaseTail());
     Validate();
   } catch (std::bad_alloc &ba) {
     m_SoundProvider.ClearData();
@@ -310,8 +320,11 @@ void GOSoundingPipe::LoadData(
 bool GOSoundingPipe::LoadCache(GOMemoryPool &pool, GOCache &cache) {
   try {
     bool result = m_SoundProvider.LoadCache(pool, cache);
-    if (result)
+    if (result) {
+      // the load release tail is a part of the cache hash
+      SetLoadedReleaseTail(GetLoadReleaseTail());
       Validate();
+    }
     return result;
   } catch (std::bad_alloc &ba) {
     m_SoundProvider.ClearData();
@@ -322,23 +335,30 @@ bool GOSoundingPipe::LoadCache(GOMemoryPool &pool, GOCache &cache) {
   }
 }
 
+bool GOSoundingPipe::TakeData(GOCacheObject &donor) {
+  // GOCacheObject is a private base, so dynamic_cast cannot be used
+  const bool isPipe = typeid(donor) == typeid(*this);
+
+  if (isPipe) {
+    GOSoundingPipe &donorPipe = static_cast<GOSoundingPipe &>(donor);
+
+    m_SoundProvider.TakeData(donorPipe.m_SoundProvider);
+    SetLoadedReleaseTail(donorPipe.m_LoadedReleaseTail);
+    Validate();
+  }
+  return isPipe;
+}
+
 bool GOSoundingPipe::SaveCache(GOCacheWriter &cache) const {
   return m_SoundProvider.SaveCache(cache);
 }
 
-void GOSoundingPipe::UpdateHash(GOHash &hash) const {
-  hash.Update(m_Filename);
-  hash.Update(m_PipeConfigNode.GetEffectiveBitsPerSample());
-  hash.Update(m_PipeConfigNode.GetEffectiveCompress());
-  hash.Update(m_PipeConfigNode.GetEffectiveChannels());
-  hash.Update(m_PipeConfigNode.GetEffectiveLoopLoad());
-  hash.Update(m_PipeConfigNode.GetEffectiveAttackLoad());
-  hash.Update(m_PipeConfigNode.GetEffectiveReleaseLoad());
-  hash.Update(m_OdfMidiKeyNumber);
-  hash.Update(m_PipeConfigNode.IsEffectiveIndependentRelease());
+GOHashType GOSoundingPipe::CalcLoadInfoHash() const {
+  GOHash hash;
 
-  hash.Update(m_AttackFileInfos.size());
-  for (const auto &a : m_AttackFileInfos) {
+  hash.Update(mp_LoadInfo->m_Filename);
+  hash.Update(mp_LoadInfo->m_AttackFileInfos.size());
+  for (const auto &a : mp_LoadInfo->m_AttackFileInfos) {
     a.filename.Hash(hash);
     hash.Update(a.m_WaveTremulantStateFor);
     hash.Update(a.max_playback_time);
@@ -356,8 +376,8 @@ void GOSoundingPipe::UpdateHash(GOHash &hash) const {
     hash.Update(a.m_ReleaseCrossfadeLength);
   }
 
-  hash.Update(m_ReleaseFileInfos.size());
-  for (const auto &r : m_ReleaseFileInfos) {
+  hash.Update(mp_LoadInfo->m_ReleaseFileInfos.size());
+  for (const auto &r : mp_LoadInfo->m_ReleaseFileInfos) {
     r.filename.Hash(hash);
     hash.Update(r.m_WaveTremulantStateFor);
     hash.Update(r.max_playback_time);
@@ -365,6 +385,43 @@ void GOSoundingPipe::UpdateHash(GOHash &hash) const {
     hash.Update(r.release_end);
     hash.Update(r.m_ReleaseCrossfadeLength);
   }
+  return hash.getHash();
+}
+
+void GOSoundingPipe::UpdateHash(GOHash &hash) const {
+  // the same value whether the load info is released or not
+  const GOHashType loadInfoHash
+    = mp_LoadInfo ? CalcLoadInfoHash() : m_LoadInfoHash;
+
+  hash.Update(&loadInfoHash, sizeof(loadInfoHash));
+  hash.Update(m_PipeConfigNode.GetEffectiveBitsPerSample());
+  hash.Update(m_PipeConfigNode.GetEffectiveCompress());
+  hash.Update(p_OrganModel->GetConfig().MidSideCompression());
+  hash.Update(m_PipeConfigNode.GetEffectiveChannels());
+  hash.Update(m_PipeConfigNode.GetEffectiveLoopLoad());
+  hash.Update(m_PipeConfigNode.GetEffectiveAttackLoad());
+  hash.Update(m_PipeConfigNode.GetEffectiveReleaseLoad());
+  hash.Update(GetLoadReleaseTail());
+  hash.Update(IsWaveTremulantUsed());
+  hash.Update(m_OdfMidiKeyNumber);
+  hash.Update(m_PipeConfigNode.IsEffectiveIndependentRelease());
+}
+
+void GOSoundingPipe::ReleaseLoadInfo() {
+  if (mp_LoadInfo) {
+    m_LoadInfoHash = CalcLoadInfoHash();
+    mp_LoadInfo.reset();
+  }
+}
+
+unsigned GOSoundingPipe::GetLoadReleaseTail() const {
+  return p_OrganModel->GetConfig().TruncateReleases()
+    ? m_PipeConfigNode.GetEffectiveReleaseTail()
+    : 0;
+}
+
+bool GOSoundingPipe::IsWaveTremulantUsed() const {
+  return p_OrganModel->GetWindchest(m_WindchestN - 1)->HasWaveTremulant();
 }
 
 float GOSoundingPipe::GetManualTuningPitchOffset() const {
@@ -542,8 +599,20 @@ void GOSoundingPipe::UpdateAudioGroup() {
     m_PipeConfigNode.GetEffectiveAudioGroup());
 }
 
+void GOSoundingPipe::SetLoadedReleaseTail(unsigned releaseTail) {
+  m_LoadedReleaseTail = releaseTail;
+  UpdateReleaseTail();
+}
+
 void GOSoundingPipe::UpdateReleaseTail() {
-  m_SoundProvider.SetReleaseTail(m_PipeConfigNode.GetEffectiveReleaseTail());
+  unsigned releaseTail = m_PipeConfigNode.GetEffectiveReleaseTail();
+
+  // the truncated releases can not be played longer until the organ is reloaded
+  if (
+    m_LoadedReleaseTail
+    && (!releaseTail || releaseTail > m_LoadedReleaseTail))
+    releaseTail = m_LoadedReleaseTail;
+  m_SoundProvider.SetReleaseTail(releaseTail);
 }
 
 void GOSoundingPipe::UpdateToneBalance() {
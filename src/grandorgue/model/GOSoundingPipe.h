@@ -8,11 +8,14 @@
 #ifndef GOSOUNDINGPIPE_H
 #define GOSOUNDINGPIPE_H
 
+#include <memory>
+
 #include "pipe-config/GOPipeConfigNode.h"
 #include "pipe-config/GOPipeUpdateCallback.h"
 #include "sound/providers/GOSoundProviderWave.h"
 
 #include "GOCacheObject.h"
+#include "GOHash.h"
 #include "GOPipe.h"
 #include "GOPipeWindchestCallback.h"
 
@@ -25,20 +28,36 @@ class GOSoundingPipe : public GOPipe,
                        private GOPipeUpdateCallback,
                        private GOPipeWindchestCallback {
 private:
+  /**
+   * The description of the samples read from the ODF. It is used only for
+   * loading the samples and is released after the organ has been loaded
+   */
+  struct LoadInfo {
+    wxString m_Filename;
+    std::vector<GOSoundProviderWave::AttackFileInfo> m_AttackFileInfos;
+    std::vector<GOSoundProviderWave::ReleaseFileInfo> m_ReleaseFileInfos;
+  };
+
+  // The fields used on each note-on and note-off are placed together
+
   GOOrganModel *p_OrganModel;
   GOSoundSampler *p_CurrentLoopSampler;
   uint64_t m_LastStart;
   uint64_t m_LastStop;
   int m_Instances;
-  std::vector<GOSoundProviderWave::AttackFileInfo> m_AttackFileInfos;
-  std::vector<GOSoundProviderWave::ReleaseFileInfo> m_ReleaseFileInfos;
-  wxString m_Filename;
-
   /* states which windchest this pipe belongs to, see
    * GOSoundEngine::StartSampler */
   unsigned m_WindchestN; // starts with 1
   unsigned m_AudioGroupID;
+
+  // The fields used rarely
+
+  std::unique_ptr<LoadInfo> mp_LoadInfo;
+  // the hash of the load info calculated before releasing it
+  GOHashType m_LoadInfoHash;
   float m_TemperamentOffset;
+  // the release tail (ms) the loaded releases are truncated to, or 0
+  unsigned m_LoadedReleaseTail;
   unsigned m_HarmonicNumber;
   float m_MinVolume;
   float m_MaxVolume;
@@ -53,12 +72,12 @@ private:
 
   // internal functions
   /* Read one attack file info from the odf keys with the prefix specified and
-   * add it to m_AttackFileInfos
+   * add it to mp_LoadInfo->m_AttackFileInfos
    */
   void LoadAttackFileInfo(
     GOConfigReader &cfg, const wxString &group, const wxString &prefix);
   /* Read one release file info from the odf keys with the prefix specified and
-   * add it to m_AttackFileInfos
+   * add it to mp_LoadInfo->m_ReleaseFileInfos
    */
   void LoadReleaseFileInfo(
     GOConfigReader &cfg, const wxString &group, const wxString &prefix);
@@ -73,15 +92,28 @@ private:
    * @return pitch offset in cents
    */
   float GetAutoTuningPitchOffset() const;
+  /**
+   * Returns the release tail (ms) the releases are truncated to at load time,
+   * or 0 if they are loaded completely
+   */
+  unsigned GetLoadReleaseTail() const;
+  void SetLoadedReleaseTail(unsigned releaseTail);
+  // Whether the samples for an active wave tremulant may be played
+  bool IsWaveTremulantUsed() const;
   void Validate();
+  GOHashType CalcLoadInfoHash() const;
 
   // Callbacks for GOCacheObject
-  const wxString &GetLoadTitle() const override { return m_Filename; }
+  const wxString &GetLoadTitle() const override {
+    return mp_LoadInfo ? mp_LoadInfo->m_Filename : m_PipeConfigNode.GetName();
+  }
   void Initialize() override {}
   void LoadData(const GOFileStore &fileStore, GOMemoryPool &pool) override;
   bool LoadCache(GOMemoryPool &pool, GOCache &cache) override;
+  bool TakeData(GOCacheObject &donor) override;
   bool SaveCache(GOCacheWriter &cache) const override;
   void UpdateHash(GOHash &hash) const override;
+  void ReleaseLoadInfo() override;
 
   // Callbacks from GOPipeConfigNode
   void UpdateAmplitude() override;
@@ -93,6 +93,13 @@ unsigned GOWindchest::GetTremulantCount() { return m_tremulant.size(); }
 
 unsigned GOWindchest::GetTremulantId(unsigned no) { return m_tremulant[no]; }
 
+bool GOWindchest::HasWaveTremulant() const {
+  for (unsigned id : m_tremulant)
+    if (r_OrganModel.GetTremulant(id)->GetTremulantType() == GOWavTrem)
+      return true;
+  return false;
+}
+
 unsigned GOWindchest::GetRankCount() { return m_ranks.size(); }
 
 GORank *GOWindchest::GetRank(unsigned index) {
@@ -53,6 +53,8 @@ public:
   float GetVolume();
   unsigned GetTremulantCount();
   unsigned GetTremulantId(unsigned index);
+  // Whether a wave tremulant may switch the samples of the pipes
+  bool HasWaveTremulant() const;
   unsigned GetRankCount();
   GORank *GetRank(unsigned index);
   void AddRank(GORank *rank);
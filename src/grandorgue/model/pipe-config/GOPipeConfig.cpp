@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -126,6 +126,7 @@ void GOPipeConfig::LoadFromCmb(
   m_Callback->UpdateAudioGroup();
   m_Callback->UpdateReleaseTail();
   m_Callback->UpdateToneBalance();
+  m_Callback->UpdateDelay();
 }
 
 void GOPipeConfig::Init(
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -134,7 +134,9 @@ public:
 
   uint16_t GetDefaultDelay() const { return m_DefaultDelay; }
   uint16_t GetDelay() const { return m_Delay; }
-  void SetDelay(uint16_t delay) { SetSmallMember(delay, m_Delay); }
+  void SetDelay(uint16_t delay) {
+    SetSmallMember(delay, m_Delay, &GOPipeUpdateCallback::UpdateDelay);
+  }
 
   uint16_t GetReleaseTail() const { return m_ReleaseTail; }
   void SetReleaseTail(uint16_t releaseTail) {
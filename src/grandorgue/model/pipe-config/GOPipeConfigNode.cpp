@@ -1,12 +1,14 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
 
 #include "GOPipeConfigNode.h"
 
+#include <algorithm>
+
 #include "config/GOConfig.h"
 #include "model/GOOrganModel.h"
 
@@ -21,17 +23,128 @@ GOPipeConfigNode::GOPipeConfigNode(
   : r_OrganModel(organModel),
     m_config(organModel.GetConfig()),
     m_parent(parent),
-    m_PipeConfig(organModel, callback),
+    m_PipeConfig(organModel, this),
+    m_Callback(callback),
     m_StatisticCallback(statistic),
-    m_Name() {
+    m_Name(),
+    m_PendingUpdates(0),
+    m_BatchDepth(0) {
   if (m_parent)
     m_parent->AddChild(this);
+  RecalcEffective(UPDATE_ALL);
+}
+
+GOPipeConfigNode::UpdateBatch::UpdateBatch(GOPipeConfigNode &node)
+  : r_root(node.GetRoot()) {
+  r_root.m_BatchDepth++;
+}
+
+GOPipeConfigNode::UpdateBatch::~UpdateBatch() {
+  if (!--r_root.m_BatchDepth)
+    r_root.ApplyPendingUpdates();
 }
 
 void GOPipeConfigNode::SetParent(GOPipeConfigNode *parent) {
   m_parent = parent;
   if (m_parent)
     m_parent->AddChild(this);
+  RecalcEffectiveTree();
+}
+
+GOPipeConfigNode &GOPipeConfigNode::GetRoot() {
+  GOPipeConfigNode *pNode = this;
+
+  while (pNode->m_parent)
+    pNode = pNode->m_parent;
+  return *pNode;
+}
+
+unsigned GOPipeConfigNode::GetDepth() const {
+  unsigned depth = 0;
+
+  for (const GOPipeConfigNode *pNode = m_parent; pNode; pNode = pNode->m_parent)
+    depth++;
+  return depth;
+}
+
+void GOPipeConfigNode::RecalcEffective(uint8_t updates) {
+  const GOPipeConfigNode *parent = m_parent;
+
+  if (updates & UPDATE_AMPLITUDE) {
+    m_EffectiveAmplitude = parent
+      ? m_PipeConfig.GetAmplitude() * parent->m_EffectiveAmplitude / 100.0
+      : m_PipeConfig.GetAmplitude() / 100.0;
+    m_EffectiveGain
+      = m_PipeConfig.GetGain() + (parent ? parent->m_EffectiveGain : 0);
+  }
+  if (updates & UPDATE_TUNING) {
+    m_EffectivePitchTuning = m_PipeConfig.GetPitchTuning()
+      + (parent ? parent->m_EffectivePitchTuning : 0);
+    m_EffectivePitchCorrection = m_PipeConfig.GetPitchCorrection()
+      + (parent ? parent->m_EffectivePitchCorrection : 0);
+    m_EffectiveManualTuning = m_PipeConfig.GetManualTuning()
+      + (parent ? parent->m_EffectiveManualTuning : 0);
+    m_EffectiveAutoTuningCorrection = m_PipeConfig.GetAutoTuningCorrection()
+      + (parent ? parent->m_EffectiveAutoTuningCorrection : 0);
+  }
+  if (updates & UPDATE_DELAY)
+    m_EffectiveDelay
+      = m_PipeConfig.GetDelay() + (parent ? parent->m_EffectiveDelay : 0);
+}
+
+void GOPipeConfigNode::RecalcEffectiveTree() {
+  RecalcEffective(UPDATE_ALL);
+  for (unsigned i = 0; i < GetChildCount(); i++)
+    GetChild(i)->RecalcEffectiveTree();
+}
+
+void GOPipeConfigNode::ApplyUpdates(uint8_t updates) {
+  m_PendingUpdates &= ~updates;
+  RecalcEffective(updates);
+  for (unsigned i = 0; i < GetChildCount(); i++)
+    GetChild(i)->ApplyUpdates(updates);
+  if (m_Callback) {
+    if (updates & UPDATE_AMPLITUDE)
+      m_Callback->UpdateAmplitude();
+    if (updates & UPDATE_TUNING)
+      m_Callback->UpdateTuning();
+    if (updates & UPDATE_AUDIO_GROUP)
+      m_Callback->UpdateAudioGroup();
+    if (updates & UPDATE_RELEASE_TAIL)
+      m_Callback->UpdateReleaseTail();
+    if (updates & UPDATE_TONE_BALANCE)
+      m_Callback->UpdateToneBalance();
+    if (updates & UPDATE_DELAY)
+      m_Callback->UpdateDelay();
+  }
+}
+
+void GOPipeConfigNode::OnConfigChanged(uint8_t updates) {
+  GOPipeConfigNode &root = GetRoot();
+
+  if (root.m_BatchDepth) {
+    if (!m_PendingUpdates)
+      root.m_PendingNodes.push_back(this);
+    m_PendingUpdates |= updates;
+  } else
+    ApplyUpdates(updates);
+}
+
+void GOPipeConfigNode::ApplyPendingUpdates() {
+  std::vector<GOPipeConfigNode *> nodes;
+
+  nodes.swap(m_PendingNodes);
+  // The ancestors go first. Applying their updates clears the same pending
+  // updates of the descendants, so each subtree is passed once
+  std::stable_sort(
+    nodes.begin(),
+    nodes.end(),
+    [](const GOPipeConfigNode *pNode1, const GOPipeConfigNode *pNode2) {
+      return pNode1->GetDepth() < pNode2->GetDepth();
+    });
+  for (GOPipeConfigNode *pNode : nodes)
+    if (pNode->m_PendingUpdates)
+      pNode->ApplyUpdates(pNode->m_PendingUpdates);
 }
 
 void GOPipeConfigNode::Init(
@@ -56,14 +169,6 @@ wxString GOPipeConfigNode::GetEffectiveAudioGroup() const {
     return wxEmptyString;
 }
 
-float GOPipeConfigNode::GetEffectiveAmplitude() const {
-  if (m_parent)
-    return m_PipeConfig.GetAmplitude() * m_parent->GetEffectiveAmplitude()
-      / 100.0;
-  else
-    return m_PipeConfig.GetAmplitude() / 100.0;
-}
-
 uint16_t GOPipeConfigNode::GetEffectiveReleaseTail() const {
   unsigned releaseTail = m_parent ? m_parent->GetEffectiveReleaseTail() : 0;
   const unsigned thisReleaseTail = m_PipeConfig.GetReleaseTail();
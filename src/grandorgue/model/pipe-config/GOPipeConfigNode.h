@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2025 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -8,36 +8,109 @@
 #ifndef GOPIPECONFIGNODE_H
 #define GOPIPECONFIGNODE_H
 
+#include <cstdint>
+#include <vector>
+
 #include <config/GOConfig.h>
 
 #include "GOPipeConfig.h"
+#include "GOPipeUpdateCallback.h"
 #include "GOSaveableObject.h"
 
 class GOOrganModel;
 class GOSampleStatistic;
 class GOStatisticCallback;
 
-class GOPipeConfigNode : private GOSaveableObject {
+/**
+ * A node of the pipe configuration tree: the organ, the windchests, the ranks
+ * and the pipes.
+ *
+ * The effective amplitude, gain, tuning and delay are combined with the
+ * parent values when a value changes and are kept in the node, so reading
+ * them does not walk the tree. A change is applied to the subtree of the node
+ * only: its effective values are recalculated top down and the callbacks are
+ * called.
+ *
+ * The changes made while an UpdateBatch is open are collected and applied in
+ * one pass when the last batch is closed, so several changes of the same
+ * subtree cost one pass.
+ */
+class GOPipeConfigNode : private GOSaveableObject,
+                         private GOPipeUpdateCallback {
+public:
+  /**
+   * Defers applying the changes of the whole tree while it exists. The
+   * batches may be nested
+   */
+  class UpdateBatch {
+  private:
+    GOPipeConfigNode &r_root;
+
+  public:
+    UpdateBatch(GOPipeConfigNode &node);
+    ~UpdateBatch();
+
+    UpdateBatch(const UpdateBatch &) = delete;
+    UpdateBatch &operator=(const UpdateBatch &) = delete;
+  };
+
 private:
+  enum : uint8_t {
+    UPDATE_AMPLITUDE = 1 << 0,
+    UPDATE_TUNING = 1 << 1,
+    UPDATE_AUDIO_GROUP = 1 << 2,
+    UPDATE_RELEASE_TAIL = 1 << 3,
+    UPDATE_TONE_BALANCE = 1 << 4,
+    UPDATE_DELAY = 1 << 5,
+    UPDATE_ALL = (1 << 6) - 1,
+  };
+
   GOOrganModel &r_OrganModel;
   const GOConfig &m_config;
   GOPipeConfigNode *m_parent;
   GOPipeConfig m_PipeConfig;
+  GOPipeUpdateCallback *m_Callback;
   GOStatisticCallback *m_StatisticCallback;
   wxString m_Name;
 
+  // the effective values combined with the parent ones
+  float m_EffectiveAmplitude;
+  float m_EffectiveGain;
+  float m_EffectivePitchTuning;
+  float m_EffectivePitchCorrection;
+  float m_EffectiveManualTuning;
+  float m_EffectiveAutoTuningCorrection;
+  uint16_t m_EffectiveDelay;
+
+  // the changes of this node not applied yet because of an open batch
+  uint8_t m_PendingUpdates;
+  // the number of open batches. Only for the root node
+  unsigned m_BatchDepth;
+  // the nodes having pending updates. Only for the root node
+  std::vector<GOPipeConfigNode *> m_PendingNodes;
+
   void Save(GOConfigWriter &cfg) override { m_PipeConfig.Save(cfg); }
 
-  template <typename T>
-  T GetEffectiveSum(
-    T (GOPipeConfig::*getThisValue)() const,
-    T (GOPipeConfigNode::*getParentValue)() const) const {
-    T value = (m_PipeConfig.*getThisValue)();
-
-    if (m_parent)
-      value += (m_parent->*getParentValue)();
-    return value;
-  }
+  GOPipeConfigNode &GetRoot();
+  unsigned GetDepth() const;
+
+  // recalculates the effective values of this node from the parent ones
+  void RecalcEffective(uint8_t updates);
+  // recalculates the effective values of the subtree without notifications
+  void RecalcEffectiveTree();
+  // applies the changes to the subtree now
+  void ApplyUpdates(uint8_t updates);
+  // applies the changes now or after the open batch is closed
+  void OnConfigChanged(uint8_t updates);
+  void ApplyPendingUpdates();
+
+  // Callbacks from m_PipeConfig
+  void UpdateAmplitude() override { OnConfigChanged(UPDATE_AMPLITUDE); }
+  void UpdateTuning() override { OnConfigChanged(UPDATE_TUNING); }
+  void UpdateAudioGroup() override { OnConfigChanged(UPDATE_AUDIO_GROUP); }
+  void UpdateReleaseTail() override { OnConfigChanged(UPDATE_RELEASE_TAIL); }
+  void UpdateToneBalance() override { OnConfigChanged(UPDATE_TONE_BALANCE); }
+  void UpdateDelay() override { OnConfigChanged(UPDATE_DELAY); }
 
   uint8_t GetEffectiveUint8(
     int8_t (GOPipeConfig::*getThisValue)() const,
@@ -74,41 +147,17 @@ public:
 
   wxString GetEffectiveAudioGroup() const;
 
-  float GetEffectiveAmplitude() const;
-
-  float GetEffectiveGain() const {
-    return GetEffectiveSum(
-      &GOPipeConfig::GetGain, &GOPipeConfigNode::GetEffectiveGain);
-  }
-
-  float GetEffectivePitchTuning() const {
-    return GetEffectiveSum(
-      &GOPipeConfig::GetPitchTuning,
-      &GOPipeConfigNode::GetEffectivePitchTuning);
-  }
-
+  float GetEffectiveAmplitude() const { return m_EffectiveAmplitude; }
+  float GetEffectiveGain() const { return m_EffectiveGain; }
+  float GetEffectivePitchTuning() const { return m_EffectivePitchTuning; }
   float GetEffectivePitchCorrection() const {
-    return GetEffectiveSum(
-      &GOPipeConfig::GetPitchCorrection,
-      &GOPipeConfigNode::GetEffectivePitchCorrection);
+    return m_EffectivePitchCorrection;
   }
-
-  float GetEffectiveManualTuning() const {
-    return GetEffectiveSum(
-      &GOPipeConfig::GetManualTuning,
-      &GOPipeConfigNode::GetEffectiveManualTuning);
-  }
-
+  float GetEffectiveManualTuning() const { return m_EffectiveManualTuning; }
   float GetEffectiveAutoTuningCorection() const {
-    return GetEffectiveSum(
-      &GOPipeConfig::GetAutoTuningCorrection,
-      &GOPipeConfigNode::GetEffectiveAutoTuningCorection);
-  }
-
-  uint16_t GetEffectiveDelay() const {
-    return GetEffectiveSum(
-      &GOPipeConfig::GetDelay, &GOPipeConfigNode::GetEffectiveDelay);
+    return m_EffectiveAutoTuningCorrection;
   }
+  uint16_t GetEffectiveDelay() const { return m_EffectiveDelay; }
 
   uint16_t GetEffectiveReleaseTail() const;
 
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -17,6 +17,8 @@ public:
   virtual void UpdateAudioGroup() = 0;
   virtual void UpdateReleaseTail() = 0;
   virtual void UpdateToneBalance() = 0;
+  // the delay is read on each note-on, so usually nothing is needed here
+  virtual void UpdateDelay() {}
 };
 
 #endif
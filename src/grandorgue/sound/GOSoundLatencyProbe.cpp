@@ -0,0 +1,271 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOSoundLatencyProbe.h"
+
+#include <cmath>
+#include <limits>
+
+#include <wx/intl.h>
+#include <wx/log.h>
+
+static constexpr int64_t NS_PER_MS = 1000000;
+
+static GOSoundLatencyProbe s_instance;
+
+GOSoundLatencyProbe &GOSoundLatencyProbe::getInstance() { return s_instance; }
+
+const wxString &GOSoundLatencyProbe::getIntervalName(Interval interval) {
+  static const wxString names[N_INTERVALS] = {
+    _("MIDI input to the main thread"),
+    _("Organ model and couplers"),
+    _("Sound engine to the first audible sample"),
+    _("Total"),
+  };
+
+  return names[interval];
+}
+
+GOSoundLatencyProbe::GOSoundLatencyProbe()
+  : m_IsStarted(false),
+    m_stage(NO_STAGE),
+    m_IsOutputSilent(true),
+    m_WasSilentAtSamplerStart(true),
+    m_NDiscarded(0),
+    m_NextReportCount(REPORT_INTERVAL),
+    m_DeviceLatencyMs(-1) {
+  for (auto &time : m_StageTimes)
+    time.store(0);
+  for (IntervalData &data : m_intervals) {
+    data.m_count.store(0);
+    data.m_MinNs.store(std::numeric_limits<int64_t>::max());
+    data.m_MaxNs.store(0);
+    data.m_SumNs.store(0);
+    for (auto &bucket : data.m_buckets)
+      bucket.store(0);
+  }
+}
+
+void GOSoundLatencyProbe::Start() {
+  m_IsStarted.store(false);
+  m_stage.store(NO_STAGE);
+  m_IsOutputSilent.store(true);
+  m_NDiscarded.store(0);
+  m_NextReportCount.store(REPORT_INTERVAL);
+  for (IntervalData &data : m_intervals) {
+    data.m_count.store(0);
+    data.m_MinNs.store(std::numeric_limits<int64_t>::max());
+    data.m_MaxNs.store(0);
+    data.m_SumNs.store(0);
+    for (auto &bucket : data.m_buckets)
+      bucket.store(0);
+  }
+  m_IsStarted.store(true);
+}
+
+void GOSoundLatencyProbe::Stop() {
+  m_IsStarted.store(false);
+  m_stage.store(NO_STAGE);
+}
+
+void GOSoundLatencyProbe::AddInterval(Interval interval, int64_t durationNs) {
+  IntervalData &data = m_intervals[interval];
+  unsigned bucketI = 0;
+
+  if (durationNs < 0)
+    durationNs = 0;
+  while (bucketI < N_BUCKETS - 1
+         && durationNs >= BUCKET_BOUNDS[bucketI] * NS_PER_MS)
+    bucketI++;
+  data.m_buckets[bucketI].fetch_add(1, std::memory_order_relaxed);
+  data.m_SumNs.fetch_add(durationNs, std::memory_order_relaxed);
+  // only the audio thread updates the statistic, so load + store is enough
+  if (durationNs < data.m_MinNs.load(std::memory_order_relaxed))
+    data.m_MinNs.store(durationNs, std::memory_order_relaxed);
+  if (durationNs > data.m_MaxNs.load(std::memory_order_relaxed))
+    data.m_MaxNs.store(durationNs, std::memory_order_relaxed);
+  data.m_count.fetch_add(1, std::memory_order_release);
+}
+
+void GOSoundLatencyProbe::OnNoteReceived(int64_t timeNs) {
+  if (!IsStarted())
+    return;
+
+  int stage = m_stage.load(std::memory_order_acquire);
+
+  if (stage != NO_STAGE) {
+    const int64_t startNs
+      = m_StageTimes[STAGE_RECEIVED].load(std::memory_order_relaxed);
+
+    // a measurement is in progress
+    if (
+      timeNs - startNs < std::chrono::nanoseconds(MEASUREMENT_TIMEOUT).count())
+      return;
+    // the note did not sound, e.g. it is not mapped to any manual
+    if (!m_stage.compare_exchange_strong(stage, NO_STAGE))
+      return;
+    m_NDiscarded.fetch_add(1, std::memory_order_relaxed);
+  }
+  m_StageTimes[STAGE_RECEIVED].store(timeNs, std::memory_order_relaxed);
+  stage = NO_STAGE;
+  m_stage.compare_exchange_strong(stage, STAGE_RECEIVED);
+}
+
+void GOSoundLatencyProbe::OnEventDispatched(int64_t timeNs) {
+  if (
+    IsStarted()
+    && m_stage.load(std::memory_order_acquire) == STAGE_RECEIVED) {
+    int stage = STAGE_RECEIVED;
+
+    m_StageTimes[STAGE_DISPATCHED].store(timeNs, std::memory_order_relaxed);
+    m_stage.compare_exchange_strong(stage, STAGE_DISPATCHED);
+  }
+}
+
+void GOSoundLatencyProbe::OnSamplerStarted(int64_t timeNs) {
+  if (
+    IsStarted()
+    && m_stage.load(std::memory_order_acquire) == STAGE_DISPATCHED) {
+    int stage = STAGE_DISPATCHED;
+
+    m_StageTimes[STAGE_SAMPLER_STARTED].store(
+      timeNs, std::memory_order_relaxed);
+    m_WasSilentAtSamplerStart.store(
+      m_IsOutputSilent.load(std::memory_order_relaxed),
+      std::memory_order_relaxed);
+    m_stage.compare_exchange_strong(stage, STAGE_SAMPLER_STARTED);
+  }
+}
+
+void GOSoundLatencyProbe::OnOutputRendered(
+  const float *data,
+  unsigned nChannels,
+  unsigned nFrames,
+  unsigned sampleRate,
+  int64_t timeNs) {
+  if (!IsStarted())
+    return;
+
+  const unsigned nItems = nChannels * nFrames;
+  unsigned onsetItemI = 0;
+
+  while (onsetItemI < nItems
+         && std::fabs(data[onsetItemI]) <= ONSET_THRESHOLD)
+    onsetItemI++;
+
+  const bool isSilent = onsetItemI >= nItems;
+  int stage = STAGE_SAMPLER_STARTED;
+
+  if (m_stage.load(std::memory_order_acquire) == STAGE_SAMPLER_STARTED) {
+    if (!m_WasSilentAtSamplerStart.load(std::memory_order_relaxed)) {
+      // another sound was playing, so the onset cannot be detected
+      if (m_stage.compare_exchange_strong(stage, NO_STAGE))
+        m_NDiscarded.fetch_add(1, std::memory_order_relaxed);
+    } else if (!isSilent) {
+      const int64_t onsetNs
+        = timeNs + (int64_t)(onsetItemI / nChannels) * 1000000000 / sampleRate;
+      int64_t times[N_STAGES];
+
+      for (unsigned i = 0; i < STAGE_RENDERED; i++)
+        times[i] = m_StageTimes[i].load(std::memory_order_relaxed);
+      times[STAGE_RENDERED] = onsetNs;
+      m_StageTimes[STAGE_RENDERED].store(onsetNs, std::memory_order_relaxed);
+      AddInterval(
+        INTERVAL_EVENT_QUEUE, times[STAGE_DISPATCHED] - times[STAGE_RECEIVED]);
+      AddInterval(
+        INTERVAL_ORGAN_MODEL,
+        times[STAGE_SAMPLER_STARTED] - times[STAGE_DISPATCHED]);
+      AddInterval(
+        INTERVAL_SOUND_ENGINE,
+        times[STAGE_RENDERED] - times[STAGE_SAMPLER_STARTED]);
+      AddInterval(
+        INTERVAL_TOTAL, times[STAGE_RENDERED] - times[STAGE_RECEIVED]);
+      m_stage.compare_exchange_strong(stage, NO_STAGE);
+    }
+  }
+  m_IsOutputSilent.store(isSilent, std::memory_order_relaxed);
+}
+
+void GOSoundLatencyProbe::SetDeviceLatency(int latencyMs) {
+  int oldLatency = m_DeviceLatencyMs.load(std::memory_order_relaxed);
+
+  while (oldLatency < latencyMs
+         && !m_DeviceLatencyMs.compare_exchange_weak(oldLatency, latencyMs))
+    ;
+}
+
+unsigned GOSoundLatencyProbe::GetNMeasured() const {
+  return m_intervals[INTERVAL_TOTAL].m_count.load(std::memory_order_acquire);
+}
+
+GOSoundLatencyProbe::IntervalStatistic GOSoundLatencyProbe::GetStatistic(
+  Interval interval) const {
+  const IntervalData &data = m_intervals[interval];
+  IntervalStatistic stat;
+
+  stat.m_count = data.m_count.load(std::memory_order_acquire);
+  stat.m_MinNs
+    = stat.m_count ? data.m_MinNs.load(std::memory_order_relaxed) : 0;
+  stat.m_MaxNs = data.m_MaxNs.load(std::memory_order_relaxed);
+  stat.m_SumNs = data.m_SumNs.load(std::memory_order_relaxed);
+  for (unsigned i = 0; i < N_BUCKETS; i++)
+    stat.m_buckets[i] = data.m_buckets[i].load(std::memory_order_relaxed);
+  return stat;
+}
+
+wxString GOSoundLatencyProbe::GetReport() const {
+  wxString report = wxString::Format(
+    _("Key-to-sound latency: %u notes measured, %u discarded"),
+    GetNMeasured(),
+    GetNDiscarded());
+
+  for (unsigned intervalI = 0; intervalI < N_INTERVALS; intervalI++) {
+    const Interval interval = (Interval)intervalI;
+    const IntervalStatistic stat = GetStatistic(interval);
+
+    report += wxT("\n") + getIntervalName(interval) + wxT(": ");
+    if (!stat.m_count) {
+      report += _("no data");
+      continue;
+    }
+    report += wxString::Format(
+      _("min %.1f ms, avg %.1f ms, max %.1f ms"),
+      stat.m_MinNs / (double)NS_PER_MS,
+      stat.m_SumNs / (double)NS_PER_MS / stat.m_count,
+      stat.m_MaxNs / (double)NS_PER_MS);
+    for (unsigned bucketI = 0; bucketI < N_BUCKETS; bucketI++)
+      if (stat.m_buckets[bucketI]) {
+        const wxString range = bucketI < N_BUCKETS - 1
+          ? wxString::Format(wxT("<%u"), BUCKET_BOUNDS[bucketI])
+          : wxString::Format(wxT(">=%u"), BUCKET_BOUNDS[bucketI - 1]);
+
+        report += wxString::Format(
+          wxT("\n  %s ms: %u"), range, stat.m_buckets[bucketI]);
+      }
+  }
+
+  const int deviceLatency = m_DeviceLatencyMs.load(std::memory_order_relaxed);
+
+  report += wxT("\n");
+  if (deviceLatency >= 0)
+    report += wxString::Format(
+      _("The audio device buffer adds %d ms as reported by the audio port"),
+      deviceLatency);
+  else
+    report += _("The latency of the audio device buffer is unknown");
+  return report;
+}
+
+void GOSoundLatencyProbe::LogReportIfDue() {
+  const unsigned nextReportCount
+    = m_NextReportCount.load(std::memory_order_relaxed);
+
+  if (IsStarted() && GetNMeasured() >= nextReportCount) {
+    m_NextReportCount.store(
+      nextReportCount + REPORT_INTERVAL, std::memory_order_relaxed);
+    wxLogMessage(wxT("%s"), GetReport());
+  }
+}
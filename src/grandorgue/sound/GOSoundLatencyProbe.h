@@ -0,0 +1,158 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOSOUNDLATENCYPROBE_H
+#define GOSOUNDLATENCYPROBE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+
+#include <wx/string.h>
+
+/**
+ * Measures the delay from a MIDI note-on until its first audible sample.
+ *
+ * A measurement starts when a note-on is received while no other measurement
+ * is in progress. Each following stage stamps its time:
+ *   - STAGE_RECEIVED: GOMidiSystem receives the note-on from a port
+ *   - STAGE_DISPATCHED: the note-on reaches the main thread via the event queue
+ *   - STAGE_SAMPLER_STARTED: the organ model has propagated the note through
+ *     the couplers and the sound engine has started the first pipe sampler
+ *   - STAGE_RENDERED: an output buffer contains the first audible sample. The
+ *     position of the sample inside the buffer is taken into account
+ * The intervals between the stages are collected into histograms. The device
+ * buffer is not measured but reported by the audio port.
+ *
+ * The onset is detected as the first sample above ONSET_THRESHOLD, so the
+ * output must be silent when the sampler starts. Otherwise the measurement is
+ * discarded.
+ *
+ * All the methods except GetReport() never block and never allocate, so they
+ * may be called on the MIDI and the audio threads. The probe is opt-in: until
+ * Start() is called the methods do nothing.
+ */
+class GOSoundLatencyProbe {
+public:
+  enum Stage {
+    STAGE_RECEIVED,
+    STAGE_DISPATCHED,
+    STAGE_SAMPLER_STARTED,
+    STAGE_RENDERED,
+    N_STAGES
+  };
+
+  enum Interval {
+    // STAGE_RECEIVED -> STAGE_DISPATCHED
+    INTERVAL_EVENT_QUEUE,
+    // STAGE_DISPATCHED -> STAGE_SAMPLER_STARTED
+    INTERVAL_ORGAN_MODEL,
+    // STAGE_SAMPLER_STARTED -> STAGE_RENDERED
+    INTERVAL_SOUND_ENGINE,
+    // STAGE_RECEIVED -> STAGE_RENDERED
+    INTERVAL_TOTAL,
+    N_INTERVALS
+  };
+
+  // the upper bounds of the histogram buckets in ms. The last bucket is open
+  static constexpr unsigned BUCKET_BOUNDS[]
+    = {1, 2, 3, 5, 7, 10, 15, 20, 30, 50, 75, 100};
+  static constexpr unsigned N_BUCKETS = std::size(BUCKET_BOUNDS) + 1;
+  // -80 dB
+  static constexpr float ONSET_THRESHOLD = 1.0e-4f;
+  // a measurement not finished within this time is abandoned
+  static constexpr std::chrono::milliseconds MEASUREMENT_TIMEOUT{2000};
+  // how many measurements are collected between the periodic reports
+  static constexpr unsigned REPORT_INTERVAL = 100;
+
+  struct IntervalStatistic {
+    unsigned m_count;
+    int64_t m_MinNs;
+    int64_t m_MaxNs;
+    int64_t m_SumNs;
+    unsigned m_buckets[N_BUCKETS];
+  };
+
+private:
+  static constexpr int NO_STAGE = -1;
+
+  struct IntervalData {
+    std::atomic<unsigned> m_count;
+    std::atomic<int64_t> m_MinNs;
+    std::atomic<int64_t> m_MaxNs;
+    std::atomic<int64_t> m_SumNs;
+    std::atomic<unsigned> m_buckets[N_BUCKETS];
+  };
+
+  std::atomic_bool m_IsStarted;
+  // the last stage passed by the current measurement or NO_STAGE
+  std::atomic<int> m_stage;
+  std::atomic<int64_t> m_StageTimes[N_STAGES];
+  // whether the last rendered buffer was silent
+  std::atomic_bool m_IsOutputSilent;
+  // whether the output was silent when the sampler started
+  std::atomic_bool m_WasSilentAtSamplerStart;
+  IntervalData m_intervals[N_INTERVALS];
+  std::atomic<unsigned> m_NDiscarded;
+  std::atomic<unsigned> m_NextReportCount;
+  // the maximal latency reported by the audio ports. -1 if unknown
+  std::atomic<int> m_DeviceLatencyMs;
+
+  void AddInterval(Interval interval, int64_t durationNs);
+
+public:
+  static int64_t getTimeNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+  }
+
+  // the probe the MIDI and the sound code report to
+  static GOSoundLatencyProbe &getInstance();
+
+  static const wxString &getIntervalName(Interval interval);
+
+  GOSoundLatencyProbe();
+
+  // Clears the statistic and starts measuring
+  void Start();
+  void Stop();
+  bool IsStarted() const { return m_IsStarted.load(std::memory_order_relaxed); }
+
+  void OnNoteReceived(int64_t timeNs = getTimeNs());
+  void OnEventDispatched(int64_t timeNs = getTimeNs());
+  void OnSamplerStarted(int64_t timeNs = getTimeNs());
+  /**
+   * Looks for the onset in the output buffer just rendered
+   * @param data interleaved samples
+   * @param timeNs the time the buffer is passed to the audio port
+   */
+  void OnOutputRendered(
+    const float *data,
+    unsigned nChannels,
+    unsigned nFrames,
+    unsigned sampleRate,
+    int64_t timeNs = getTimeNs());
+
+  void SetDeviceLatency(int latencyMs);
+
+  unsigned GetNMeasured() const;
+  unsigned GetNDiscarded() const {
+    return m_NDiscarded.load(std::memory_order_relaxed);
+  }
+  IntervalStatistic GetStatistic(Interval interval) const;
+
+  wxString GetReport() const;
+
+  /**
+   * Writes the report to the log after each REPORT_INTERVAL measurements. Must
+   * be called on the main thread
+   */
+  void LogReportIfDue();
+};
+
+#endif /* GOSOUNDLATENCYPROBE_H */
@@ -21,12 +21,15 @@
 #include "tasks/GOSoundGroupTask.h"
 #include "tasks/GOSoundOutputTask.h"
 #include "tasks/GOSoundReleaseTask.h"
+#include "tasks/GOSoundReverbTask.h"
 #include "tasks/GOSoundTouchTask.h"
 #include "tasks/GOSoundTremulantTask.h"
 #include "tasks/GOSoundWindchestTask.h"
 #include "threading/GOMutexLocker.h"
 
 #include "GOEvent.h"
+#include "GORandom.h"
+#include "GOSoundLatencyProbe.h"
 #include "GOSoundRecorder.h"
 
 /*
@@ -104,6 +107,7 @@ GOSoundOrganEngine::GOSoundOrganEngine(
     mp_TouchTask(std::make_unique<GOSoundTouchTask>(r_MemoryPool)),
     m_NAudioGroups(1),
     m_NAuxThreads(0),
+    m_IsAdaptiveThreadCount(true),
     m_IsDownmix(false),
     m_NReleaseRepeats(1),
     m_IsPolyphonyLimiting(true),
@@ -111,6 +115,7 @@ GOSoundOrganEngine::GOSoundOrganEngine(
     m_IsScaledReleases(true),
     m_IsReleaseAlignmentEnabled(true),
     m_IsRandomizeSpeaking(true),
+    m_IsRenderTimeMeasured(false),
     m_InterpolationType(GOSoundResample::GO_LINEAR_INTERPOLATION),
     m_ReverbConfig(GOSoundReverb::CONFIG_REVERB_DISABLED),
     m_NSamplesPerBuffer(1),
@@ -118,7 +123,12 @@ GOSoundOrganEngine::GOSoundOrganEngine(
     m_LifecycleState(LifecycleState::IDLE),
     p_AudioRecorder(nullptr),
     m_CurrentTime(1),
-    m_UsedPolyphony(0) {
+    m_UsedPolyphony(0),
+    m_NActiveThreads(0),
+    m_CallbackBusyNs(0),
+    m_LastNWakeups(0),
+    m_LastNSteals(0),
+    m_LastNIdleWakeups(0) {
   SetVolume(-15);
   m_SamplerPool.SetUsageLimit(2048);
   m_PolyphonySoftLimit = (m_SamplerPool.GetUsageLimit() * 3) / 4;
@@ -150,12 +160,14 @@ void GOSoundOrganEngine::SetFromConfig(GOConfig &config) {
 
   SetNAudioGroups(nAudioGroups >= 1 ? nAudioGroups : 1);
   SetNAuxThreads(config.Concurrency());
+  SetAdaptiveThreadCount(config.AdaptiveConcurrency());
   SetDownmix(config.RecordDownmix());
   SetNReleaseRepeats(config.ReleaseConcurrency());
   SetPolyphonyLimiting(config.ManagePolyphony());
   SetHardPolyphony(config.PolyphonyLimit());
   SetScaledReleases(config.ScaleRelease());
   SetRandomizeSpeaking(config.RandomizeSpeaking());
+  SetRenderTimeMeasured(config.MeasureRenderTime());
   SetInterpolationType(config.m_InterpolationType());
   SetReverbConfig(GOSoundReverb::createReverbConfig(config));
 }
@@ -253,11 +265,47 @@ void GOSoundOrganEngine::BuildEngine(
   }
 
   // [B6] Set up reverb
-  if (mp_DownmixTask)
-    mp_DownmixTask->SetupReverb(
-      m_ReverbConfig, m_NSamplesPerBuffer, m_SampleRate);
-  for (auto &pTask : mp_AudioOutputTasks)
-    pTask->SetupReverb(m_ReverbConfig, m_NSamplesPerBuffer, m_SampleRate);
+  if (m_ReverbConfig.isEnabled) {
+    std::vector<GOSoundOutputTask *> mixTasks;
+    std::vector<bool> isGroupUsed(m_NAudioGroups, false);
+    unsigned nMixChannels = 0;
+    unsigned nUsedGroupChannels = 0;
+
+    for (auto &pTask : mp_AudioOutputTasks)
+      mixTasks.push_back(pTask.get());
+    if (mp_DownmixTask)
+      mixTasks.push_back(mp_DownmixTask.get());
+    for (GOSoundOutputTask *pTask : mixTasks) {
+      nMixChannels += pTask->GetNChannels();
+      for (unsigned groupI = 0; groupI < m_NAudioGroups; groupI++)
+        if (pTask->IsOutputUsed(groupI))
+          isGroupUsed[groupI] = true;
+    }
+    for (unsigned groupI = 0; groupI < m_NAudioGroups; groupI++)
+      if (isGroupUsed[groupI])
+        nUsedGroupChannels += mp_AudioGroupTasks[groupI]->GetNChannels();
+
+    // the reverb costs the same per channel, so it is placed where there are
+    // fewer channels
+    if (nUsedGroupChannels <= nMixChannels) {
+      std::vector<GOSoundBufferTaskBase *> reverbOutputs(groupOutputs);
+
+      for (unsigned groupI = 0; groupI < m_NAudioGroups; groupI++)
+        if (isGroupUsed[groupI]) {
+          auto pReverbTask = std::make_unique<GOSoundReverbTask>(
+            *mp_AudioGroupTasks[groupI], m_NSamplesPerBuffer);
+
+          pReverbTask->SetupReverb(
+            m_ReverbConfig, m_NSamplesPerBuffer, m_SampleRate);
+          reverbOutputs[groupI] = pReverbTask.get();
+          mp_ReverbTasks.push_back(std::move(pReverbTask));
+        }
+      for (GOSoundOutputTask *pTask : mixTasks)
+        pTask->SetOutputs(reverbOutputs);
+    } else
+      for (GOSoundOutputTask *pTask : mixTasks)
+        pTask->SetupReverb(m_ReverbConfig, m_NSamplesPerBuffer, m_SampleRate);
+  }
 
   // [B7] Build tremulant tasks
   for (unsigned n = r_OrganModel.GetTremulantCount(), tremI = 0; tremI < n;
@@ -287,6 +335,8 @@ void GOSoundOrganEngine::BuildEngine(
     m_Scheduler.Add(pWcTask.get());
   for (GOSoundGroupTask *pGroupTask : mp_AudioGroupTasks)
     m_Scheduler.Add(pGroupTask);
+  for (auto &pReverbTask : mp_ReverbTasks)
+    m_Scheduler.Add(pReverbTask.get());
   if (mp_DownmixTask)
     m_Scheduler.Add(mp_DownmixTask.get());
   for (auto &pOutputTask : mp_AudioOutputTasks)
@@ -323,7 +373,9 @@ void GOSoundOrganEngine::DestroyEngine() {
   // [B7] Destroy tremulant tasks
   mp_TremulantTasks.clear();
 
-  // [B6] Reverb — no explicit cleanup (owned by output tasks below)
+  // [B6] Destroy the bus reverb tasks. Otherwise the reverb is owned by the
+  // output tasks below
+  mp_ReverbTasks.clear();
   // [B5] Recorder outputs — no explicit cleanup (recorder is non-owning)
 
   // [B4] Destroy downmix task
@@ -348,6 +400,14 @@ void GOSoundOrganEngine::ResetCounters() {
   m_SamplerPool.ReturnAll();
   m_CurrentTime = 1;
   m_Scheduler.Reset();
+  m_ThreadCountControl.Init(
+    mp_threads.size(),
+    MsToSamples(THREAD_PARKING_DELAY_MS) / m_NSamplesPerBuffer);
+  m_NActiveThreads.store(mp_threads.size());
+  m_CallbackBusyNs.store(0);
+  m_LastNWakeups.store(0);
+  m_LastNSteals.store(0);
+  m_LastNIdleWakeups.store(0);
 }
 
 void GOSoundOrganEngine::StartEngine() {
@@ -398,10 +458,23 @@ void GOSoundOrganEngine::SetUsed(bool isUsed) {
 void GOSoundOrganEngine::GetAudioOutput(
   unsigned outputIndex, bool isLast, GOSoundBufferMutable &outBuffer) {
   if (IsWorking()) {
+    const int64_t startTime = GOSoundThread::getTimeNs();
     GOSoundOutputTask *pOutputTask = mp_AudioOutputTasks[outputIndex].get();
 
     pOutputTask->Finish(isLast);
     outBuffer.CopyFrom(*pOutputTask);
+
+    GOSoundLatencyProbe &probe = GOSoundLatencyProbe::getInstance();
+
+    // the onset is looked for in the first output only
+    if (outputIndex == 0 && probe.IsStarted())
+      probe.OnOutputRendered(
+        outBuffer.GetData(),
+        outBuffer.GetNChannels(),
+        outBuffer.GetNFrames(),
+        m_SampleRate);
+    m_CallbackBusyNs.fetch_add(
+      GOSoundThread::getTimeNs() - startTime, std::memory_order_relaxed);
   } else
     outBuffer.FillWithSilence();
 }
@@ -420,9 +493,45 @@ static void atomic_fetch_max_relaxed(std::atomic<T> &maxValue, T value) {
     ;
 }
 
+void GOSoundOrganEngine::UpdateActiveThreads(int64_t callbackBusyNs) {
+  int64_t busyNs = callbackBusyNs;
+  unsigned nWakeups = 0;
+  unsigned nSteals = 0;
+  unsigned nIdleWakeups = 0;
+
+  for (auto &pThread : mp_threads) {
+    const GOSoundThread::Counters counters = pThread->FetchCounters();
+
+    nWakeups += counters.m_NWakeups;
+    nSteals += counters.m_NSteals;
+    nIdleWakeups += counters.m_NIdleWakeups;
+    busyNs += counters.m_BusyNs;
+  }
+  m_LastNWakeups.store(nWakeups, std::memory_order_relaxed);
+  m_LastNSteals.store(nSteals, std::memory_order_relaxed);
+  m_LastNIdleWakeups.store(nIdleWakeups, std::memory_order_relaxed);
+
+  const unsigned nThreads = mp_threads.size();
+  unsigned nActiveThreads = nThreads;
+
+  if (m_IsAdaptiveThreadCount && nThreads) {
+    const double periodNs = 1e9 * m_NSamplesPerBuffer / m_SampleRate;
+
+    nActiveThreads = m_ThreadCountControl.Update(
+      (float)(busyNs / periodNs), m_SamplerPool.UsedSamplerCount());
+  }
+  m_NActiveThreads.store(nActiveThreads, std::memory_order_relaxed);
+}
+
 void GOSoundOrganEngine::NextPeriod() {
   assert(IsWorking());
+
+  const int64_t startTime = GOSoundThread::getTimeNs();
+
   m_Scheduler.Exec();
+  UpdateActiveThreads(
+    m_CallbackBusyNs.exchange(0, std::memory_order_relaxed)
+    + GOSoundThread::getTimeNs() - startTime);
 
   m_CurrentTime += m_NSamplesPerBuffer;
   atomic_fetch_max_relaxed(m_UsedPolyphony, m_SamplerPool.UsedSamplerCount());
@@ -450,8 +559,11 @@ void GOSoundOrganEngine::NextPeriod() {
 }
 
 void GOSoundOrganEngine::WakeupThreads() {
-  for (auto &pThread : mp_threads)
-    pThread->Wakeup();
+  const unsigned nActiveThreads
+    = m_NActiveThreads.load(std::memory_order_relaxed);
+
+  for (unsigned threadI = 0; threadI < nActiveThreads; threadI++)
+    mp_threads[threadI]->Wakeup();
 }
 
 /*
@@ -468,10 +580,10 @@ float GOSoundOrganEngine::GetRandomFactor() const {
   float result = 1;
 
   if (m_IsRandomizeSpeaking) {
-    const double factor = (pow(2, 1.0 / 1200.0) - 1) / (RAND_MAX / 2);
-    int num = rand() - RAND_MAX / 2;
+    // up to one cent in both directions
+    static const float factor = pow(2, 1.0 / 1200.0) - 1;
 
-    result = 1 + num * factor;
+    result = 1 + GORandom::nextSigned() * factor;
   }
   return result;
 }
@@ -505,6 +617,11 @@ bool GOSoundOrganEngine::ProcessSampler(
   const bool process_sampler = (sampler->time <= m_CurrentTime);
 
   if (process_sampler) {
+    // ReadBlock may reset p_SoundProvider at the end of the sample
+    const GOSoundProvider *pProvider = sampler->p_SoundProvider;
+    const int64_t startNs
+      = m_IsRenderTimeMeasured ? GOSoundLatencyProbe::getTimeNs() : 0;
+
     if (sampler->is_release &&
         ((m_IsPolyphonyLimiting &&
           m_SamplerPool.UsedSamplerCount() >= m_PolyphonySoftLimit &&
@@ -534,6 +651,9 @@ bool GOSoundOrganEngine::ProcessSampler(
     for (unsigned i = 0; i < n_frames * 2; i++)
       output_buffer[i] += temp[i];
 
+    if (m_IsRenderTimeMeasured && pProvider)
+      pProvider->AddRenderedPeriod(GOSoundLatencyProbe::getTimeNs() - startNs);
+
     if (
       (sampler->stop && sampler->stop <= m_CurrentTime)
       || (sampler->new_attack && sampler->new_attack <= m_CurrentTime)) {
@@ -612,6 +732,8 @@ GOSoundSampler *GOSoundOrganEngine::CreateTaskSample(
       sampler->m_SamplerTaskId = samplerTaskId;
       sampler->m_AudioGroupId = audioGroup;
       StartSampler(sampler);
+      if (!isRelease && samplerTaskId >= 0)
+        GOSoundLatencyProbe::getInstance().OnSamplerStarted();
     }
   }
   return sampler;
@@ -747,8 +869,9 @@ void GOSoundOrganEngine::CreateReleaseSampler(GOSoundSampler *handle) {
            * time_to_full_reverb is around 350 ms; for an organ with a release
            * length of 1 second or less, time_to_full_reverb is around 100 ms;
            * time_to_full_reverb is linear in between */
-          int time_to_full_reverb = ((60 * release_section->GetLength())
-                                     / release_section->GetSampleRate())
+          int time_to_full_reverb
+            = ((60 * release_section->GetUntruncatedLength())
+               / release_section->GetSampleRate())
             + 40;
           if (time_to_full_reverb > 350)
             time_to_full_reverb = 350;
@@ -862,6 +985,17 @@ void GOSoundOrganEngine::UpdateVelocity(
  * Other functions
  */
 
+GOSoundOrganEngine::WorkerStats GOSoundOrganEngine::GetLastPeriodWorkerStats()
+  const {
+  WorkerStats stats;
+
+  stats.m_NActiveThreads = m_NActiveThreads.load(std::memory_order_relaxed);
+  stats.m_NWakeups = m_LastNWakeups.load(std::memory_order_relaxed);
+  stats.m_NSteals = m_LastNSteals.load(std::memory_order_relaxed);
+  stats.m_NIdleWakeups = m_LastNIdleWakeups.load(std::memory_order_relaxed);
+  return stats;
+}
+
 std::vector<float> GOSoundOrganEngine::GetMeterInfo() {
   // GUI thread: m_LifecycleMutex prevents concurrent BuildEngine/DestroyEngine
   // from modifying m_MeterInfo while we read it.
@@ -19,6 +19,7 @@
 #include "playing/GOSoundSamplerPool.h"
 #include "reverb/GOSoundReverb.h"
 #include "scheduler/GOSoundScheduler.h"
+#include "scheduler/GOSoundThreadCountControl.h"
 
 #include "GOSoundOrganInterface.h"
 
@@ -28,6 +29,7 @@ class GOOrganModel;
 class GOSoundBufferMutable;
 class GOSoundGroupTask;
 class GOSoundOutputTask;
+class GOSoundReverbTask;
 class GOSoundProvider;
 class GOSoundRecorder;
 class GOSoundReleaseTask;
@@ -67,6 +69,19 @@ public:
     std::vector<std::vector<float>> scaleFactors;
   };
 
+  /**
+   * @brief Activity of the worker threads during the last period.
+   */
+  struct WorkerStats {
+    unsigned m_NActiveThreads;
+    // how many times the workers started looking for work
+    unsigned m_NWakeups;
+    // how many task groups the workers have taken from the scheduler
+    unsigned m_NSteals;
+    // how many wakeups have not found any work
+    unsigned m_NIdleWakeups;
+  };
+
   /*
    * Factory functions
    */
@@ -91,6 +106,8 @@ public:
 
 private:
   static constexpr int DETACHED_RELEASE_TASK_ID = 0;
+  // how long the load must stay low before a worker thread is parked
+  static constexpr unsigned THREAD_PARKING_DELAY_MS = 500;
 
   /*
    * Constructor constants: objects that live for the entire instance lifetime
@@ -112,6 +129,8 @@ private:
 
   unsigned m_NAudioGroups;
   unsigned m_NAuxThreads;
+  // whether to wake up only as many threads as the load requires
+  bool m_IsAdaptiveThreadCount;
   bool m_IsDownmix;
   unsigned m_NReleaseRepeats;
   bool m_IsPolyphonyLimiting;
@@ -119,6 +138,8 @@ private:
   bool m_IsScaledReleases;
   bool m_IsReleaseAlignmentEnabled;
   bool m_IsRandomizeSpeaking;
+  // whether the render time of each sampler is accounted to its provider
+  bool m_IsRenderTimeMeasured;
   // TODO: rename to m_gain (stores gain in dB; in GrandOrgue "gain" means dB)
   int m_volume;
   // TODO: rename to m_amplitude (stores the linear amplitude coefficient
@@ -173,10 +194,14 @@ private:
   // [B5] p_AudioRecorder: non-owning pointer to the recorder passed in
   //   — uses mp_DownmixTask [B4] or mp_AudioOutputTasks [B2]
   GOSoundRecorder *p_AudioRecorder;
-  // [B6] reverb: set up inline on mp_DownmixTask [B4] and mp_AudioOutputTasks
-  // [B2]
-  //   — uses m_ReverbConfig, m_SampleRate, m_NSamplesPerBuffer
-  //
+  // [B6] mp_ReverbTasks: the reverb of the audio groups used by any output.
+  // Built when the used groups have no more channels than mp_AudioOutputTasks
+  // [B2] and mp_DownmixTask [B4] together, otherwise the reverb is set up
+  // inline on each of them
+  //   — uses mp_AudioGroupTasks [B1], m_ReverbConfig, m_SampleRate,
+  //     m_NSamplesPerBuffer
+  //   — replaces the groups in SetOutputs() of [B2] and [B4]
+  std::vector<std::unique_ptr<GOSoundReverbTask>> mp_ReverbTasks;
   // [B7] mp_TremulantTasks: one per tremulant in r_OrganModel
   //   — referenced by mp_WindchestTasks after [B9] Init()
   ptr_vector<GOSoundTremulantTask> mp_TremulantTasks;
@@ -200,6 +225,16 @@ private:
   GOSoundSamplerPool m_SamplerPool;
   std::atomic_uint m_UsedPolyphony;
 
+  // audio thread only: how many of mp_threads are woken up every period
+  GOSoundThreadCountControl m_ThreadCountControl;
+  std::atomic_uint m_NActiveThreads;
+  // the time spent by the audio callbacks on the current period
+  std::atomic<int64_t> m_CallbackBusyNs;
+  // the worker activity of the last period
+  std::atomic_uint m_LastNWakeups;
+  std::atomic_uint m_LastNSteals;
+  std::atomic_uint m_LastNIdleWakeups;
+
   /*
    * Private lifecycle functions (callee first)
    */
@@ -224,6 +259,12 @@ private:
 
   unsigned SamplesDiffToMs(uint64_t fromSamples, uint64_t toSamples) const;
 
+  /**
+   * Collects the worker counters of the finished period and decides how many
+   * worker threads to wake up for the next one. Called from NextPeriod()
+   */
+  void UpdateActiveThreads(int64_t callbackBusyNs);
+
   inline static unsigned isWindchestTask(int taskId) { return taskId >= 0; }
 
   inline static unsigned windchestTaskToIndex(int taskId) {
@@ -279,6 +320,11 @@ public:
   unsigned GetNAuxThreads() const { return m_NAuxThreads; }
   void SetNAuxThreads(unsigned nAuxThreads) { m_NAuxThreads = nAuxThreads; }
 
+  bool IsAdaptiveThreadCount() const { return m_IsAdaptiveThreadCount; }
+  void SetAdaptiveThreadCount(bool isAdaptive) {
+    m_IsAdaptiveThreadCount = isAdaptive;
+  }
+
   bool IsDownmix() const { return m_IsDownmix; }
   void SetDownmix(bool isDownmix) { m_IsDownmix = isDownmix; }
 
@@ -323,6 +369,11 @@ public:
     m_IsRandomizeSpeaking = isEnabled;
   }
 
+  bool IsRenderTimeMeasured() const { return m_IsRenderTimeMeasured; }
+  void SetRenderTimeMeasured(bool isMeasured) {
+    m_IsRenderTimeMeasured = isMeasured;
+  }
+
   GOSoundResample::InterpolationType GetInterpolationType() const {
     return m_InterpolationType;
   }
@@ -348,6 +399,9 @@ public:
   std::vector<float> GetMeterInfo();
   GOSoundScheduler &GetScheduler() { return m_Scheduler; }
 
+  /** May be called from any thread. */
+  WorkerStats GetLastPeriodWorkerStats() const;
+
   /*
    * Lifecycle state
    */
@@ -447,7 +501,10 @@ public:
     unsigned outputIndex, bool isLast, GOSoundBufferMutable &outBuffer);
   void NextPeriod();
 
-  /** Wake up all worker threads. Called from the audio callback. */
+  /**
+   * Wake up the active worker threads. The parked ones are not woken up.
+   * Called from the audio callback.
+   */
   void WakeupThreads();
 
   bool ProcessSampler(
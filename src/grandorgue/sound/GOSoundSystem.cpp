@@ -17,6 +17,7 @@
 #include "ports/GOSoundPortFactory.h"
 #include "threading/GOMultiMutexLocker.h"
 #include "threading/GOMutexLocker.h"
+#include "threading/GORealtimeLog.h"
 
 #include "GOEvent.h"
 #include "GOOrganController.h"
@@ -240,15 +241,18 @@ bool GOSoundSystem::AudioCallback(
       m_NCallbacksEntered.fetch_add(1);
       wasEntered = true;
     } else
-      wxLogError(
-        _("No sound output will happen. Samples per buffer has been "
-          "changed by the sound driver to %d"),
+      GO_RT_LOG_ERROR(
+        wxTRANSLATE("No sound output will happen. Samples per buffer has been "
+                    "changed by the sound driver to %d"),
         nSamples);
   }
   // assure that IsUsed has not yet been changed after
   // m_NCallbacksEntered.fetch_add, otherwise the control thread may not wait
   if (wasEntered && pEngine && pEngine->IsUsed()) {
     GOSoundOutput &device = m_AudioOutputs[devIndex];
+
+    device.heartbeat.Beat();
+
     GOMutexLocker locker(device.mutex);
 
     while (device.wait && device.waiting)
@@ -275,6 +279,7 @@ bool GOSoundSystem::AudioCallback(
         m_AudioOutputs[i].condition.Signal();
       }
     }
+    device.heartbeat.Idle();
   } else
     outBuffer.FillWithSilence();
   if (
@@ -17,6 +17,7 @@
 #include "midi/GOMidiSystem.h"
 #include "threading/GOCondition.h"
 #include "threading/GOMutex.h"
+#include "threading/GOThreadWatchdog.h"
 
 #include "ptrvector.h"
 
@@ -40,19 +41,24 @@ class GOSoundPort;
 class GOSoundSystem {
   class GOSoundOutput {
   public:
+    static constexpr const char *HEARTBEAT_NAME
+      = "GOSoundSystem::AudioCallback";
+
     GOSoundPort *port;
     GOMutex mutex;
     GOCondition condition;
     bool wait;
     bool waiting;
+    GOThreadWatchdog::Heartbeat heartbeat;
 
-    GOSoundOutput() : condition(mutex) {
+    GOSoundOutput() : condition(mutex), heartbeat(HEARTBEAT_NAME) {
       port = 0;
       wait = false;
       waiting = false;
     }
 
-    GOSoundOutput(const GOSoundOutput &old) : condition(mutex) {
+    GOSoundOutput(const GOSoundOutput &old)
+      : condition(mutex), heartbeat(HEARTBEAT_NAME) {
       port = old.port;
       wait = old.wait;
       waiting = old.waiting;
@@ -7,6 +7,8 @@
 
 #include "GOSoundAudioSection.h"
 
+#include <cstring>
+
 #include <wx/intl.h>
 #include <wx/log.h>
 
@@ -15,9 +17,12 @@
 
 #include "loader/GOLoaderFilename.h"
 #include "model/GOCacheObject.h"
+#include "threading/GORealtimeLog.h"
 
 #include "GOAlloc.h"
+#include "GOCacheRecord.h"
 #include "GOMemoryPool.h"
+#include "GORandom.h"
 #include "GOSampleStatistic.h"
 #include "GOSoundCompressionCache.h"
 #include "GOSoundReleaseAlignTable.h"
@@ -41,14 +46,45 @@ GOSoundAudioSection::GOSoundAudioSection(GOMemoryPool &pool)
   ClearData();
 }
 
+GOSoundAudioSection::GOSoundAudioSection(GOSoundAudioSection &&other) noexcept
+  : m_StartSegments(std::move(other.m_StartSegments)),
+    m_EndSegments(std::move(other.m_EndSegments)),
+    m_data(other.m_data),
+    m_ReleaseAligner(other.m_ReleaseAligner),
+    m_ReleaseStartSegment(other.m_ReleaseStartSegment),
+    m_SampleFracBits(other.m_SampleFracBits),
+    m_SampleCount(other.m_SampleCount),
+    m_SampleRate(other.m_SampleRate),
+    m_TruncatedSampleCount(other.m_TruncatedSampleCount),
+    m_BitsPerSample(other.m_BitsPerSample),
+    m_BytesPerSample(other.m_BytesPerSample),
+    m_channels(other.m_channels),
+    m_WaveTremulantStateFor(other.m_WaveTremulantStateFor),
+    m_IsCompressed(other.m_IsCompressed),
+    m_IsMidSide(other.m_IsMidSide),
+    m_Pool(other.m_Pool),
+    m_AllocSize(other.m_AllocSize),
+    m_MaxAmplitude(other.m_MaxAmplitude),
+    m_MaxAbsAmplitude(other.m_MaxAbsAmplitude),
+    m_MaxAbsDerivative(other.m_MaxAbsDerivative),
+    m_ReleaseCrossfadeLength(other.m_ReleaseCrossfadeLength) {
+  // the other section must not free the data taken
+  other.m_data = NULL;
+  other.m_ReleaseAligner = NULL;
+  other.m_EndSegments.clear();
+  other.ClearData();
+}
+
 void GOSoundAudioSection::ClearData() {
   m_AllocSize = 0;
   m_SampleCount = 0;
   m_SampleRate = 0;
+  m_TruncatedSampleCount = 0;
   m_BitsPerSample = 0;
   m_BytesPerSample = 0;
   m_WaveTremulantStateFor = BOOL3_DEFAULT;
   m_IsCompressed = false;
+  m_IsMidSide = false;
   m_channels = 0;
   if (m_data) {
     m_Pool.Free(m_data);
@@ -69,53 +105,77 @@ void GOSoundAudioSection::ClearData() {
 }
 
 bool GOSoundAudioSection::LoadCache(GOCache &cache) {
-  if (!cache.Read(&m_AllocSize, sizeof(m_AllocSize)))
-    return false;
-  if (!cache.Read(&m_SampleCount, sizeof(m_SampleCount)))
-    return false;
-  if (!cache.Read(&m_SampleRate, sizeof(m_SampleRate)))
-    return false;
-  if (!cache.Read(&m_BitsPerSample, sizeof(m_BitsPerSample)))
-    return false;
-  if (!cache.Read(&m_BytesPerSample, sizeof(m_BytesPerSample)))
-    return false;
-  if (!cache.Read(&m_WaveTremulantStateFor, sizeof(m_WaveTremulantStateFor)))
-    return false;
-  if (!cache.Read(&m_IsCompressed, sizeof(m_IsCompressed)))
-    return false;
-  if (!cache.Read(&m_channels, sizeof(m_channels)))
-    return false;
-  if (!cache.Read(&m_SampleFracBits, sizeof(m_SampleFracBits)))
-    return false;
-  if (!cache.Read(&m_MaxAmplitude, sizeof(m_MaxAmplitude)))
-    return false;
-  if (!cache.Read(&m_ReleaseStartSegment, sizeof(m_ReleaseStartSegment)))
+  GOCacheRecord record;
+  unsigned nStartSegments;
+
+  if (
+    !cache.ReadRecord(record) || !record.GetUInt(m_AllocSize)
+    || !record.GetUInt(m_SampleCount) || !record.GetUInt(m_SampleRate)
+    || !record.GetUInt(m_TruncatedSampleCount)
+    || !record.GetUInt(m_SampleFracBits) || !record.GetUInt(m_MaxAmplitude)
+    || !record.GetUInt(m_ReleaseStartSegment)
+    || !record.GetUInt(m_ReleaseCrossfadeLength)
+    || !record.GetUInt(m_BitsPerSample) || !record.GetUInt(m_BytesPerSample)
+    || !record.GetUInt(m_channels) || !record.GetBool3(m_WaveTremulantStateFor)
+    || !record.GetBool(m_IsCompressed) || !record.GetBool(m_IsMidSide)
+    || !record.GetUInt(nStartSegments))
     return false;
-  if (!cache.Read(&m_ReleaseCrossfadeLength, sizeof(m_ReleaseCrossfadeLength)))
+  if (m_channels > MAX_OUTPUT_CHANNELS)
     return false;
-  m_data = (unsigned char *)cache.ReadBlock(m_AllocSize);
-  if (!m_data)
+
+  m_StartSegments.resize(nStartSegments);
+  for (StartSegment &s : m_StartSegments) {
+    uint32_t ptrOffset;
+
+    if (
+      !record.GetUInt(s.start_offset) || !record.GetUInt(s.cache.m_position))
+      return false;
+    for (unsigned j = 0; j < m_channels; j++)
+      if (
+        !record.GetInt(s.cache.m_value[j]) || !record.GetInt(s.cache.m_last[j])
+        || !record.GetInt(s.cache.m_prev[j]))
+        return false;
+    if (!record.GetUInt(ptrOffset))
+      return false;
+    // the compression cache keeps the offset in the data until it is played
+    s.cache.m_ptr = (const unsigned char *)(intptr_t)ptrOffset;
+  }
+
+  unsigned nEndSegments;
+
+  if (!record.GetUInt(nEndSegments))
     return false;
 
-  unsigned temp;
-  if (!cache.Read(&temp, sizeof(temp)))
+  std::vector<EndSegmentDescription> endDescriptions(nEndSegments);
+
+  for (EndSegmentDescription &description : endDescriptions)
+    if (
+      !record.GetUInt(description.end_pos)
+      || !record.GetUInt(description.transition_offset)
+      || !record.GetUInt(description.end_size)
+      || !record.GetInt(description.next_start_segment_index))
+      return false;
+
+  bool hasReleaseAligner;
+
+  if (!record.GetBool(hasReleaseAligner))
     return false;
-  for (unsigned i = 0; i < temp; i++) {
-    StartSegment s;
-    if (!cache.Read(&s, sizeof(s)))
+  m_ReleaseAligner = NULL;
+  if (hasReleaseAligner) {
+    m_ReleaseAligner = new GOSoundReleaseAlignTable();
+    if (!m_ReleaseAligner->Load(record))
       return false;
-    m_StartSegments.push_back(s);
   }
 
-  if (!cache.Read(&temp, sizeof(temp)))
+  m_data = (unsigned char *)cache.ReadBlock(m_AllocSize);
+  if (!m_data)
     return false;
-  for (unsigned i = 0; i < temp; i++) {
+
+  m_EndSegments.reserve(nEndSegments);
+  for (const EndSegmentDescription &description : endDescriptions) {
     EndSegment s;
 
-    if (!cache.Read(
-          static_cast<EndSegmentDescription *>(&s),
-          sizeof(EndSegmentDescription)))
-      return false;
+    static_cast<EndSegmentDescription &>(s) = description;
     s.end_data = (unsigned char *)cache.ReadBlock(s.end_size);
     if (!s.end_data)
       return false;
@@ -124,87 +184,65 @@ bool GOSoundAudioSection::LoadCache(GOCache &cache) {
     m_EndSegments.push_back(s);
   }
 
-  bool load_align_tracker;
-  if (!cache.Read(&load_align_tracker, sizeof(load_align_tracker)))
-    return false;
-  m_ReleaseAligner = NULL;
-  if (load_align_tracker) {
-    m_ReleaseAligner = new GOSoundReleaseAlignTable();
-    if (!m_ReleaseAligner->Load(cache))
-      return false;
-  }
-
   return true;
 }
 
 bool GOSoundAudioSection::SaveCache(GOCacheWriter &cache) const {
-  if (!cache.Write(&m_AllocSize, sizeof(m_AllocSize)))
-    return false;
-  if (!cache.Write(&m_SampleCount, sizeof(m_SampleCount)))
-    return false;
-  if (!cache.Write(&m_SampleRate, sizeof(m_SampleRate)))
-    return false;
-  if (!cache.Write(&m_BitsPerSample, sizeof(m_BitsPerSample)))
-    return false;
-  if (!cache.Write(&m_BytesPerSample, sizeof(m_BytesPerSample)))
-    return false;
-  if (!cache.Write(&m_WaveTremulantStateFor, sizeof(m_WaveTremulantStateFor)))
-    return false;
-  if (!cache.Write(&m_IsCompressed, sizeof(m_IsCompressed)))
-    return false;
-  if (!cache.Write(&m_channels, sizeof(m_channels)))
-    return false;
-  if (!cache.Write(&m_SampleFracBits, sizeof(m_SampleFracBits)))
-    return false;
-  if (!cache.Write(&m_MaxAmplitude, sizeof(m_MaxAmplitude)))
-    return false;
-  if (!cache.Write(&m_ReleaseStartSegment, sizeof(m_ReleaseStartSegment)))
-    return false;
-  if (!cache.Write(&m_ReleaseCrossfadeLength, sizeof(m_ReleaseCrossfadeLength)))
-    return false;
-  if (!cache.WriteBlock(m_data, m_AllocSize))
-    return false;
-
-  unsigned temp;
-
-  temp = m_StartSegments.size();
-  if (!cache.Write(&temp, sizeof(unsigned)))
-    return false;
-  for (unsigned i = 0; i < temp; i++) {
-    const StartSegment *s = &m_StartSegments[i];
-    if (!cache.Write(s, sizeof(*s)))
-      return false;
+  GOCacheRecord record;
+
+  record.PutUInt(m_AllocSize);
+  record.PutUInt(m_SampleCount);
+  record.PutUInt(m_SampleRate);
+  record.PutUInt(m_TruncatedSampleCount);
+  record.PutUInt(m_SampleFracBits);
+  record.PutUInt(m_MaxAmplitude);
+  record.PutUInt(m_ReleaseStartSegment);
+  record.PutUInt(m_ReleaseCrossfadeLength);
+  record.PutUInt(m_BitsPerSample);
+  record.PutUInt(m_BytesPerSample);
+  record.PutUInt(m_channels);
+  record.PutInt(m_WaveTremulantStateFor);
+  record.PutBool(m_IsCompressed);
+  record.PutBool(m_IsMidSide);
+  record.PutUInt(m_StartSegments.size());
+  for (const StartSegment &s : m_StartSegments) {
+    record.PutUInt(s.start_offset);
+    record.PutUInt(s.cache.m_position);
+    for (unsigned j = 0; j < m_channels; j++) {
+      record.PutInt(s.cache.m_value[j]);
+      record.PutInt(s.cache.m_last[j]);
+      record.PutInt(s.cache.m_prev[j]);
+    }
+    record.PutUInt((uint32_t)(intptr_t)s.cache.m_ptr);
   }
-
-  temp = m_EndSegments.size();
-  if (!cache.Write(&temp, sizeof(temp)))
+  record.PutUInt(m_EndSegments.size());
+  for (const EndSegment &s : m_EndSegments) {
+    record.PutUInt(s.end_pos);
+    record.PutUInt(s.transition_offset);
+    record.PutUInt(s.end_size);
+    record.PutInt(s.next_start_segment_index);
+  }
+  record.PutBool(m_ReleaseAligner != NULL);
+  if (m_ReleaseAligner)
+    m_ReleaseAligner->Save(record);
+  if (!cache.WriteRecord(record))
     return false;
-  for (unsigned i = 0; i < temp; i++) {
-    const EndSegment &s = m_EndSegments[i];
 
-    if (!cache.Write(
-          static_cast<const EndSegmentDescription *>(&s),
-          sizeof(EndSegmentDescription)))
-      return false;
-    if (!cache.WriteBlock(s.end_data, s.end_size))
-      return false;
-  }
+  // the compressed samples are not PCM, so the delta filter is useless for them
+  const unsigned stride = m_IsCompressed ? 0 : m_BytesPerSample * m_channels;
 
-  const bool save_align_tracker = (m_ReleaseAligner != NULL);
-  if (!cache.Write(&save_align_tracker, sizeof(save_align_tracker)))
+  if (!cache.WriteBlock(m_data, m_AllocSize, stride))
     return false;
-
-  if (save_align_tracker) {
-    if (!m_ReleaseAligner->Save(cache))
+  for (const EndSegment &s : m_EndSegments)
+    if (!cache.WriteBlock(s.end_data, s.end_size, stride))
       return false;
-  }
 
   return true;
 }
 
 unsigned GOSoundAudioSection::PickEndSegment(
   unsigned start_segment_index) const {
-  const unsigned x = abs(rand());
+  const unsigned x = GORandom::next();
   for (unsigned i = 0; i < m_EndSegments.size(); i++) {
     const unsigned idx = (i + x) % m_EndSegments.size();
     const EndSegment *end = &m_EndSegments[idx];
@@ -308,6 +346,32 @@ void GOSoundAudioSection::DoCrossfade(
     }
 }
 
+void GOSoundAudioSection::fadeOut(
+  void *pcmData,
+  GOWave::SAMPLE_FORMAT format,
+  unsigned channels,
+  unsigned nbSamples,
+  unsigned fadeLength) {
+  const unsigned bitsPerSample = wave_bits_per_sample(format);
+  unsigned char *data = (unsigned char *)pcmData;
+
+  if (fadeLength > nbSamples)
+    fadeLength = nbSamples;
+  for (unsigned pos = nbSamples - fadeLength; pos < nbSamples; pos++) {
+    // the factor is 0 just after the last sample
+    const float factor = (float)(nbSamples - pos) / (fadeLength + 1);
+
+    for (uint8_t j = 0; j < channels; j++)
+      setSampleData(
+        data,
+        pos,
+        channels,
+        j,
+        bitsPerSample,
+        (int)(getSampleData(data, pos, channels, j, bitsPerSample) * factor));
+  }
+}
+
 void GOSoundAudioSection::Setup(
   const GOCacheObject *pObjectFor,
   const GOLoaderFilename *pLoaderFilename,
@@ -320,7 +384,8 @@ void GOSoundAudioSection::Setup(
   GOBool3 waveTremulantStateFor,
   bool compress,
   unsigned loopCrossfadeLength,
-  unsigned releaseCrossfadeLength) {
+  unsigned releaseCrossfadeLength,
+  bool isMidSide) {
   if (pcm_data_channels < 1 || pcm_data_channels > 2)
     throw(wxString) _("< More than 2 channels in");
 
@@ -442,8 +507,11 @@ void GOSoundAudioSection::Setup(
         m_StartSegments.push_back(start_seg);
         m_EndSegments.push_back(end_seg);
       } else
-        wxLogWarning(GOCacheObject::generateMessage(
-          pObjectFor, pLoaderFilename, loopError));
+        // it is called from the loader threads
+        GORealtimeLog::getInstance().PostText(
+          wxLOG_Warning,
+          GOCacheObject::generateMessage(
+            pObjectFor, pLoaderFilename, loopError));
       if (!m_EndSegments.size())
         throw(wxString) _("No valid loops exist in the file");
     }
@@ -491,6 +559,7 @@ void GOSoundAudioSection::Setup(
   m_SampleCount = total_alloc_samples;
   m_SampleFracBits = m_BitsPerSample - 1;
   m_IsCompressed = false;
+  m_IsMidSide = false;
   m_WaveTremulantStateFor = waveTremulantStateFor;
 
   /* Store the main data blob. */
@@ -499,10 +568,10 @@ void GOSoundAudioSection::Setup(
   GetMaxAmplitudeAndDerivative();
 
   if (compress)
-    Compress(m_BitsPerSample > 16);
+    Compress(m_BitsPerSample > 16, isMidSide && m_channels == 2);
 }
 
-void GOSoundAudioSection::Compress(bool format16) {
+void GOSoundAudioSection::Compress(bool format16, bool isMidSide) {
   unsigned char *data = (unsigned char *)m_Pool.Alloc(m_AllocSize, false);
   if (data == NULL)
     throw GOOutOfMemory();
@@ -528,6 +597,13 @@ void GOSoundAudioSection::Compress(bool format16) {
     state.m_value[0] = GetSample(i, 0);
     if (m_channels > 1)
       state.m_value[1] = GetSample(i, 1);
+    if (isMidSide) {
+      const int left = state.m_value[0];
+      const int right = state.m_value[1];
+
+      state.m_value[0] = (left + right) >> 1;
+      state.m_value[1] = (left - right) >> 1;
+    }
 
     for (unsigned j = 0; j < m_channels; j++) {
       int val = state.m_value[j];
@@ -555,6 +631,7 @@ void GOSoundAudioSection::Compress(bool format16) {
   m_data = data;
   m_AllocSize = output_len;
   m_IsCompressed = true;
+  m_IsMidSide = isMidSide;
 
   m_data = (unsigned char *)m_Pool.MoveToPool(m_data, m_AllocSize);
   if (m_data == NULL)
@@ -602,6 +679,7 @@ GOSampleStatistic GOSoundAudioSection::GetStatistic() {
     size += m_EndSegments[i].end_size;
   stat.SetEndSegmentSize(size);
   stat.SetMemorySize(size + m_AllocSize);
+  stat.SetTruncatedSize((size_t)m_TruncatedSampleCount * m_BytesPerSample);
   stat.SetBitsPerSample(m_BitsPerSample, m_SampleCount, m_MaxAmplitude);
 
   return stat;
@@ -71,7 +71,13 @@ public:
   };
 
 private:
-  void Compress(bool format16);
+  /**
+   * Compresses the main data. If isMidSide then a stereo frame is stored as
+   * mid = (left + right) / 2 and side = (left - right) / 2. The side of a
+   * typical organ sample is small, so it takes fewer bytes than the right
+   * channel, and the lowest bit of the side is lost
+   */
+  void Compress(bool format16, bool isMidSide);
 
   void GetMaxAmplitudeAndDerivative();
 
@@ -99,6 +105,8 @@ private:
 
   unsigned m_SampleCount;
   unsigned m_SampleRate;
+  /* Number of samples cut off from the end at load time (release truncation) */
+  unsigned m_TruncatedSampleCount;
 
   /* Type of the data which is stored in the data pointer */
   uint8_t m_BitsPerSample;
@@ -107,6 +115,8 @@ private:
 
   GOBool3 m_WaveTremulantStateFor;
   bool m_IsCompressed;
+  /* The compressed data contains mid/side instead of left/right */
+  bool m_IsMidSide;
 
   /* Size of the section in BYTES */
   GOMemoryPool &m_Pool;
@@ -184,8 +194,16 @@ public:
   }
 
   GOSoundAudioSection(GOMemoryPool &pool);
+  /**
+   * Takes the data of the other section. Allows keeping the sections in one
+   * array
+   */
+  GOSoundAudioSection(GOSoundAudioSection &&other) noexcept;
+  GOSoundAudioSection(const GOSoundAudioSection &) = delete;
   ~GOSoundAudioSection() { ClearData(); }
 
+  const GOSoundAudioSection &operator=(const GOSoundAudioSection &) = delete;
+
   GOSoundReleaseAlignTable *GetReleaseAligner() const {
     return m_ReleaseAligner;
   }
@@ -195,6 +213,7 @@ public:
   uint8_t GetBytesPerSample() const { return m_BytesPerSample; }
   inline uint8_t GetChannels() const { return m_channels; }
   bool IsCompressed() const { return m_IsCompressed; }
+  bool IsMidSide() const { return m_IsMidSide; }
 
   inline GOBool3 GetWaveTremulantStateFor() const {
     return m_WaveTremulantStateFor;
@@ -202,6 +221,14 @@ public:
 
   inline unsigned GetLength() const { return m_SampleCount; }
 
+  /* The length of the section before truncation at load time */
+  unsigned GetUntruncatedLength() const {
+    return m_SampleCount + m_TruncatedSampleCount;
+  }
+  void SetTruncatedSampleCount(unsigned count) {
+    m_TruncatedSampleCount = count;
+  }
+
   unsigned GetReleaseCrossfadeLength() const {
     return m_ReleaseCrossfadeLength;
   }
@@ -222,6 +249,17 @@ public:
       sampleData, position, m_channels, channel, m_BitsPerSample);
   }
 
+  /**
+   * Fades out the last fadeLength samples of the pcm data in place. Used for
+   * baking a fade into truncated samples before Setup()
+   */
+  static void fadeOut(
+    void *pcmData,
+    GOWave::SAMPLE_FORMAT format,
+    unsigned channels,
+    unsigned nbSamples,
+    unsigned fadeLength);
+
   bool LoadCache(GOCache &cache);
   bool SaveCache(GOCacheWriter &cache) const;
 
@@ -237,7 +275,8 @@ public:
     GOBool3 waveTremulantStateFor,
     bool compress,
     unsigned loopCrossfadeLength,
-    unsigned releaseCrossfadeLength);
+    unsigned releaseCrossfadeLength,
+    bool isMidSide = false);
 
   inline bool IsOneshot() const {
     return (m_EndSegments.size() == 1)
@@ -262,7 +301,9 @@ public:
       assert(m_BitsPerSample >= 12);
       cache->DecompressTo(
         position, m_data, m_channels, (m_BitsPerSample >= 20));
-      return cache->m_value[channel];
+      return m_IsMidSide
+        ? GOSoundCompressionCache::fromMidSide(cache->m_value, channel)
+        : cache->m_value[channel];
     }
   }
 
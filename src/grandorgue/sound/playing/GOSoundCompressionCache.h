@@ -93,6 +93,14 @@ public:
     }
   }
 
+  /**
+   * Returns the sample of the channel of a frame stored as mid/side:
+   * left = mid + side, right = mid - side
+   */
+  static inline int fromMidSide(const int *values, unsigned channel) {
+    return channel ? values[0] - values[1] : values[0] + values[1];
+  }
+
   inline void Init() {
     m_position = 0;
     m_ptr = nullptr;
@@ -9,8 +9,7 @@
 
 #include <stdlib.h>
 
-#include "loader/cache/GOCache.h"
-#include "loader/cache/GOCacheWriter.h"
+#include "GOCacheRecord.h"
 
 #ifndef NDEBUG
 #ifdef PALIGN_DEBUG
@@ -26,14 +25,15 @@ GOSoundReleaseAlignTable::GOSoundReleaseAlignTable() {
 
 GOSoundReleaseAlignTable::~GOSoundReleaseAlignTable() {}
 
-bool GOSoundReleaseAlignTable::Load(GOCache &cache) {
-  if (!cache.Read(&m_PhaseAlignMaxAmplitude, sizeof(m_PhaseAlignMaxAmplitude)))
-    return false;
-  if (!cache.Read(
-        &m_PhaseAlignMaxDerivative, sizeof(m_PhaseAlignMaxDerivative)))
-    return false;
-  if (!cache.Read(&m_PositionEntries, sizeof(m_PositionEntries)))
+bool GOSoundReleaseAlignTable::Load(GOCacheRecord &record) {
+  if (
+    !record.GetInt(m_PhaseAlignMaxAmplitude)
+    || !record.GetInt(m_PhaseAlignMaxDerivative))
     return false;
+  for (auto &row : m_PositionEntries)
+    for (unsigned &entry : row)
+      if (!record.GetUInt(entry))
+        return false;
   return true;
 }
 
@@ -85,15 +85,12 @@ std::optional<GOSoundReleaseAlignTable::CellCoords> GOSoundReleaseAlignTable::
   return result;
 }
 
-bool GOSoundReleaseAlignTable::Save(GOCacheWriter &cache) {
-  if (!cache.Write(&m_PhaseAlignMaxAmplitude, sizeof(m_PhaseAlignMaxAmplitude)))
-    return false;
-  if (!cache.Write(
-        &m_PhaseAlignMaxDerivative, sizeof(m_PhaseAlignMaxDerivative)))
-    return false;
-  if (!cache.Write(&m_PositionEntries, sizeof(m_PositionEntries)))
-    return false;
-  return true;
+void GOSoundReleaseAlignTable::Save(GOCacheRecord &record) const {
+  record.PutInt(m_PhaseAlignMaxAmplitude);
+  record.PutInt(m_PhaseAlignMaxDerivative);
+  for (const auto &row : m_PositionEntries)
+    for (unsigned entry : row)
+      record.PutUInt(entry);
 }
 
 void GOSoundReleaseAlignTable::ComputeTable(
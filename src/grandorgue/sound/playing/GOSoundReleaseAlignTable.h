@@ -12,8 +12,7 @@
 
 #include "GOSoundAudioSection.h"
 
-class GOCache;
-class GOCacheWriter;
+class GOCacheRecord;
 class GOTestReleaseAlignTable;
 
 #define PHASE_ALIGN_DERIVATIVES 2
@@ -66,8 +65,8 @@ public:
   GOSoundReleaseAlignTable();
   ~GOSoundReleaseAlignTable();
 
-  bool Load(GOCache &cache);
-  bool Save(GOCacheWriter &cache);
+  bool Load(GOCacheRecord &record);
+  void Save(GOCacheRecord &record) const;
 
   void ComputeTable(
     const GOSoundAudioSection &m_release,
@@ -7,7 +7,7 @@
 
 #include "GOSoundStream.h"
 
-#include <wx/log.h>
+#include "threading/GORealtimeLog.h"
 
 #include "GOSoundAudioSection.h"
 #include "GOSoundReleaseAlignTable.h"
@@ -23,7 +23,7 @@ public:
       (SampleT *)stream.ptr) {}
 };
 
-template <bool format16, uint8_t nChannels>
+template <bool format16, uint8_t nChannels, bool isMidSide>
 class GOSoundStream::StreamCacheWindow
   : public GOSoundResample::FloatingSampleVector<nChannels> {
 private:
@@ -31,6 +31,11 @@ private:
   uint8_t m_ChannelN;
   enum { PREV, VALUE, ZERO } m_curr;
 
+  inline int GetChannelValue(const int *values) const {
+    return isMidSide ? GOSoundCompressionCache::fromMidSide(values, m_ChannelN)
+                     : values[m_ChannelN];
+  }
+
 public:
   inline StreamCacheWindow(GOSoundStream &stream) : r_cache(stream.cache) {}
 
@@ -46,10 +51,10 @@ public:
     int res;
 
     if (m_curr == PREV) {
-      res = r_cache.m_prev[m_ChannelN];
+      res = GetChannelValue(r_cache.m_prev);
       m_curr = VALUE;
     } else if (m_curr == VALUE) {
-      res = r_cache.m_value[m_ChannelN];
+      res = GetChannelValue(r_cache.m_value);
       m_curr = ZERO;
     } else
       res = 0;
@@ -57,7 +62,11 @@ public:
   }
 };
 
-template <bool format16, unsigned windowLen, uint8_t nChannels>
+template <
+  bool format16,
+  unsigned windowLen,
+  uint8_t nChannels,
+  bool isMidSide>
 class GOSoundStream::StreamCacheReadAheadWindow
   : public GOSoundResample::PtrSampleVector<int, int, nChannels> {
 private:
@@ -99,8 +108,12 @@ public:
         if (lastDecompressedPos >= index) {
           const int *pRead = r_cache.m_value;
 
-          for (uint8_t i = nChannels; i > 0; i--)
-            *(pWrite1++) = *(pWrite2++) = *(pRead++);
+          if (isMidSide) {
+            *(pWrite1++) = *(pWrite2++) = pRead[0] + pRead[1];
+            *(pWrite1++) = *(pWrite2++) = pRead[0] - pRead[1];
+          } else
+            for (uint8_t i = nChannels; i > 0; i--)
+              *(pWrite1++) = *(pWrite2++) = *(pRead++);
           /* because stream.m_ReadAheadBuffer is a ring buffer of a double
            * windowLen, pWrite2 may move out of the buffer. Reset it to the
            * buffer begin, so pWrite pointers would swap */
@@ -134,6 +147,7 @@ GOSoundStream::DecodeBlockFunction GOSoundStream::getDecodeBlockFunction(
   uint8_t nChannels,
   uint8_t nBitsPerSoundItem,
   bool isCompressed,
+  bool isMidSide,
   GOSoundResample::InterpolationType interpolationType) {
 
   if (interpolationType == GOSoundResample::GO_POLYPHASE_INTERPOLATION) {
@@ -155,6 +169,24 @@ GOSoundStream::DecodeBlockFunction GOSoundStream::getDecodeBlockFunction(
             false,
             GOSoundResample::PolyphaseResampler::VECTOR_LENGTH,
             1>>;
+      } else if (nChannels == 2 && isMidSide) {
+        if (nBitsPerSoundItem >= 20)
+          return &GOSoundStream::DecodeBlock<
+            GOSoundResample::PolyphaseResampler,
+            StreamCacheReadAheadWindow<
+              true,
+              GOSoundResample::PolyphaseResampler::VECTOR_LENGTH,
+              2,
+              true>>;
+
+        assert(nBitsPerSoundItem >= 12);
+        return &GOSoundStream::DecodeBlock<
+          GOSoundResample::PolyphaseResampler,
+          StreamCacheReadAheadWindow<
+            false,
+            GOSoundResample::PolyphaseResampler::VECTOR_LENGTH,
+            2,
+            true>>;
       } else if (nChannels == 2) {
         if (nBitsPerSoundItem >= 20)
           return &GOSoundStream::DecodeBlock<
@@ -216,6 +248,16 @@ GOSoundStream::DecodeBlockFunction GOSoundStream::getDecodeBlockFunction(
         return &GOSoundStream::DecodeBlock<
           GOSoundResample::LinearResampler,
           StreamCacheWindow<false, 1>>;
+      } else if (nChannels == 2 && isMidSide) {
+        if (nBitsPerSoundItem >= 20)
+          return &GOSoundStream::DecodeBlock<
+            GOSoundResample::LinearResampler,
+            StreamCacheWindow<true, 2, true>>;
+
+        assert(nBitsPerSoundItem >= 12);
+        return &GOSoundStream::DecodeBlock<
+          GOSoundResample::LinearResampler,
+          StreamCacheWindow<false, 2, true>>;
       } else if (nChannels == 2) {
         if (nBitsPerSoundItem >= 20)
           return &GOSoundStream::DecodeBlock<
@@ -271,6 +313,8 @@ GOSoundStream::DecodeBlockFunction GOSoundStream::getDecodeBlockFunctionFor(
     pSection->GetChannels(),
     pSection->GetBitsPerSample(),
     isCompressed,
+    // only the compressed data may be stored as mid/side
+    isCompressed && pSection->IsMidSide(),
     interpolationType);
 }
 
@@ -393,7 +437,7 @@ bool GOSoundStream::ReadBlock(float *buffer, unsigned int n_blocks) {
       m_ResamplingPos.SetIndex(newSrcOffset);
       if (newSrcOffset >= end_pos) { // invalid loop. Using it might cause
                                      // infinite iterations here
-        wxLogError(
+        GO_RT_LOG_ERROR(
           "GOSoundStream::ReadBlock: Breaking invalid loop: start_offset=%d, "
           "end_pos=%d, new_pos=%d",
           startOffset,
@@ -436,7 +480,9 @@ void GOSoundStream::GetHistory(
 
     for (unsigned i = 0; i < BLOCK_HISTORY; i++) {
       for (uint8_t j = 0; j < nChannels; j++)
-        history[i][j] = tmpCache.m_value[j];
+        history[i][j] = audio_section->IsMidSide()
+          ? GOSoundCompressionCache::fromMidSide(tmpCache.m_value, j)
+          : tmpCache.m_value[j];
       tmpCache.DecompressionStep(
         nChannels, audio_section->GetBitsPerSample() >= 20);
     }
@@ -26,9 +26,16 @@ private:
 
   template <class SampleT, uint8_t nChannels> class StreamPtrWindow;
 
-  template <bool format16, uint8_t nChannels> class StreamCacheWindow;
-
-  template <bool format16, unsigned windowLen, uint8_t nChannels>
+  /* If isMidSide then the compressed frames contain mid/side and the windows
+   * return left/right */
+  template <bool format16, uint8_t nChannels, bool isMidSide = false>
+  class StreamCacheWindow;
+
+  template <
+    bool format16,
+    unsigned windowLen,
+    uint8_t nChannels,
+    bool isMidSide = false>
   class StreamCacheReadAheadWindow;
 
   typedef void (GOSoundStream::*DecodeBlockFunction)(
@@ -80,6 +87,7 @@ private:
     uint8_t nChannels,
     uint8_t nBitsPerSoundItem,
     bool isCompressed,
+    bool isMidSide,
     GOSoundResample::InterpolationType interpolationType);
 
   /**
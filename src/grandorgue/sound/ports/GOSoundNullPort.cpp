@@ -0,0 +1,89 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOSoundNullPort.h"
+
+#include <chrono>
+#include <thread>
+
+#include <wx/log.h>
+
+#include "config/GODeviceNamePattern.h"
+
+const wxString GOSoundNullPort::PORT_NAME = wxT("Null");
+
+static const wxString DEVICE_NAME = wxT("Silent Output");
+static constexpr unsigned MAX_CHANNELS_COUNT = 64;
+
+void GOSoundNullPort::PacingThread::Entry() {
+  const auto period = std::chrono::nanoseconds(
+    (int64_t)r_port.m_SamplesPerBuffer * 1000000000 / r_port.m_SampleRate);
+  auto nextTime = std::chrono::steady_clock::now();
+
+  while (!ShouldStop()) {
+    if (!r_port.AudioCallback(r_port.m_buffer))
+      break;
+    nextTime += period;
+
+    const auto now = std::chrono::steady_clock::now();
+
+    // do not try to catch up after a long stall
+    if (nextTime < now)
+      nextTime = now;
+    std::this_thread::sleep_until(nextTime);
+  }
+}
+
+GOSoundNullPort::GOSoundNullPort(GOSoundSystem *sound, wxString name)
+  : GOSoundPort(sound, name), m_thread(*this) {}
+
+GOSoundNullPort::~GOSoundNullPort() { Close(); }
+
+void GOSoundNullPort::Open() {
+  Close();
+  m_buffer.Resize(m_Channels, m_SamplesPerBuffer);
+  m_IsOpen = true;
+}
+
+void GOSoundNullPort::StartStream() {
+  if (!m_IsOpen)
+    throw wxString::Format("Audio device %s not open", m_Name);
+  SetActualLatency(m_SamplesPerBuffer / (double)m_SampleRate);
+  m_thread.Start();
+}
+
+void GOSoundNullPort::Close() {
+  m_thread.Stop();
+  m_IsOpen = false;
+}
+
+wxString GOSoundNullPort::getName() {
+  return GOSoundPortFactory::getInstance().ComposeDeviceName(
+    PORT_NAME, wxEmptyString, DEVICE_NAME);
+}
+
+GOSoundPort *GOSoundNullPort::create(
+  const GOPortsConfig &portsConfig,
+  GOSoundSystem *sound,
+  GODeviceNamePattern &pattern) {
+  GOSoundPort *pPort = nullptr;
+  const wxString devName = getName();
+
+  if (
+    portsConfig.IsEnabled(PORT_NAME)
+    && (pattern.DoesMatch(devName) || pattern.DoesMatch(PORT_NAME))) {
+    pattern.SetPhysicalName(devName);
+    pPort = new GOSoundNullPort(sound, devName);
+  }
+  return pPort;
+}
+
+void GOSoundNullPort::addDevices(
+  const GOPortsConfig &portsConfig, std::vector<GOSoundDevInfo> &result) {
+  if (portsConfig.IsEnabled(PORT_NAME))
+    result.emplace_back(
+      PORT_NAME, wxEmptyString, DEVICE_NAME, MAX_CHANNELS_COUNT, false);
+}
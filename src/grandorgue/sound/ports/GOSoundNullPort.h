@@ -0,0 +1,63 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOSOUNDNULLPORT_H
+#define GOSOUNDNULLPORT_H
+
+#include <vector>
+
+#include "sound/buffer/GOSoundBufferManaged.h"
+#include "threading/GOThread.h"
+
+#include "GOSoundPort.h"
+#include "GOSoundPortFactory.h"
+
+/**
+ * An audio port without any device. It requests the buffers at the pace of
+ * a real device and discards them. It allows to run GrandOrgue headless, e.g.
+ * for measuring the latency of the organ without the device buffers.
+ */
+class GOSoundNullPort : public GOSoundPort {
+public:
+  static const wxString PORT_NAME;
+
+private:
+  class PacingThread : public GOThread {
+  private:
+    GOSoundNullPort &r_port;
+
+  protected:
+    void Entry() override;
+
+  public:
+    PacingThread(GOSoundNullPort &port) : r_port(port) {}
+  };
+
+  GOSoundBufferManaged m_buffer;
+  PacingThread m_thread;
+
+  static wxString getName();
+
+public:
+  GOSoundNullPort(GOSoundSystem *sound, wxString name);
+  ~GOSoundNullPort();
+
+  void Open() override;
+  void StartStream() override;
+  void Close() override;
+
+  static const std::vector<wxString> &getApis() {
+    return GOSoundPortFactory::c_NoApis;
+  }
+  static GOSoundPort *create(
+    const GOPortsConfig &portsConfig,
+    GOSoundSystem *sound,
+    GODeviceNamePattern &pattern);
+  static void addDevices(
+    const GOPortsConfig &portsConfig, std::vector<GOSoundDevInfo> &list);
+};
+
+#endif /* GOSOUNDNULLPORT_H */
@@ -10,6 +10,7 @@
 #include <wx/intl.h>
 #include <wx/thread.h>
 
+#include "sound/GOSoundLatencyProbe.h"
 #include "sound/GOSoundSystem.h"
 #include "sound/buffer/GOSoundBufferMutable.h"
 
@@ -45,6 +46,7 @@ void GOSoundPort::SetActualLatency(double latency) {
   if (latency < 2 * m_SamplesPerBuffer / (double)m_SampleRate)
     latency += m_SamplesPerBuffer / (double)m_SampleRate;
   m_ActualLatency = latency * 1000;
+  GOSoundLatencyProbe::getInstance().SetDeviceLatency(m_ActualLatency);
 }
 
 bool GOSoundPort::AudioCallback(GOSoundBufferMutable &outputBuffer) {
@@ -8,6 +8,7 @@
 #include "GOSoundPortFactory.h"
 
 #include "GOSoundJackPort.h"
+#include "GOSoundNullPort.h"
 #include "GOSoundPortaudioPort.h"
 #include "GOSoundRtPort.h"
 #include "config/GODeviceNamePattern.h"
@@ -22,6 +23,7 @@ const std::vector<wxString> &GOSoundPortFactory::GetPortNames() const {
 #if defined(GO_USE_JACK)
     portNames.push_back(GOSoundJackPort::PORT_NAME);
 #endif
+    portNames.push_back(GOSoundNullPort::PORT_NAME);
     hasPortsPopulated = true;
   }
   return portNames;
@@ -35,11 +37,18 @@ const std::vector<wxString> &GOSoundPortFactory::GetPortApiNames(
     return GOSoundRtPort::getApis();
   else if (portName == GOSoundJackPort::PORT_NAME)
     return GOSoundJackPort::getApis();
+  else if (portName == GOSoundNullPort::PORT_NAME)
+    return GOSoundNullPort::getApis();
   else // old-style name
     return c_NoApis;
 }
 
-enum { SUBSYS_PA_BIT = 1, SUBSYS_RT_BIT = 2, SUBSYS_JACK_BIT = 4 };
+enum {
+  SUBSYS_PA_BIT = 1,
+  SUBSYS_RT_BIT = 2,
+  SUBSYS_JACK_BIT = 4,
+  SUBSYS_NULL_BIT = 8
+};
 
 GOSoundPort *GOSoundPortFactory::create(
   const GOPortsConfig &portsConfig,
@@ -62,6 +71,8 @@ GOSoundPort *GOSoundPortFactory::create(
     portMask = SUBSYS_RT_BIT;
   else if (portName == GOSoundJackPort::PORT_NAME)
     portMask = SUBSYS_JACK_BIT;
+  else if (portName == GOSoundNullPort::PORT_NAME)
+    portMask = SUBSYS_NULL_BIT;
   else // old-style name
     portMask = SUBSYS_PA_BIT | SUBSYS_RT_BIT | SUBSYS_JACK_BIT;
 
@@ -77,6 +88,10 @@ GOSoundPort *GOSoundPortFactory::create(
     port == NULL && (portMask & SUBSYS_JACK_BIT)
     && portsConfig.IsEnabled(GOSoundJackPort::PORT_NAME))
     port = GOSoundJackPort::create(portsConfig, sound, pattern);
+  if (
+    port == NULL && (portMask & SUBSYS_NULL_BIT)
+    && portsConfig.IsEnabled(GOSoundNullPort::PORT_NAME))
+    port = GOSoundNullPort::create(portsConfig, sound, pattern);
   return port;
 }
 
@@ -90,6 +105,8 @@ std::vector<GOSoundDevInfo> GOSoundPortFactory::getDeviceList(
     GOSoundRtPort::addDevices(portsConfig, result);
   if (portsConfig.IsEnabled(GOSoundJackPort::PORT_NAME))
     GOSoundJackPort::addDevices(portsConfig, result);
+  if (portsConfig.IsEnabled(GOSoundNullPort::PORT_NAME))
+    GOSoundNullPort::addDevices(portsConfig, result);
   return result;
 }
 
@@ -7,6 +7,8 @@
 
 #include "GOSoundProvider.h"
 
+#include <algorithm>
+
 #include <wx/intl.h>
 
 #include "loader/cache/GOCache.h"
@@ -14,8 +16,9 @@
 #include "sound/playing/GOSoundAudioSection.h"
 #include "sound/playing/GOSoundReleaseAlignTable.h"
 
-#include "GOHash.h"
+#include "GOCacheRecord.h"
 #include "GOMemoryPool.h"
+#include "GORandom.h"
 #include "GOSampleStatistic.h"
 
 #define DELETE_AND_NULL(x)                                                     \
@@ -26,13 +29,18 @@
     }                                                                          \
   } while (0)
 
-void GOSoundProvider::UpdateCacheHash(GOHash &hash) {
-  hash.Update(sizeof(AttackSelector));
-  hash.Update(sizeof(ReleaseSelector));
-}
-
 GOSoundProvider::GOSoundProvider()
-  : m_MidiKeyNumber(0),
+  : m_OwnedSections(),
+    m_SectionArray(),
+    m_SelectionIndices(),
+    m_AttackVelocityBounds(),
+    m_AttackDurationBounds(),
+    m_AttackTable(),
+    m_ReleaseDurationBounds(),
+    m_ReleaseTable(),
+    m_RenderNs(0),
+    m_NRenderedPeriods(0),
+    m_MidiKeyNumber(0),
     m_MidiPitchFract(0),
     m_Tuning(1),
     m_ToneBalanceValue(0),
@@ -55,74 +63,115 @@ void GOSoundProvider::ClearData() {
   m_AttackInfo.clear();
   m_Release.clear();
   m_ReleaseInfo.clear();
+  m_OwnedSections.clear();
+  m_SectionArray.clear();
+  ClearSelectionTables();
+}
+
+GOSoundAudioSection *GOSoundProvider::NewSection(GOMemoryPool &pool) {
+  GOSoundAudioSection *section = new GOSoundAudioSection(pool);
+
+  m_OwnedSections.push_back(section);
+  return section;
+}
+
+void GOSoundProvider::TakeData(GOSoundProvider &donor) {
+  ClearData();
+  // the same fields as in the cache
+  m_MidiKeyNumber = donor.m_MidiKeyNumber;
+  m_MidiPitchFract = donor.m_MidiPitchFract;
+  m_AttackSwitchCrossfadeLength = donor.m_AttackSwitchCrossfadeLength;
+  // swapping keeps the addresses of the sections
+  m_OwnedSections.swap(donor.m_OwnedSections);
+  m_SectionArray.swap(donor.m_SectionArray);
+  m_Attack.swap(donor.m_Attack);
+  m_AttackInfo.swap(donor.m_AttackInfo);
+  m_Release.swap(donor.m_Release);
+  m_ReleaseInfo.swap(donor.m_ReleaseInfo);
+  m_SelectionIndices.swap(donor.m_SelectionIndices);
+  m_AttackVelocityBounds.swap(donor.m_AttackVelocityBounds);
+  m_AttackDurationBounds.swap(donor.m_AttackDurationBounds);
+  m_AttackTable.swap(donor.m_AttackTable);
+  for (unsigned i = 0; i < N_BOOL3; i++) {
+    m_ReleaseDurationBounds[i].swap(donor.m_ReleaseDurationBounds[i]);
+    m_ReleaseTable[i].swap(donor.m_ReleaseTable[i]);
+  }
 }
 
 bool GOSoundProvider::LoadCache(GOMemoryPool &pool, GOCache &cache) {
-  if (!cache.Read(&m_MidiKeyNumber, sizeof(m_MidiKeyNumber)))
-    return false;
-  if (!cache.Read(&m_MidiPitchFract, sizeof(m_MidiPitchFract)))
-    return false;
-  if (!cache.Read(
-        &m_AttackSwitchCrossfadeLength, sizeof(m_AttackSwitchCrossfadeLength)))
+  GOCacheRecord record;
+  unsigned nAttacks, nReleases;
+
+  if (
+    !cache.ReadRecord(record) || !record.GetUInt(m_MidiKeyNumber)
+    || !record.GetFloat(m_MidiPitchFract)
+    || !record.GetUInt(m_AttackSwitchCrossfadeLength)
+    || !record.GetUInt(nAttacks) || !record.GetUInt(nReleases))
     return false;
 
-  unsigned attacks;
-  if (!cache.Read(&attacks, sizeof(attacks)))
-    return false;
-  for (unsigned i = 0; i < attacks; i++) {
-    AttackSelector info;
-    if (!cache.Read(&info, sizeof(info)))
+  m_AttackInfo.resize(nAttacks);
+  for (AttackSelector &info : m_AttackInfo) {
+    if (
+      !record.GetUInt(info.min_attack_velocity)
+      || !record.GetUInt(info.max_released_time)
+      || !record.GetBool3(info.m_WaveTremulantStateFor))
       return false;
-    m_AttackInfo.push_back(info);
-    m_Attack.push_back(new GOSoundAudioSection(pool));
-    if (!m_Attack[i]->LoadCache(cache))
+  }
+  m_ReleaseInfo.resize(nReleases);
+  for (ReleaseSelector &info : m_ReleaseInfo) {
+    if (
+      !record.GetUInt(info.max_playback_time)
+      || !record.GetBool3(info.m_WaveTremulantStateFor))
       return false;
   }
 
-  unsigned releases;
-  if (!cache.Read(&releases, sizeof(releases)))
-    return false;
-  for (unsigned i = 0; i < releases; i++) {
-    ReleaseSelector info;
-    if (!cache.Read(&info, sizeof(info)))
+  // the array is not reallocated, so the pointers to its elements stay valid
+  m_SectionArray.reserve(nAttacks + nReleases);
+  for (unsigned i = 0; i < nAttacks; i++) {
+    GOSoundAudioSection &section = m_SectionArray.emplace_back(pool);
+
+    m_Attack.push_back(&section);
+    if (!section.LoadCache(cache))
       return false;
-    m_ReleaseInfo.push_back(info);
-    m_Release.push_back(new GOSoundAudioSection(pool));
-    if (!m_Release[i]->LoadCache(cache))
+  }
+  for (unsigned i = 0; i < nReleases; i++) {
+    GOSoundAudioSection &section = m_SectionArray.emplace_back(pool);
+
+    m_Release.push_back(&section);
+    if (!section.LoadCache(cache))
       return false;
   }
+  BuildSelectionTables();
 
   return true;
 }
 
 bool GOSoundProvider::SaveCache(GOCacheWriter &cache) const {
-  if (!cache.Write(&m_MidiKeyNumber, sizeof(m_MidiKeyNumber)))
-    return false;
-  if (!cache.Write(&m_MidiPitchFract, sizeof(m_MidiPitchFract)))
-    return false;
-  if (!cache.Write(
-        &m_AttackSwitchCrossfadeLength, sizeof(m_AttackSwitchCrossfadeLength)))
-    return false;
-
-  unsigned attacks = m_Attack.size();
-  if (!cache.Write(&attacks, sizeof(attacks)))
-    return false;
-  for (unsigned i = 0; i < m_Attack.size(); i++) {
-    if (!cache.Write(&m_AttackInfo[i], sizeof(m_AttackInfo[i])))
-      return false;
-    if (!m_Attack[i]->SaveCache(cache))
-      return false;
+  GOCacheRecord record;
+
+  record.PutUInt(m_MidiKeyNumber);
+  record.PutFloat(m_MidiPitchFract);
+  record.PutUInt(m_AttackSwitchCrossfadeLength);
+  record.PutUInt(m_Attack.size());
+  record.PutUInt(m_Release.size());
+  for (const AttackSelector &info : m_AttackInfo) {
+    record.PutUInt(info.min_attack_velocity);
+    record.PutUInt(info.max_released_time);
+    record.PutInt(info.m_WaveTremulantStateFor);
   }
-
-  unsigned releases = m_Release.size();
-  if (!cache.Write(&releases, sizeof(releases)))
+  for (const ReleaseSelector &info : m_ReleaseInfo) {
+    record.PutUInt(info.max_playback_time);
+    record.PutInt(info.m_WaveTremulantStateFor);
+  }
+  if (!cache.WriteRecord(record))
     return false;
-  for (unsigned i = 0; i < m_Release.size(); i++) {
-    if (!cache.Write(&m_ReleaseInfo[i], sizeof(m_ReleaseInfo[i])))
+
+  for (const GOSoundAudioSection *section : m_Attack)
+    if (!section->SaveCache(cache))
       return false;
-    if (!m_Release[i]->SaveCache(cache))
+  for (const GOSoundAudioSection *section : m_Release)
+    if (!section->SaveCache(cache))
       return false;
-  }
 
   return true;
 }
@@ -196,57 +245,161 @@ float GOSoundProvider::GetVelocityVolume(unsigned velocity) const {
   return m_VelocityVolumeBase + (velocity * m_VelocityVolumeIncrement);
 }
 
-const GOSoundAudioSection *GOSoundProvider::GetAttack(
-  unsigned velocity, unsigned releasedDurationMs) const {
-  const unsigned x = abs(rand());
-  int best_match = -1;
+static void sort_unique(std::vector<unsigned> &values) {
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+}
+
+void GOSoundProvider::ClearSelectionTables() {
+  m_SelectionIndices.clear();
+  m_AttackVelocityBounds.clear();
+  m_AttackDurationBounds.clear();
+  m_AttackTable.clear();
+  for (unsigned i = 0; i < N_BOOL3; i++) {
+    m_ReleaseDurationBounds[i].clear();
+    m_ReleaseTable[i].clear();
+  }
+}
 
-  for (unsigned i = 0; i < m_Attack.size(); i++) {
-    const unsigned idx = (i + x) % m_Attack.size();
+void GOSoundProvider::BuildAttackTable() {
+  for (const AttackSelector &info : m_AttackInfo) {
+    m_AttackVelocityBounds.push_back(info.min_attack_velocity);
+    m_AttackDurationBounds.push_back(info.max_released_time);
+  }
+  sort_unique(m_AttackVelocityBounds);
+  sort_unique(m_AttackDurationBounds);
+
+  const unsigned nVelocityBands = m_AttackVelocityBounds.size() + 1;
+  const unsigned nDurationBands = m_AttackDurationBounds.size() + 1;
+  std::vector<unsigned> suitable;
+
+  m_AttackTable.reserve(2 * nVelocityBands * nDurationBands);
+  for (unsigned isActive = 0; isActive < 2; isActive++)
+    for (unsigned velocityI = 0; velocityI < nVelocityBands; velocityI++)
+      for (unsigned durationI = 0; durationI < nDurationBands; durationI++) {
+        const unsigned begin = m_SelectionIndices.size();
+
+        // the band 0 is below any velocity, the last band is above any time
+        if (velocityI > 0 && durationI < nDurationBands - 1) {
+          const unsigned velocity = m_AttackVelocityBounds[velocityI - 1];
+          const unsigned duration = m_AttackDurationBounds[durationI];
+
+          suitable.clear();
+          for (unsigned i = 0; i < m_AttackInfo.size(); i++) {
+            const AttackSelector &info = m_AttackInfo[i];
+
+            if (
+              to_bool(info.m_WaveTremulantStateFor, (bool)isActive)
+                == (bool)isActive
+              && info.min_attack_velocity <= velocity
+              && info.max_released_time >= duration)
+              suitable.push_back(i);
+          }
+          // keep the most specific attacks: prefer a higher velocity together
+          // with a shorter released time
+          for (unsigned i : suitable) {
+            const AttackSelector &info = m_AttackInfo[i];
+            bool isSurpassed = false;
+
+            for (unsigned j : suitable) {
+              const AttackSelector &other = m_AttackInfo[j];
+
+              if (
+                other.min_attack_velocity > info.min_attack_velocity
+                && other.max_released_time < info.max_released_time) {
+                isSurpassed = true;
+                break;
+              }
+            }
+            if (!isSurpassed)
+              m_SelectionIndices.push_back(i);
+          }
+        }
+        m_AttackTable.push_back({begin, (unsigned)m_SelectionIndices.size()});
+      }
+}
 
-    if (
-      IsWaveTremulantStateSuitable(m_AttackInfo[idx].m_WaveTremulantStateFor)
-      && m_AttackInfo[idx].min_attack_velocity <= velocity
-      && m_AttackInfo[idx].max_released_time >= releasedDurationMs) {
-      if (best_match == -1)
-        best_match = idx;
-      else if (
-        m_AttackInfo[best_match].min_attack_velocity
-          < m_AttackInfo[idx].min_attack_velocity
-        && m_AttackInfo[best_match].max_released_time
-          > m_AttackInfo[idx].max_released_time)
-        best_match = idx;
+void GOSoundProvider::BuildReleaseTable() {
+  for (unsigned stateI = 0; stateI < N_BOOL3; stateI++) {
+    const GOBool3 state = to_bool3(stateI + BOOL3_MIN);
+    std::vector<unsigned> &bounds = m_ReleaseDurationBounds[stateI];
+
+    for (const ReleaseSelector &info : m_ReleaseInfo)
+      if (info.m_WaveTremulantStateFor == state)
+        bounds.push_back(info.max_playback_time);
+    sort_unique(bounds);
+    // the release with the shortest suitable max_playback_time is preferred
+    for (unsigned duration : bounds) {
+      const unsigned begin = m_SelectionIndices.size();
+
+      for (unsigned i = 0; i < m_ReleaseInfo.size(); i++)
+        if (
+          m_ReleaseInfo[i].m_WaveTremulantStateFor == state
+          && m_ReleaseInfo[i].max_playback_time == duration)
+          m_SelectionIndices.push_back(i);
+      m_ReleaseTable[stateI].push_back(
+        {begin, (unsigned)m_SelectionIndices.size()});
     }
   }
+}
 
-  if (best_match != -1)
-    return m_Attack[best_match];
-  return NULL;
+void GOSoundProvider::BuildSelectionTables() {
+  ClearSelectionTables();
+  BuildAttackTable();
+  BuildReleaseTable();
 }
 
-const GOSoundAudioSection *GOSoundProvider::GetRelease(
-  GOBool3 waveTremulantStateFor, unsigned playbackDurationMs) const {
-  const unsigned x = abs(rand());
-  int best_match = -1;
+const GOSoundAudioSection *GOSoundProvider::PickCandidate(
+  const std::vector<GOSoundAudioSection *> &sections,
+  const Candidates &candidates) const {
+  const unsigned n = candidates.m_end - candidates.m_begin;
 
-  for (unsigned i = 0; i < m_Release.size(); i++) {
-    const unsigned idx = (i + x) % m_Release.size();
-    if (m_ReleaseInfo[idx].m_WaveTremulantStateFor != waveTremulantStateFor)
-      continue;
-    if (m_ReleaseInfo[idx].max_playback_time < playbackDurationMs)
-      continue;
-    if (best_match == -1)
-      best_match = idx;
-    else if (
-      m_ReleaseInfo[best_match].max_playback_time
-      > m_ReleaseInfo[idx].max_playback_time)
-      best_match = idx;
-  }
+  if (!n)
+    return NULL;
+
+  const unsigned candidateI
+    = candidates.m_begin + (n > 1 ? GORandom::nextBelow(n) : 0);
+
+  return sections[m_SelectionIndices[candidateI]];
+}
 
-  if (best_match != -1)
-    return m_Release[best_match];
+const GOSoundAudioSection *GOSoundProvider::GetAttack(
+  unsigned velocity, unsigned releasedDurationMs) const {
+  if (m_AttackTable.empty())
+    return NULL;
+
+  const unsigned nVelocityBands = m_AttackVelocityBounds.size() + 1;
+  const unsigned nDurationBands = m_AttackDurationBounds.size() + 1;
+  const unsigned velocityI = std::upper_bound(
+                               m_AttackVelocityBounds.begin(),
+                               m_AttackVelocityBounds.end(),
+                               velocity)
+    - m_AttackVelocityBounds.begin();
+  const unsigned durationI = std::lower_bound(
+                               m_AttackDurationBounds.begin(),
+                               m_AttackDurationBounds.end(),
+                               releasedDurationMs)
+    - m_AttackDurationBounds.begin();
+
+  return PickCandidate(
+    m_Attack,
+    m_AttackTable
+      [((m_IsWaveTremulantActive ? 1 : 0) * nVelocityBands + velocityI)
+         * nDurationBands
+       + durationI]);
+}
 
-  return NULL;
+const GOSoundAudioSection *GOSoundProvider::GetRelease(
+  GOBool3 waveTremulantStateFor, unsigned playbackDurationMs) const {
+  const unsigned stateI = waveTremulantStateFor - BOOL3_MIN;
+  const std::vector<unsigned> &bounds = m_ReleaseDurationBounds[stateI];
+  const unsigned durationI
+    = std::lower_bound(bounds.begin(), bounds.end(), playbackDurationMs)
+    - bounds.begin();
+
+  if (durationI >= bounds.size())
+    return NULL;
+  return PickCandidate(m_Release, m_ReleaseTable[stateI][durationI]);
 }
 
 bool GOSoundProvider::CheckForMissingRelease() {
@@ -312,5 +465,12 @@ GOSampleStatistic GOSoundProvider::GetStatistic() {
     stat.Cumulate(m_Attack[i]->GetStatistic());
   for (unsigned i = 0; i < m_Release.size(); i++)
     stat.Cumulate(m_Release[i]->GetStatistic());
+
+  const uint64_t nRenderedPeriods
+    = m_NRenderedPeriods.load(std::memory_order_relaxed);
+
+  if (nRenderedPeriods)
+    stat.SetRenderTime(
+      m_RenderNs.load(std::memory_order_relaxed), nRenderedPeriods);
   return stat;
 }
@@ -8,25 +8,27 @@
 #ifndef GOSOUNDPROVIDER_H_
 #define GOSOUNDPROVIDER_H_
 
+#include <atomic>
 #include <cstdint>
 #include <vector>
 
+#include "sound/playing/GOSoundAudioSection.h"
 #include "sound/playing/GOSoundToneBalanceFilter.h"
 
 #include "GOBool3.h"
 #include "GOStatisticCallback.h"
 #include "ptrvector.h"
 
-class GOSoundAudioSection;
 class GOCache;
 class GOCacheWriter;
-class GOHash;
 class GOMemoryPool;
 
 typedef struct audio_section_stream_s audio_section_stream;
 
 class GOSoundProvider : public GOStatisticCallback {
 protected:
+  static constexpr unsigned N_BOOL3 = BOOL3_MAX - BOOL3_MIN + 1;
+
   struct AttackSelector {
     unsigned min_attack_velocity;
     unsigned max_released_time;
@@ -38,6 +40,53 @@ protected:
     GOBool3 m_WaveTremulantStateFor;
   };
 
+private:
+  // the owners of the sections referenced by m_Attack and m_Release
+  ptr_vector<GOSoundAudioSection> m_OwnedSections;
+  // the sections loaded from the cache are allocated as one array
+  std::vector<GOSoundAudioSection> m_SectionArray;
+
+  // a range of m_SelectionIndices
+  struct Candidates {
+    unsigned m_begin;
+    unsigned m_end;
+  };
+
+  /*
+   * The selection tables are built once the sections are loaded, so choosing
+   * a section only needs two binary searches and one random number.
+   *
+   * The attacks are split into velocity bands by the distinct
+   * min_attack_velocity values and into duration bands by the distinct
+   * max_released_time values. m_AttackTable contains the best attacks for
+   * each wave tremulant state, velocity band and duration band.
+   *
+   * The releases are split into duration bands by the distinct
+   * max_playback_time values of each m_WaveTremulantStateFor. m_ReleaseTable
+   * contains the releases with exactly this max_playback_time.
+   */
+  std::vector<unsigned> m_SelectionIndices;
+  std::vector<unsigned> m_AttackVelocityBounds;
+  std::vector<unsigned> m_AttackDurationBounds;
+  // [isWaveTremulantActive][velocity band][duration band]
+  std::vector<Candidates> m_AttackTable;
+  std::vector<unsigned> m_ReleaseDurationBounds[N_BOOL3];
+  std::vector<Candidates> m_ReleaseTable[N_BOOL3];
+
+  // the time spent on rendering the samplers of this provider and the number
+  // of the rendered sampler periods. They are updated by the audio threads
+  mutable std::atomic<uint64_t> m_RenderNs;
+  mutable std::atomic<uint64_t> m_NRenderedPeriods;
+
+  void ClearSelectionTables();
+  void BuildAttackTable();
+  void BuildReleaseTable();
+  const GOSoundAudioSection *PickCandidate(
+    const std::vector<GOSoundAudioSection *> &sections,
+    const Candidates &candidates) const;
+
+protected:
+
   unsigned m_MidiKeyNumber;
   float m_MidiPitchFract;
   float m_Gain;
@@ -46,23 +95,32 @@ protected:
   GOSoundToneBalanceFilter m_ToneBalance;
   bool m_IsWaveTremulantActive;
   unsigned m_ReleaseTail;
-  ptr_vector<GOSoundAudioSection> m_Attack;
+  std::vector<GOSoundAudioSection *> m_Attack;
   std::vector<AttackSelector> m_AttackInfo;
-  ptr_vector<GOSoundAudioSection> m_Release;
+  std::vector<GOSoundAudioSection *> m_Release;
   std::vector<ReleaseSelector> m_ReleaseInfo;
   void ComputeReleaseAlignmentInfo();
+  // must be called when all attacks and releases are added
+  void BuildSelectionTables();
   float m_VelocityVolumeBase;
   float m_VelocityVolumeIncrement;
   unsigned m_AttackSwitchCrossfadeLength;
 
-public:
-  static void UpdateCacheHash(GOHash &hash);
+  // creates a section owned by this provider
+  GOSoundAudioSection *NewSection(GOMemoryPool &pool);
 
+public:
   GOSoundProvider();
   virtual ~GOSoundProvider();
 
   void ClearData();
 
+  /**
+   * Moves the loaded samples and the sample properties from the donor. The
+   * donor becomes empty
+   */
+  void TakeData(GOSoundProvider &donor);
+
   virtual bool LoadCache(GOMemoryPool &pool, GOCache &cache);
   virtual bool SaveCache(GOCacheWriter &cache) const;
 
@@ -107,6 +165,15 @@ public:
   bool CheckMissingRelease();
   bool CheckNotNecessaryRelease();
 
+  /**
+   * Accounts one rendered period of a sampler of this provider. It is called
+   * by the audio threads, so it never blocks
+   */
+  void AddRenderedPeriod(uint64_t renderNs) const {
+    m_RenderNs.fetch_add(renderNs, std::memory_order_relaxed);
+    m_NRenderedPeriods.fetch_add(1, std::memory_order_relaxed);
+  }
+
   GOSampleStatistic GetStatistic();
 };
 
@@ -44,6 +44,7 @@ void GOSoundProviderWave::AddAttackSection(
   unsigned bits_per_sample,
   unsigned channels,
   bool compress,
+  bool isMidSide,
   LoopLoadType loop_mode,
   bool percussive,
   unsigned min_attack_velocity,
@@ -118,7 +119,7 @@ void GOSoundProviderWave::AddAttackSection(
   attack_info.min_attack_velocity = min_attack_velocity;
   attack_info.max_released_time = max_released_time;
   m_AttackInfo.push_back(attack_info);
-  GOSoundAudioSection *section = new GOSoundAudioSection(pool);
+  GOSoundAudioSection *section = NewSection(pool);
   m_Attack.push_back(section);
   section->Setup(
     p_ObjectFor,
@@ -132,13 +133,14 @@ void GOSoundProviderWave::AddAttackSection(
     waveTremulantStateFor,
     compress,
     loop_crossfade_length,
-    0);
+    0,
+    isMidSide);
 }
 
 void GOSoundProviderWave::AddReleaseSection(
   GOMemoryPool &pool,
   const GOLoaderFilename &loaderFilename,
-  const char *data,
+  char *data,
   GOWave &wave,
   GOBool3 waveTremulantStateFor,
   unsigned max_playback_time,
@@ -147,7 +149,9 @@ void GOSoundProviderWave::AddReleaseSection(
   unsigned bits_per_sample,
   unsigned channels,
   bool compress,
-  unsigned releaseCrossfadeLength) {
+  bool isMidSide,
+  unsigned releaseCrossfadeLength,
+  unsigned releaseTail) {
   unsigned release_offset
     = wave.HasReleaseMarker() ? wave.GetReleaseMarkerPosition() : 0;
   if (cue_point != -1)
@@ -163,16 +167,40 @@ void GOSoundProviderWave::AddReleaseSection(
   if (release_offset >= release_end_marker)
     throw(wxString) _("Invalid release position");
 
+  char *releaseData
+    = data + release_offset * GetBytesPerSample(bits_per_sample) * channels;
+  unsigned truncatedSamples = 0;
+
+  if (releaseTail) {
+    const unsigned sampleRate = wave.GetSampleRate();
+    const unsigned fadeSamples = RELEASE_TAIL_FADE_LENGTH * sampleRate / 1000;
+    const unsigned keptSamples
+      = (unsigned)(releaseTail * RELEASE_TAIL_PITCH_MARGIN * sampleRate / 1000)
+      + fadeSamples;
+
+    if (release_samples > keptSamples) {
+      // the release fader reaches zero before the cut, so it is inaudible
+      truncatedSamples = release_samples - keptSamples;
+      release_samples = keptSamples;
+      GOSoundAudioSection::fadeOut(
+        releaseData,
+        (GOWave::SAMPLE_FORMAT)bits_per_sample,
+        channels,
+        release_samples,
+        fadeSamples);
+    }
+  }
+
   ReleaseSelector release_info;
   release_info.m_WaveTremulantStateFor = waveTremulantStateFor;
   release_info.max_playback_time = max_playback_time;
   m_ReleaseInfo.push_back(release_info);
-  GOSoundAudioSection *section = new GOSoundAudioSection(pool);
+  GOSoundAudioSection *section = NewSection(pool);
   m_Release.push_back(section);
   section->Setup(
     p_ObjectFor,
     &loaderFilename,
-    data + release_offset * GetBytesPerSample(bits_per_sample) * channels,
+    releaseData,
     (GOWave::SAMPLE_FORMAT)bits_per_sample,
     channels,
     wave.GetSampleRate(),
@@ -181,7 +209,9 @@ void GOSoundProviderWave::AddReleaseSection(
     waveTremulantStateFor,
     compress,
     0,
-    releaseCrossfadeLength);
+    releaseCrossfadeLength,
+    isMidSide);
+  section->SetTruncatedSampleCount(truncatedSamples);
 }
 
 void GOSoundProviderWave::LoadPitch(GOOpenedFile *file) {
@@ -220,13 +250,15 @@ void GOSoundProviderWave::LoadFromOneFile(
   unsigned bits_per_sample,
   int load_channels,
   bool compress,
+  bool isMidSide,
   LoopLoadType loop_mode,
   bool percussive,
   unsigned min_attack_velocity,
   bool use_pitch,
   unsigned loop_crossfade_length,
   unsigned releaseCrossfadeLength,
-  unsigned max_released_time) {
+  unsigned max_released_time,
+  unsigned releaseTail) {
   // if an exception occurs during Open(), it already contains the file name
   std::unique_ptr<GOOpenedFile> openedFilePtr = loaderFilename.Open(fileStore);
 
@@ -287,6 +319,7 @@ void GOSoundProviderWave::LoadFromOneFile(
         bits_per_sample,
         channels,
         compress,
+        isMidSide,
         loop_mode,
         percussive,
         min_attack_velocity,
@@ -308,8 +341,10 @@ void GOSoundProviderWave::LoadFromOneFile(
         bits_per_sample,
         channels,
         compress,
+        isMidSide,
         releaseCrossfadeLength ? releaseCrossfadeLength
-                               : midiKeyCrossfadeLength);
+                               : midiKeyCrossfadeLength,
+        releaseTail);
   } catch (GOOutOfMemory e) {
     throw e;
   } catch (const wxString &error) {
@@ -323,7 +358,30 @@ void GOSoundProviderWave::LoadFromOneFile(
     throw loaderFilename.GenerateMessage(excText);
 }
 
-void GOSoundProviderWave::LoadFromMultipleFiles(
+unsigned GOSoundProviderWave::RemoveUnreachable(
+  std::vector<AttackFileInfo> &attacks,
+  std::vector<ReleaseFileInfo> &releases,
+  bool isWaveTremulantUsed) {
+  const unsigned nSamples = attacks.size() + releases.size();
+  bool hasAttacksFor[N_BOOL3] = {};
+
+  // the attacks for the active wave tremulant are selected only if it exists
+  if (!isWaveTremulantUsed)
+    std::erase_if(attacks, [](const AttackFileInfo &a) {
+      return a.m_WaveTremulantStateFor == BOOL3_TRUE;
+    });
+  for (const auto &a : attacks)
+    hasAttacksFor[a.m_WaveTremulantStateFor - BOOL3_MIN] = true;
+  // a release is selected for the wave tremulant state of the playing attack.
+  // The default release is also selected for the pipes without attacks
+  std::erase_if(releases, [&](const ReleaseFileInfo &r) {
+    return r.m_WaveTremulantStateFor != BOOL3_DEFAULT
+      && !hasAttacksFor[r.m_WaveTremulantStateFor - BOOL3_MIN];
+  });
+  return nSamples - attacks.size() - releases.size();
+}
+
+unsigned GOSoundProviderWave::LoadFromMultipleFiles(
   const GOFileStore &fileStore,
   GOMemoryPool &pool,
   std::vector<AttackFileInfo> attacks,
@@ -333,13 +391,30 @@ void GOSoundProviderWave::LoadFromMultipleFiles(
   bool compress,
   LoopLoadType loop_mode,
   bool isToLoadAttacks,
-  bool isToLoadReleases) {
+  bool isToLoadReleases,
+  bool isWaveTremulantUsed,
+  unsigned releaseTail,
+  bool isMidSide) {
   ClearData();
   if (!load_channels)
-    return;
+    return 0;
 
   bool load_first_attack = true;
 
+  if (
+    !isWaveTremulantUsed && !attacks.empty()
+    && attacks[0].m_WaveTremulantStateFor == BOOL3_TRUE) {
+    // the first attack defines the pitch even if it is never played
+    LoadPitch(attacks[0].filename.Open(fileStore).get());
+    m_AttackSwitchCrossfadeLength = attacks[0].m_ReleaseCrossfadeLength
+      ? attacks[0].m_ReleaseCrossfadeLength
+      : get_fader_length(m_MidiKeyNumber);
+    load_first_attack = false;
+  }
+
+  const unsigned nUnreachable
+    = RemoveUnreachable(attacks, releases, isWaveTremulantUsed);
+
   if (!isToLoadReleases)
     for (int k = -1; k < 2; k++) {
       unsigned longest = 0;
@@ -436,13 +511,15 @@ void GOSoundProviderWave::LoadFromMultipleFiles(
         bits_per_sample,
         load_channels,
         compress,
+        isMidSide,
         loop_mode,
         a.percussive,
         a.min_attack_velocity,
         load_first_attack,
         a.m_LoopCrossfadeLength,
         a.m_ReleaseCrossfadeLength,
-        a.max_released_time);
+        a.max_released_time,
+        releaseTail);
       load_first_attack = false;
     }
 
@@ -462,18 +539,22 @@ void GOSoundProviderWave::LoadFromMultipleFiles(
         bits_per_sample,
         load_channels,
         compress,
+        isMidSide,
         loop_mode,
         true,
         0,
         false,
         0,
         r.m_ReleaseCrossfadeLength,
-        0);
+        0,
+        releaseTail);
     }
 
     ComputeReleaseAlignmentInfo();
+    BuildSelectionTables();
   } catch (...) {
     ClearData();
     throw;
   }
+  return nUnreachable;
 }
@@ -55,6 +55,14 @@ public:
     bool percussive;
   };
 
+  /* A truncated release is kept longer than the release tail for the case when
+   * the pipe is retuned up and plays the samples faster. It covers retuning up
+   * to about 3.8 semitones
+   */
+  static constexpr float RELEASE_TAIL_PITCH_MARGIN = 1.25f;
+  // The length of the fade out baked into the end of a truncated release
+  static constexpr unsigned RELEASE_TAIL_FADE_LENGTH = 20; // ms
+
   struct ReleaseFileInfo {
     GOLoaderFilename filename;
     int max_playback_time;
@@ -80,6 +88,7 @@ private:
     unsigned bits_per_sample,
     unsigned channels,
     bool compress,
+    bool isMidSide,
     LoopLoadType loop_mode,
     bool percussive,
     unsigned min_attack_velocity,
@@ -89,7 +98,7 @@ private:
   void AddReleaseSection(
     GOMemoryPool &pool,
     const GOLoaderFilename &loaderFilename,
-    const char *data,
+    char *data,
     GOWave &wave,
     GOBool3 waveTremulantStateFor,
     unsigned max_playback_time,
@@ -98,7 +107,9 @@ private:
     unsigned bits_per_sample,
     unsigned channels,
     bool compress,
-    unsigned releaseCrossfadeLength);
+    bool isMidSide,
+    unsigned releaseCrossfadeLength,
+    unsigned releaseTail);
 
   /*
    * Load attack and/or release samples from one wav file or from an archive
@@ -118,25 +129,44 @@ private:
     unsigned bits_per_sample,
     int load_channels,
     bool compress,
+    bool isMidSide,
     LoopLoadType loop_mode,
     bool percussive,
     unsigned min_attack_velocity,
     bool use_pitch,
     unsigned loop_crossfade_length,
     unsigned releaseCrossfadeLengh,
-    unsigned max_released_time);
+    unsigned max_released_time,
+    unsigned releaseTail);
 
   void LoadPitch(GOOpenedFile *file);
 
+  /*
+   * Removes the attacks and the releases that are never selected for playing.
+   * Returns the number of the removed ones
+   * @param isWaveTremulantUsed whether a wave tremulant may affect the pipe
+   */
+  static unsigned RemoveUnreachable(
+    std::vector<AttackFileInfo> &attacks,
+    std::vector<ReleaseFileInfo> &releases,
+    bool isWaveTremulantUsed);
+
 public:
   GOSoundProviderWave(GOCacheObject *pObjectFor = nullptr)
     : p_ObjectFor(pObjectFor) {}
 
   /*
    * Load all attack and release samples from corresponding .wav files or from
-   * an archive
+   * an archive.
+   * If releaseTail (ms) is not 0 then the release sections are truncated to
+   * the release tail with a margin and faded out at the end.
+   * The samples that can never be played are not loaded: the ones for an
+   * active wave tremulant if isWaveTremulantUsed is false and the releases for
+   * a wave tremulant state no attack has.
+   * Returns the number of the sample files not loaded for this reason.
+   * If isMidSide then the compressed stereo samples are stored as mid/side
    */
-  void LoadFromMultipleFiles(
+  unsigned LoadFromMultipleFiles(
     const GOFileStore &fileStore,
     GOMemoryPool &pool,
     std::vector<AttackFileInfo> attacks,
@@ -146,7 +176,10 @@ public:
     bool compress,
     LoopLoadType loop_mode,
     bool isToLoadAttacks,
-    bool isToLoadReleases);
+    bool isToLoadReleases,
+    bool isWaveTremulantUsed = true,
+    unsigned releaseTail = 0,
+    bool isMidSide = false);
   void SetAmplitude(float fixed_amplitude, float gain);
 };
 
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -27,6 +27,7 @@ public:
     TREMULANT = 10,
     WINDCHEST = 20,
     AUDIOGROUP = 50,
+    AUDIOREVERB = 75,
     AUDIOOUTPUT = 100,
     AUDIORECORDER = 150,
     RELEASE = 160,
@@ -9,6 +9,8 @@
 
 #include <unistd.h>
 
+#include <chrono>
+
 #include <wx/log.h>
 
 #include "sound/scheduler/GOSoundTask.h"
@@ -21,35 +23,52 @@ GOSoundThread::GOSoundThread(GOSoundScheduler *scheduler)
     m_Scheduler(scheduler),
     m_Condition(m_Mutex),
     m_IdleStateReachedCondition(m_Mutex),
-    m_IsIdle(false) {
+    m_IsIdle(false),
+    m_Heartbeat("GOSoundThread"),
+    m_NWakeups(0),
+    m_NSteals(0),
+    m_NIdleWakeups(0),
+    m_BusyNs(0) {
   wxLogDebug(wxT("Create Thread"));
 }
 
 void GOSoundThread::Entry() {
   while (!ShouldStop()) {
     bool shouldStop = false;
+    unsigned nGroups = 0;
+    const int64_t startTime = getTimeNs();
 
+    m_Heartbeat.Beat();
     do {
       GOSoundTask *next = m_Scheduler->GetNextGroup();
 
       if (next == NULL)
         break;
       next->Run(this);
+      nGroups++;
       shouldStop = ShouldStop();
     } while (!shouldStop);
 
+    m_BusyNs.fetch_add(getTimeNs() - startTime, std::memory_order_relaxed);
+    m_NWakeups.fetch_add(1, std::memory_order_relaxed);
+    m_NSteals.fetch_add(nGroups, std::memory_order_relaxed);
+    if (!nGroups)
+      m_NIdleWakeups.fetch_add(1, std::memory_order_relaxed);
+
     if (shouldStop)
       break;
 
     GOMutexLocker lock(m_Mutex, false, "GOSoundThread::Entry", this);
     if (!lock.IsLocked() || ShouldStop())
       break;
+    m_Heartbeat.Idle();
     m_IsIdle = true;
     m_IdleStateReachedCondition.Broadcast();
     if (!m_Condition.WaitOrStop("GOSoundThread::Entry"))
       break;
     m_IsIdle = false;
   }
+  m_Heartbeat.Idle();
 
   return;
 }
@@ -65,6 +84,23 @@ void GOSoundThread::Run() { Start(); }
 
 void GOSoundThread::Wakeup() { m_Condition.Signal(); }
 
+int64_t GOSoundThread::getTimeNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+GOSoundThread::Counters GOSoundThread::FetchCounters() {
+  Counters counters;
+
+  counters.m_NWakeups = m_NWakeups.exchange(0, std::memory_order_relaxed);
+  counters.m_NSteals = m_NSteals.exchange(0, std::memory_order_relaxed);
+  counters.m_NIdleWakeups
+    = m_NIdleWakeups.exchange(0, std::memory_order_relaxed);
+  counters.m_BusyNs = m_BusyNs.exchange(0, std::memory_order_relaxed);
+  return counters;
+}
+
 void GOSoundThread::Delete() {
   MarkForStop();
   Wakeup();
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -8,13 +8,32 @@
 #ifndef GOSOUNDTHREAD_H
 #define GOSOUNDTHREAD_H
 
+#include <atomic>
+#include <cstdint>
+
 #include "threading/GOCondition.h"
 #include "threading/GOMutex.h"
 #include "threading/GOThread.h"
+#include "threading/GOThreadWatchdog.h"
 
 class GOSoundScheduler;
 
 class GOSoundThread : public GOThread {
+public:
+  /**
+   * The activity of the thread since the previous FetchCounters() call
+   */
+  struct Counters {
+    // how many times the thread started looking for work
+    unsigned m_NWakeups;
+    // how many task groups the thread has taken from the scheduler
+    unsigned m_NSteals;
+    // how many wakeups have not found any work
+    unsigned m_NIdleWakeups;
+    // the time spent on looking for work and running it
+    int64_t m_BusyNs;
+  };
+
 private:
   GOSoundScheduler *m_Scheduler;
 
@@ -23,6 +42,12 @@ private:
   GOCondition m_IdleStateReachedCondition;
   // whether the thread sleeps and waits for waking up with m_Condition
   bool m_IsIdle; // guarded by m_Mutex
+  GOThreadWatchdog::Heartbeat m_Heartbeat;
+
+  std::atomic_uint m_NWakeups;
+  std::atomic_uint m_NSteals;
+  std::atomic_uint m_NIdleWakeups;
+  std::atomic<int64_t> m_BusyNs;
 
   void Entry();
 
@@ -43,6 +68,12 @@ public:
   void Run();
   void Delete();
   void Wakeup();
+
+  // steady clock time in ns used for measuring the busy time
+  static int64_t getTimeNs();
+
+  // Returns the counters and resets them. Does not block
+  Counters FetchCounters();
 };
 
 #endif
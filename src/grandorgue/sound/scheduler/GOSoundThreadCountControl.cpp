@@ -0,0 +1,38 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOSoundThreadCountControl.h"
+
+#include <algorithm>
+#include <cmath>
+
+void GOSoundThreadCountControl::Init(unsigned nThreads, unsigned shrinkDelay) {
+  m_NThreads = nThreads;
+  m_ShrinkDelay = std::max(shrinkDelay, 1u);
+  m_NActiveThreads = nThreads;
+  m_NPeriodsBelow = 0;
+  m_VoiceCost = 0.0f;
+}
+
+unsigned GOSoundThreadCountControl::Update(
+  float periodCost, unsigned nVoices) {
+  if (nVoices)
+    m_VoiceCost += (periodCost / nVoices - m_VoiceCost) * VOICE_COST_WEIGHT;
+
+  const float expectedCost = std::max(periodCost, m_VoiceCost * nVoices);
+  // the audio callback thread does a part of the work itself
+  const unsigned nNeeded = (unsigned)std::ceil(expectedCost / TARGET_LOAD);
+  const unsigned nDesired = std::min(nNeeded > 0 ? nNeeded - 1 : 0, m_NThreads);
+
+  if (nDesired >= m_NActiveThreads) {
+    m_NActiveThreads = nDesired;
+    m_NPeriodsBelow = 0;
+  } else if (++m_NPeriodsBelow >= m_ShrinkDelay) {
+    m_NActiveThreads--;
+    m_NPeriodsBelow = 0;
+  }
+  return m_NActiveThreads;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOSOUNDTHREADCOUNTCONTROL_H
+#define GOSOUNDTHREADCOUNTCONTROL_H
+
+/**
+ * Decides how many sound worker threads have to be woken up for the next
+ * period.
+ *
+ * The decision is based on the cost of the last period (the total busy time of
+ * all threads including the audio callback one, in period durations) and on the
+ * number of playing voices. The cost of one voice is learned, so a sudden
+ * increase of the voice count activates more threads before the cost of the
+ * period has grown.
+ *
+ * The number of active threads grows immediately but shrinks only by one
+ * thread after the load has stayed low for the shrink delay.
+ *
+ * Not thread safe: it is called from the audio callback only.
+ */
+class GOSoundThreadCountControl {
+public:
+  // the desired busy part of a period for each thread
+  static constexpr float TARGET_LOAD = 0.7f;
+  // the weight of the last period when learning the cost of one voice
+  static constexpr float VOICE_COST_WEIGHT = 0.1f;
+
+private:
+  unsigned m_NThreads;
+  unsigned m_ShrinkDelay;
+
+  unsigned m_NActiveThreads;
+  // how many periods in sequence fewer threads would be enough
+  unsigned m_NPeriodsBelow;
+  // the learned cost of one voice in period durations
+  float m_VoiceCost;
+
+public:
+  GOSoundThreadCountControl() { Init(0, 1); }
+
+  /**
+   * Resets the state. All threads are active until the voice cost is learned
+   * @param nThreads the number of the worker threads
+   * @param shrinkDelay how many periods the load must stay low before one
+   *   thread is parked
+   */
+  void Init(unsigned nThreads, unsigned shrinkDelay);
+
+  unsigned GetNActiveThreads() const { return m_NActiveThreads; }
+
+  /**
+   * Accounts the last period and returns the number of the worker threads to
+   * wake up for the next one
+   * @param periodCost the total busy time of all threads in period durations
+   * @param nVoices the number of playing voices
+   */
+  unsigned Update(float periodCost, unsigned nVoices);
+};
+
+#endif /* GOSOUNDTHREADCOUNTCONTROL_H */
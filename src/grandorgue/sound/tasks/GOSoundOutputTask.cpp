@@ -42,6 +42,17 @@ void GOSoundOutputTask::SetOutputs(
   m_OutputCount = m_Outputs.size() * 2;
 }
 
+bool GOSoundOutputTask::IsOutputUsed(unsigned outputIndex) const {
+  const unsigned nChannels = GetNChannels();
+  const unsigned nFactorsPerChannel = m_ScaleFactors.size() / nChannels;
+
+  for (unsigned i = 0; i < nChannels; i++)
+    for (unsigned j = outputIndex * 2; j < outputIndex * 2 + 2; j++)
+      if (j < nFactorsPerChannel && m_ScaleFactors[i * nFactorsPerChannel + j])
+        return true;
+  return false;
+}
+
 void GOSoundOutputTask::Run(GOSoundThread *pThread) {
   if (m_Done.load())
     return;
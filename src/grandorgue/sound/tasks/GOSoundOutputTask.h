@@ -36,6 +36,8 @@ public:
   ~GOSoundOutputTask();
 
   void SetOutputs(std::vector<GOSoundBufferTaskBase *> outputs);
+  // whether any channel mixes the stereo output with a non-zero factor
+  bool IsOutputUsed(unsigned outputIndex) const;
 
   unsigned GetGroup();
   unsigned GetCost();
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOSoundReverbTask.h"
+
+#include "sound/scheduler/GOSoundThread.h"
+#include "threading/GOMutexLocker.h"
+
+GOSoundReverbTask::GOSoundReverbTask(
+  GOSoundBufferTaskBase &source, unsigned samplesPerBuffer)
+  : GOSoundBufferTaskBase(source.GetNChannels(), samplesPerBuffer),
+    r_source(source),
+    m_reverb(source.GetNChannels()),
+    m_Done(false),
+    m_Stop(false) {}
+
+void GOSoundReverbTask::SetupReverb(
+  const GOSoundReverb::ReverbConfig &config,
+  unsigned nSamplesPerBuffer,
+  unsigned sampleRate) {
+  m_reverb.Setup(config, nSamplesPerBuffer, sampleRate);
+}
+
+unsigned GOSoundReverbTask::GetGroup() { return AUDIOREVERB; }
+
+unsigned GOSoundReverbTask::GetCost() { return 0; }
+
+bool GOSoundReverbTask::GetRepeat() { return false; }
+
+void GOSoundReverbTask::Run(GOSoundThread *pThread) {
+  if (m_Done.load())
+    return;
+  GOMutexLocker locker(m_Mutex, false, "GOSoundReverbTask::Run", pThread);
+
+  if (m_Done.load() || !locker.IsLocked())
+    return;
+
+  r_source.Finish(m_Stop.load(), pThread);
+  if (pThread && pThread->ShouldStop())
+    return;
+
+  CopyFrom(r_source);
+  m_reverb.Process(GetData(), GetNFrames());
+  m_Done.store(true);
+}
+
+void GOSoundReverbTask::Exec() { Run(); }
+
+void GOSoundReverbTask::Finish(bool stop, GOSoundThread *pThread) {
+  if (stop)
+    m_Stop.store(true);
+  if (!m_Done.load())
+    Run(pThread);
+}
+
+void GOSoundReverbTask::Clear() { m_reverb.Reset(); }
+
+void GOSoundReverbTask::Reset() {
+  GOMutexLocker locker(m_Mutex);
+  m_Done.store(false);
+  m_Stop.store(false);
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOSOUNDREVERBTASK_H
+#define GOSOUNDREVERBTASK_H
+
+#include <atomic>
+
+#include "sound/reverb/GOSoundReverb.h"
+#include "threading/GOMutex.h"
+
+#include "GOSoundBufferTaskBase.h"
+
+/**
+ * Applies the reverb to a stereo source bus, i.e. an audio group.
+ *
+ * The reverb is linear, so reverberating the buses before the output matrix
+ * gives the same result as reverberating each output channel after it. The
+ * output tasks and the downmix task then mix this task instead of the source,
+ * so each bus is convolved once per period however many outputs use it.
+ */
+class GOSoundReverbTask : public GOSoundBufferTaskBase {
+private:
+  GOSoundBufferTaskBase &r_source;
+  GOSoundReverb m_reverb;
+  GOMutex m_Mutex;
+  std::atomic_bool m_Done;
+  std::atomic_bool m_Stop;
+
+public:
+  GOSoundReverbTask(GOSoundBufferTaskBase &source, unsigned samplesPerBuffer);
+
+  void SetupReverb(
+    const GOSoundReverb::ReverbConfig &config,
+    unsigned nSamplesPerBuffer,
+    unsigned sampleRate);
+
+  unsigned GetGroup() override;
+  unsigned GetCost() override;
+  bool GetRepeat() override;
+  void Run(GOSoundThread *pThread = nullptr) override;
+  void Exec() override;
+  void Finish(bool stop, GOSoundThread *pThread = nullptr) override;
+
+  void Clear() override;
+  void Reset() override;
+};
+
+#endif /* GOSOUNDREVERBTASK_H */
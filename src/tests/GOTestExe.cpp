@@ -10,7 +10,13 @@
 #include <string>
 
 #include "common/GOTestCollection.h"
+#include "testing/GOTestCacheFile.h"
+#include "testing/GOTestCacheRecord.h"
+#include "testing/GOTestLzCodec.h"
+#include "testing/GOTestMemoryPool.h"
 #include "testing/GOTestNameMap.h"
+#include "testing/GOTestRandom.h"
+#include "testing/midi/GOTestMidiFile.h"
 #include "testing/model/GOTestDrawStop.h"
 #include "testing/model/GOTestOrganModel.h"
 #include "testing/model/GOTestSwitch.h"
@@ -22,6 +28,9 @@
 #include "testing/sound/buffer/GOTestSoundBufferMutableMono.h"
 #include "testing/sound/playing/GOTestReleaseAlignTable.h"
 #include "testing/sound/playing/GOTestSoundStream.h"
+#include "testing/sound/scheduler/GOTestSoundThreadCountControl.h"
+#include "testing/sound/GOTestSoundLatencyProbe.h"
+#include "testing/threading/GOTestRealtimeLog.h"
 
 int main(int argc, char *argv[]) {
   /*
@@ -50,7 +59,13 @@ int main(int argc, char *argv[]) {
   GOTestOrganModel testOrganModel;
   GOTestSwitch testSwitch;
   GOTestWindchest testWindchest;
+  GOTestCacheFile testCacheFile;
+  GOTestCacheRecord testCacheRecord;
+  GOTestLzCodec testLzCodec;
+  GOTestMemoryPool testMemoryPool;
   GOTestNameMap goTestNameMap;
+  GOTestRandom testRandom;
+  GOTestMidiFile testMidiFile;
   GOTestSoundBuffer goTestSoundBuffer;
   GOTestSoundBufferManaged testSoundBufferManaged;
   GOTestSoundBufferMutable testSoundBufferMutable;
@@ -58,6 +73,9 @@ int main(int argc, char *argv[]) {
   GOTestPerfSoundBufferMutable testPerfSoundBufferMutable;
   GOTestReleaseAlignTable testReleaseAlignTable;
   GOTestSoundStream testSoundStream;
+  GOTestSoundThreadCountControl testSoundThreadCountControl;
+  GOTestSoundLatencyProbe testSoundLatencyProbe;
+  GOTestRealtimeLog testRealtimeLog;
   /* end of instanciation */
   GOTestResultCollection test_result_collection;
   test_result_collection = GOTestCollection::Instance()->Run(categoryFilter);
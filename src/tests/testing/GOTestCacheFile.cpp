@@ -0,0 +1,121 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOTestCacheFile.h"
+
+#include <format>
+#include <vector>
+
+#include <wx/filefn.h>
+#include <wx/filename.h>
+#include <wx/wfstream.h>
+
+#include "loader/GOProgressMonitor.h"
+#include "loader/cache/GOCacheWriter.h"
+#include "model/GOCacheObject.h"
+
+#include "GOHash.h"
+
+const std::string GOTestCacheFile::TEST_NAME = "GOTestCacheFile";
+
+static constexpr unsigned N_OBJECTS = 3;
+
+namespace {
+
+class TestObject : public GOCacheObject {
+  wxString m_title = wxT("test object");
+
+protected:
+  void Initialize() override {}
+  void LoadData(const GOFileStore &fileStore, GOMemoryPool &pool) override {}
+  bool LoadCache(GOMemoryPool &pool, GOCache &cache) override { return true; }
+
+public:
+  bool SaveCache(GOCacheWriter &cache) const override { return true; }
+  void UpdateHash(GOHash &hash) const override {}
+  const wxString &GetLoadTitle() const override { return m_title; }
+};
+
+class TestMonitor : public GOProgressMonitor {
+public:
+  void Setup(long max, const wxString &title, const wxString &msg) override {}
+  void Reset(long max, const wxString &msg) override {}
+  bool Update(unsigned value, const wxString &msg) override { return true; }
+};
+
+} // namespace
+
+void GOTestCacheFile::CheckAllFromFiles(
+  const std::string &label, const wxString &fileName) {
+  TestObject objects[N_OBJECTS];
+  std::vector<GOCacheObject *> allObjects;
+  std::vector<GOCacheObject *> fileObjects;
+  TestMonitor monitor;
+
+  for (TestObject &obj : objects)
+    allObjects.push_back(&obj);
+
+  GOCacheObjectDistributor distributor(allObjects);
+  const bool isCacheOk
+    = controller->LoadCacheFile(fileName, distributor, fileObjects, monitor);
+
+  GOAssert(!isCacheOk, std::format("{}: the cache is accepted", label));
+  GOAssert(
+    fileObjects == allObjects,
+    std::format(
+      "{}: {} of {} objects are to be loaded from the files",
+      label,
+      fileObjects.size(),
+      allObjects.size()));
+}
+
+void GOTestCacheFile::TestAbsent() {
+  const wxString fileName = wxFileName::CreateTempFileName(wxT("GOTestCache"));
+
+  wxRemoveFile(fileName);
+  CheckAllFromFiles("TestAbsent", fileName);
+}
+
+void GOTestCacheFile::TestBadMagic() {
+  const wxString fileName = wxFileName::CreateTempFileName(wxT("GOTestCache"));
+
+  {
+    wxFileOutputStream stream(fileName);
+    const char content[] = "not a cache file";
+
+    stream.Write(content, sizeof(content));
+  }
+  CheckAllFromFiles("TestBadMagic", fileName);
+  wxRemoveFile(fileName);
+}
+
+void GOTestCacheFile::TestStaleHash() {
+  const wxString fileName = wxFileName::CreateTempFileName(wxT("GOTestCache"));
+
+  {
+    wxFileOutputStream stream(fileName);
+    GOCacheWriter writer(stream, false);
+    GOHashType staleHash = {};
+
+    writer.WriteHeader();
+    writer.Write(&staleHash, sizeof(staleHash));
+    // all the objects are marked as cached
+    for (unsigned i = 0; i < N_OBJECTS; i++) {
+      const uint8_t isCached = 1;
+
+      writer.Write(&isCached, sizeof(isCached));
+    }
+    writer.Close();
+  }
+  CheckAllFromFiles("TestStaleHash", fileName);
+  wxRemoveFile(fileName);
+}
+
+void GOTestCacheFile::run() {
+  TestAbsent();
+  TestBadMagic();
+  TestStaleHash();
+}
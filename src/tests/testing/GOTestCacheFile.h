@@ -0,0 +1,48 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOTESTCACHEFILE_H
+#define GOTESTCACHEFILE_H
+
+#include <string>
+
+#include <wx/string.h>
+
+#include "GOTest.h"
+
+class GOTestCacheFile : public GOCommonControllerTest {
+private:
+  static const std::string TEST_NAME;
+
+  /**
+   * Loads the objects with the cache file and checks that all of them are
+   * left for loading from the sample files
+   */
+  void CheckAllFromFiles(const std::string &label, const wxString &fileName);
+
+  /**
+   * All the objects must be loaded from the files if the cache file is absent
+   */
+  void TestAbsent();
+
+  /**
+   * All the objects must be loaded from the files if the cache file is not a
+   * cache or has a different magic
+   */
+  void TestBadMagic();
+
+  /**
+   * All the objects must be loaded from the files if the cache file has been
+   * written with other settings
+   */
+  void TestStaleHash();
+
+public:
+  std::string GetName() override { return TEST_NAME; }
+  void run() override;
+};
+
+#endif /* GOTESTCACHEFILE_H */
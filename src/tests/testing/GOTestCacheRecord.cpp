@@ -0,0 +1,126 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOTestCacheRecord.h"
+
+#include <cstring>
+#include <format>
+
+#include "GOCacheRecord.h"
+
+const std::string GOTestCacheRecord::TEST_NAME = "GOTestCacheRecord";
+
+// copies the stored fields to a new record as a reader gets them from a file
+static void copy_for_reading(const GOCacheRecord &from, GOCacheRecord &to) {
+  memcpy(to.PrepareForReading(from.GetSize()), from.GetData(), from.GetSize());
+}
+
+void GOTestCacheRecord::TestRoundTrip() {
+  GOCacheRecord written;
+
+  written.PutUInt(0x01020304);
+  written.PutInt(-5);
+  written.PutFloat(0.25f);
+  written.PutBool(true);
+  written.PutUInt(200);
+  written.PutInt(-1);
+
+  GOAssert(
+    written.GetSize() == 21,
+    std::format("The record takes {} bytes instead of 21", written.GetSize()));
+
+  const uint8_t *data = written.GetData();
+
+  GOAssert(
+    data[0] == 4 && data[1] == 3 && data[2] == 2 && data[3] == 1,
+    "The integer is not stored in the little endian byte order");
+
+  GOCacheRecord read;
+  uint32_t u = 0;
+  int32_t i = 0;
+  float f = 0;
+  bool b = false;
+  uint8_t u8 = 0;
+  int8_t i8 = 0;
+
+  copy_for_reading(written, read);
+  GOAssert(
+    read.GetUInt(u) && u == 0x01020304,
+    std::format("The unsigned field is read as {}", u));
+  GOAssert(
+    read.GetInt(i) && i == -5, std::format("The int field is read as {}", i));
+  GOAssert(
+    read.GetFloat(f) && f == 0.25f,
+    std::format("The float field is read as {}", f));
+  GOAssert(read.GetBool(b) && b, "The bool field is not read");
+  GOAssert(
+    read.GetUInt(u8) && u8 == 200,
+    std::format("The uint8_t field is read as {}", u8));
+  GOAssert(
+    read.GetInt(i8) && i8 == -1,
+    std::format("The int8_t field is read as {}", i8));
+  GOAssert(!read.GetUInt(u), "A field is read after the end of the record");
+}
+
+void GOTestCacheRecord::TestCompatibility() {
+  GOCacheRecord older;
+  GOCacheRecord newer;
+  GOCacheRecord read;
+
+  older.PutUInt(7);
+  newer.PutUInt(7);
+  newer.PutBool(true);
+  newer.PutUInt(9);
+
+  // a newer reader gets a record without the field appended later
+  uint32_t known = 0;
+  bool appended = false;
+
+  copy_for_reading(older, read);
+  GOAssert(read.GetUInt(known) && known == 7, "The known field is not read");
+  GOAssert(
+    !read.GetBool(appended) && !appended,
+    "The missing field has changed its default value");
+
+  // an older reader knows only the first field of a newer record
+  copy_for_reading(newer, read);
+  known = 0;
+  GOAssert(
+    read.GetUInt(known) && known == 7,
+    "The known field of a newer record is not read");
+}
+
+void GOTestCacheRecord::TestRange() {
+  GOCacheRecord written;
+  GOCacheRecord read;
+  uint8_t u8 = 1;
+  int8_t i8 = 1;
+  bool b = false;
+  GOBool3 b3 = BOOL3_FALSE;
+
+  written.PutUInt(256);
+  written.PutInt(-129);
+  written.PutBool(true);
+  written.PutInt(BOOL3_MAX + 1);
+  written.PutInt(BOOL3_DEFAULT);
+  // change the bool to an invalid value
+  copy_for_reading(written, read);
+  read.PrepareForReading(read.GetSize())[8] = 2;
+  GOAssert(!read.GetUInt(u8) && u8 == 1, "256 is read as uint8_t");
+  GOAssert(!read.GetInt(i8) && i8 == 1, "-129 is read as int8_t");
+  GOAssert(!read.GetBool(b) && !b, "2 is read as bool");
+  GOAssert(
+    !read.GetBool3(b3) && b3 == BOOL3_FALSE,
+    std::format("{} is read as GOBool3", BOOL3_MAX + 1));
+  GOAssert(
+    read.GetBool3(b3) && b3 == BOOL3_DEFAULT, "BOOL3_DEFAULT is not read");
+}
+
+void GOTestCacheRecord::run() {
+  TestRoundTrip();
+  TestCompatibility();
+  TestRange();
+}
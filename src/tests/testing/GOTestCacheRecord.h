@@ -0,0 +1,40 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOTESTCACHERECORD_H
+#define GOTESTCACHERECORD_H
+
+#include <string>
+
+#include "GOTest.h"
+
+class GOTestCacheRecord : public GOTest {
+private:
+  static const std::string TEST_NAME;
+
+  /**
+   * The fields must be restored exactly and stored in the little endian byte
+   * order independently of the platform
+   */
+  void TestRoundTrip();
+
+  /**
+   * A field missing in an older record must keep its default value, and the
+   * extra fields of a newer record must not disturb the known ones
+   */
+  void TestCompatibility();
+
+  /**
+   * The values not fitting the requested type must be rejected
+   */
+  void TestRange();
+
+public:
+  std::string GetName() override { return TEST_NAME; }
+  void run() override;
+};
+
+#endif /* GOTESTCACHERECORD_H */
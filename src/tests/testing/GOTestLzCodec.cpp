@@ -0,0 +1,172 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOTestLzCodec.h"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <random>
+
+#include "GOLzCodec.h"
+
+const std::string GOTestLzCodec::TEST_NAME = "GOTestLzCodec";
+
+static std::vector<uint8_t> make_random(size_t size, unsigned seed) {
+  std::mt19937 generator(seed);
+  std::vector<uint8_t> data(size);
+
+  for (uint8_t &b : data)
+    b = (uint8_t)generator();
+  return data;
+}
+
+// 16-bit stereo little-endian samples of a sine wave with a little noise
+static std::vector<uint8_t> make_pcm(unsigned nFrames) {
+  std::mt19937 generator(1);
+  std::vector<uint8_t> data;
+
+  for (unsigned i = 0; i < nFrames; i++)
+    for (unsigned channel = 0; channel < 2; channel++) {
+      const int16_t sample = (int16_t)(
+        8000 * std::sin(i * 0.01 + channel) + (int)(generator() % 16) - 8);
+
+      data.push_back((uint8_t)sample);
+      data.push_back((uint8_t)(sample >> 8));
+    }
+  return data;
+}
+
+static size_t compress(
+  const std::vector<uint8_t> &data, std::vector<uint8_t> &compressed) {
+  compressed.resize(GOLzCodec::getMaxCompressedSize(data.size()));
+
+  const size_t size = GOLzCodec::compress(
+    data.data(), data.size(), compressed.data(), compressed.size());
+
+  compressed.resize(size);
+  return size;
+}
+
+size_t GOTestLzCodec::CheckRoundTrip(
+  const std::string &name, std::vector<uint8_t> data) {
+  std::vector<uint8_t> compressed;
+  const size_t compressedSize = compress(data, compressed);
+  // a guard byte after the output
+  std::vector<uint8_t> restored(data.size() + 1, 0xA5);
+
+  GOAssert(
+    compressedSize > 0,
+    std::format("{}: {} bytes are not compressed", name, data.size()));
+  GOAssert(
+    GOLzCodec::decompress(
+      compressed.data(), compressedSize, restored.data(), data.size()),
+    std::format("{}: the decompression failed", name));
+  GOAssert(
+    std::equal(data.begin(), data.end(), restored.begin()),
+    std::format("{}: the restored data differs", name));
+  GOAssert(
+    restored[data.size()] == 0xA5,
+    std::format("{}: the output buffer is overrun", name));
+  return compressedSize;
+}
+
+void GOTestLzCodec::TestRoundTrip() {
+  CheckRoundTrip("TestRoundTrip empty", {});
+  CheckRoundTrip("TestRoundTrip short", {1, 2, 3});
+  CheckRoundTrip("TestRoundTrip zeros", std::vector<uint8_t>(100000, 0));
+  CheckRoundTrip("TestRoundTrip random", make_random(100000, 1));
+  CheckRoundTrip("TestRoundTrip pcm", make_pcm(50000));
+
+  // long literal runs followed by long matches
+  std::vector<uint8_t> mixed = make_random(1000, 2);
+  const std::vector<uint8_t> copy = mixed;
+
+  mixed.insert(mixed.end(), copy.begin(), copy.end());
+  mixed.insert(mixed.end(), 5000, 7);
+  mixed.insert(mixed.end(), copy.begin(), copy.begin() + 300);
+  CheckRoundTrip("TestRoundTrip mixed", mixed);
+
+  // a match at the maximal offset
+  std::vector<uint8_t> far = make_random(GOLzCodec::MAX_OFFSET, 3);
+  const std::vector<uint8_t> farStart(far.begin(), far.begin() + 100);
+
+  far.insert(far.end(), farStart.begin(), farStart.end());
+  CheckRoundTrip("TestRoundTrip far", far);
+}
+
+void GOTestLzCodec::TestRatio() {
+  const size_t zerosSize = CheckRoundTrip(
+    "TestRatio zeros", std::vector<uint8_t>(100000, 0));
+  const size_t randomSize
+    = CheckRoundTrip("TestRatio random", make_random(100000, 4));
+
+  GOAssert(
+    zerosSize < 1000,
+    std::format("TestRatio: zeros are compressed to {} bytes", zerosSize));
+  GOAssert(
+    randomSize <= GOLzCodec::getMaxCompressedSize(100000),
+    std::format("TestRatio: random data grew to {} bytes", randomSize));
+}
+
+void GOTestLzCodec::TestDelta() {
+  const std::vector<uint8_t> pcm = make_pcm(50000);
+  std::vector<uint8_t> filtered = pcm;
+
+  GOLzCodec::encodeDelta(filtered.data(), filtered.size(), 4);
+
+  const size_t plainSize = CheckRoundTrip("TestDelta plain", pcm);
+  const size_t filteredSize = CheckRoundTrip("TestDelta filtered", filtered);
+
+  GOAssert(
+    filteredSize < plainSize,
+    std::format(
+      "TestDelta: the filtered PCM takes {} bytes, the plain one {} bytes",
+      filteredSize,
+      plainSize));
+  GOLzCodec::decodeDelta(filtered.data(), filtered.size(), 4);
+  GOAssert(filtered == pcm, "TestDelta: the filter is not reverted exactly");
+}
+
+void GOTestLzCodec::TestCorrupted() {
+  std::vector<uint8_t> data = make_random(1000, 5);
+  const std::vector<uint8_t> copy = data;
+
+  data.insert(data.end(), copy.begin(), copy.end());
+
+  std::vector<uint8_t> compressed;
+  const size_t compressedSize = compress(data, compressed);
+  std::vector<uint8_t> restored(data.size() + 1);
+
+  GOAssert(
+    !GOLzCodec::decompress(
+      compressed.data(), compressedSize - 1, restored.data(), data.size()),
+    "TestCorrupted: the truncated data is decompressed");
+  GOAssert(
+    !GOLzCodec::decompress(
+      compressed.data(), compressedSize, restored.data(), data.size() - 1),
+    "TestCorrupted: the data is decompressed to a smaller buffer");
+  GOAssert(
+    !GOLzCodec::decompress(
+      compressed.data(), compressedSize, restored.data(), data.size() + 1),
+    "TestCorrupted: the data is decompressed to a bigger buffer");
+
+  // damage the data at each position. It must not crash
+  for (size_t i = 0; i < compressedSize; i++) {
+    std::vector<uint8_t> damaged = compressed;
+
+    damaged[i] ^= 0xFF;
+    GOLzCodec::decompress(
+      damaged.data(), damaged.size(), restored.data(), data.size());
+  }
+}
+
+void GOTestLzCodec::run() {
+  TestRoundTrip();
+  TestRatio();
+  TestDelta();
+  TestCorrupted();
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOTESTLZCODEC_H
+#define GOTESTLZCODEC_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "GOTest.h"
+
+class GOTestLzCodec : public GOTest {
+private:
+  static const std::string TEST_NAME;
+
+  /**
+   * Compresses and decompresses the data and checks that the result is the
+   * same. Returns the compressed size
+   */
+  size_t CheckRoundTrip(const std::string &name, std::vector<uint8_t> data);
+
+  /**
+   * Empty, short, repeating, random and PCM-like data must be restored exactly
+   */
+  void TestRoundTrip();
+
+  /**
+   * Repeating data must be compressed and random data must not grow more than
+   * getMaxCompressedSize() allows
+   */
+  void TestRatio();
+
+  /**
+   * The delta filter must be reverted exactly and must make a slowly changing
+   * PCM signal more compressible
+   */
+  void TestDelta();
+
+  /**
+   * Truncated or damaged data and a wrong output size must be reported as
+   * errors without writing outside the output buffer
+   */
+  void TestCorrupted();
+
+public:
+  std::string GetName() override { return TEST_NAME; }
+  void run() override;
+};
+
+#endif /* GOTESTLZCODEC_H */
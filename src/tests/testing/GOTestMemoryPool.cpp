@@ -0,0 +1,199 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOTestMemoryPool.h"
+
+#include <cstdint>
+#include <cstring>
+#include <format>
+
+#include "GOMemoryPool.h"
+
+const std::string GOTestMemoryPool::TEST_NAME = "GOTestMemoryPool";
+
+static constexpr size_t BLOCK_SIZE = 100000;
+
+void GOTestMemoryPool::TestReuse() {
+  GOMemoryPool pool;
+  char *const block1 = (char *)pool.Alloc(BLOCK_SIZE, true);
+  char *const block2 = (char *)pool.Alloc(BLOCK_SIZE, true);
+
+  GOAssert(block1 && block2, "TestReuse: the pool is not available");
+  GOAssert(
+    (uintptr_t)block2 % GOMemoryPool::ALLOC_ALIGN == 0,
+    "TestReuse: the block is not aligned");
+  memset(block1, 1, BLOCK_SIZE);
+  pool.Free(block1);
+
+  const GOMemoryPool::FragmentationStat stat = pool.GetFragmentationStat();
+
+  GOAssert(
+    stat.m_NFreeBlocks == 1 && stat.m_FreeSize >= BLOCK_SIZE,
+    std::format(
+      "TestReuse: {} free blocks of {} bytes after freeing",
+      stat.m_NFreeBlocks,
+      stat.m_FreeSize));
+
+  char *const block3 = (char *)pool.Alloc(BLOCK_SIZE / 2, true);
+
+  GOAssert(block3 == block1, "TestReuse: the freed block is not reused");
+  GOAssert(
+    pool.GetFragmentationStat().m_FreeSize >= BLOCK_SIZE / 2
+      - GOMemoryPool::ALLOC_ALIGN,
+    "TestReuse: the rest of the free block is lost");
+  pool.Free(block3);
+  pool.Free(block2);
+}
+
+void GOTestMemoryPool::TestCoalescing() {
+  GOMemoryPool pool;
+  char *const block1 = (char *)pool.Alloc(BLOCK_SIZE, true);
+  char *const block2 = (char *)pool.Alloc(BLOCK_SIZE, true);
+  char *const block3 = (char *)pool.Alloc(BLOCK_SIZE, true);
+  char *const block4 = (char *)pool.Alloc(BLOCK_SIZE, true);
+  const size_t unusedSize = pool.GetFragmentationStat().m_UnusedSize;
+
+  pool.Free(block1);
+  pool.Free(block3);
+  GOAssert(
+    pool.GetFragmentationStat().m_NFreeBlocks == 2,
+    "TestCoalescing: the separate free blocks are merged");
+  pool.Free(block2);
+
+  GOMemoryPool::FragmentationStat stat = pool.GetFragmentationStat();
+
+  GOAssert(
+    stat.m_NFreeBlocks == 1 && stat.m_LargestFreeBlock >= 3 * BLOCK_SIZE,
+    std::format(
+      "TestCoalescing: {} free blocks, the largest is {} bytes",
+      stat.m_NFreeBlocks,
+      stat.m_LargestFreeBlock));
+
+  char *const block5 = (char *)pool.Alloc(3 * BLOCK_SIZE, true);
+
+  GOAssert(
+    block5 == block1, "TestCoalescing: the merged block is not reused");
+  pool.Free(block5);
+  pool.Free(block4);
+  stat = pool.GetFragmentationStat();
+  GOAssert(
+    stat.m_NFreeBlocks == 0 && stat.m_UnusedSize >= unusedSize + 4 * BLOCK_SIZE,
+    "TestCoalescing: the freed blocks do not return to the unused range");
+  GOAssert(
+    pool.GetAllocSize() == 0,
+    std::format(
+      "TestCoalescing: {} bytes are still allocated", pool.GetAllocSize()));
+}
+
+void GOTestMemoryPool::TestBoundedGrowth() {
+  static constexpr unsigned N_BLOCKS = 50;
+  // the sizes are multiples of ALLOC_ALIGN, so the blocks are not rounded
+  static constexpr size_t SIZE_STEP = 1024;
+  // less than SIZE_STEP / 2 and not less than MIN_SPLIT_SIZE
+  static constexpr size_t SHRINK = 512;
+
+  GOMemoryPool pool;
+  char *blocks[N_BLOCKS];
+  size_t sizes[N_BLOCKS];
+  size_t poolUsage = 0;
+
+  for (unsigned i = 0; i < N_BLOCKS; i++)
+    sizes[i] = BLOCK_SIZE + i * SIZE_STEP;
+  for (unsigned round = 0; round < 10; round++) {
+    for (unsigned i = 0; i < N_BLOCKS; i++)
+      blocks[i] = (char *)pool.Alloc(sizes[i], true);
+
+    // free the even blocks leaving the holes between the odd ones
+    size_t freeSize = 0;
+
+    for (unsigned i = 0; i < N_BLOCKS; i += 2) {
+      pool.Free(blocks[i]);
+      freeSize += sizes[i];
+    }
+
+    GOMemoryPool::FragmentationStat stat = pool.GetFragmentationStat();
+
+    GOAssert(
+      stat.m_NFreeBlocks == N_BLOCKS / 2 && stat.m_FreeSize == freeSize,
+      std::format(
+        "TestBoundedGrowth: {} free blocks of {} bytes after freeing the even "
+        "blocks instead of {} of {}",
+        stat.m_NFreeBlocks,
+        stat.m_FreeSize,
+        N_BLOCKS / 2,
+        freeSize));
+
+    // a bit smaller blocks fit only into the same holes. Each hole is split
+    for (unsigned i = 0; i < N_BLOCKS; i += 2) {
+      char *const block = (char *)pool.Alloc(sizes[i] - SHRINK, true);
+
+      GOAssert(
+        block == blocks[i],
+        std::format("TestBoundedGrowth: block {} is not the best fit", i));
+    }
+    stat = pool.GetFragmentationStat();
+    GOAssert(
+      stat.m_NFreeBlocks == N_BLOCKS / 2
+        && stat.m_FreeSize == N_BLOCKS / 2 * SHRINK,
+      std::format(
+        "TestBoundedGrowth: {} free blocks of {} bytes are left of the holes",
+        stat.m_NFreeBlocks,
+        stat.m_FreeSize));
+
+    // each odd block is merged with the rest of the hole before it. The last
+    // one returns to the unused range
+    freeSize = 0;
+    for (unsigned i = 1; i < N_BLOCKS; i += 2) {
+      pool.Free(blocks[i]);
+      if (i + 1 < N_BLOCKS)
+        freeSize += sizes[i] + SHRINK;
+    }
+    stat = pool.GetFragmentationStat();
+    GOAssert(
+      stat.m_NFreeBlocks == N_BLOCKS / 2 - 1 && stat.m_FreeSize == freeSize
+        && stat.m_LargestFreeBlock == sizes[N_BLOCKS - 3] + SHRINK,
+      std::format(
+        "TestBoundedGrowth: {} free blocks of {} bytes, the largest is {} "
+        "bytes after merging",
+        stat.m_NFreeBlocks,
+        stat.m_FreeSize,
+        stat.m_LargestFreeBlock));
+
+    // a bit larger blocks fit only into the merged holes
+    for (unsigned i = 1; i < N_BLOCKS; i += 2) {
+      blocks[i] = (char *)pool.Alloc(sizes[i] + SHRINK, true);
+      GOAssert(
+        i + 1 == N_BLOCKS
+          || blocks[i] == blocks[i - 1] + sizes[i - 1] - SHRINK,
+        std::format(
+          "TestBoundedGrowth: block {} is not in the merged hole", i));
+    }
+    GOAssert(
+      pool.GetFragmentationStat().m_NFreeBlocks == 0,
+      "TestBoundedGrowth: the merged holes are not filled");
+
+    for (unsigned i = 0; i < N_BLOCKS; i++)
+      pool.Free(blocks[i]);
+    if (!round)
+      poolUsage = pool.GetPoolUsage();
+  }
+  GOAssert(
+    pool.GetPoolUsage() == poolUsage,
+    std::format(
+      "TestBoundedGrowth: the pool grew from {} to {} bytes",
+      poolUsage,
+      pool.GetPoolUsage()));
+  GOAssert(
+    pool.GetAllocSize() == 0,
+    std::format(
+      "TestBoundedGrowth: {} bytes are still allocated", pool.GetAllocSize()));
+}
+
+void GOTestMemoryPool::run() {
+  TestReuse();
+  TestCoalescing();
+  TestBoundedGrowth();
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOTESTMEMORYPOOL_H
+#define GOTESTMEMORYPOOL_H
+
+#include <string>
+
+#include "GOTest.h"
+
+class GOTestMemoryPool : public GOTest {
+private:
+  static const std::string TEST_NAME;
+
+  /**
+   * A freed block must be reused by the next allocation of the same size
+   */
+  void TestReuse();
+
+  /**
+   * The adjacent free blocks must be merged, and the blocks freed at the end
+   * of the used range must return to the unused range
+   */
+  void TestCoalescing();
+
+  /**
+   * The holes left between the allocated blocks must be filled with the best
+   * fitting allocations, and the neighbouring free blocks must be merged, so
+   * fragmenting the pool the same way many times does not grow it
+   */
+  void TestBoundedGrowth();
+
+public:
+  std::string GetName() override { return TEST_NAME; }
+  void run() override;
+};
+
+#endif /* GOTESTMEMORYPOOL_H */
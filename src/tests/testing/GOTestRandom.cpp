@@ -0,0 +1,99 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOTestRandom.h"
+
+#include <format>
+#include <thread>
+#include <vector>
+
+#include "GORandom.h"
+
+const std::string GOTestRandom::TEST_NAME = "GOTestRandom";
+
+static constexpr unsigned N_VALUES = 1000;
+
+static std::vector<uint32_t> generate(unsigned n) {
+  std::vector<uint32_t> values;
+
+  for (unsigned i = 0; i < n; i++)
+    values.push_back(GORandom::next());
+  return values;
+}
+
+void GOTestRandom::TestReproducibility() {
+  GORandom::seedThread(42);
+
+  const std::vector<uint32_t> first = generate(N_VALUES);
+
+  GORandom::seedThread(42);
+
+  const std::vector<uint32_t> second = generate(N_VALUES);
+
+  GORandom::seedThread(43);
+
+  const std::vector<uint32_t> other = generate(N_VALUES);
+
+  GOAssert(
+    first == second,
+    "TestReproducibility: the same seed gave different sequences");
+  GOAssert(
+    first != other,
+    "TestReproducibility: different seeds gave the same sequence");
+}
+
+void GOTestRandom::TestRanges() {
+  constexpr unsigned N_BUCKETS = 7;
+  unsigned counts[N_BUCKETS] = {};
+
+  GORandom::seedThread(0);
+  for (unsigned i = 0; i < N_VALUES; i++) {
+    const unsigned value = GORandom::nextBelow(N_BUCKETS);
+    const float signedValue = GORandom::nextSigned();
+
+    GOAssert(
+      value < N_BUCKETS,
+      std::format("TestRanges: nextBelow returned {}", value));
+    GOAssert(
+      signedValue >= -1.0f && signedValue < 1.0f,
+      std::format("TestRanges: nextSigned returned {}", signedValue));
+    counts[value]++;
+  }
+  for (unsigned i = 0; i < N_BUCKETS; i++)
+    GOAssert(
+      counts[i] > N_VALUES / N_BUCKETS / 2,
+      std::format("TestRanges: the value {} occurred {} times", i, counts[i]));
+}
+
+void GOTestRandom::TestThreadIndependence() {
+  std::vector<uint32_t> expected;
+  std::vector<uint32_t> actual;
+
+  std::thread([&]() {
+    GORandom::seedThread(7);
+    expected = generate(N_VALUES);
+  }).join();
+  std::thread([&]() {
+    GORandom::seedThread(7);
+
+    std::thread other([]() {
+      GORandom::seedThread(8);
+      generate(N_VALUES);
+    });
+
+    actual = generate(N_VALUES);
+    other.join();
+  }).join();
+  GOAssert(
+    expected == actual,
+    "TestThreadIndependence: another thread changed the sequence");
+}
+
+void GOTestRandom::run() {
+  TestReproducibility();
+  TestRanges();
+  TestThreadIndependence();
+}
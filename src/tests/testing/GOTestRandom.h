@@ -0,0 +1,38 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOTESTRANDOM_H
+#define GOTESTRANDOM_H
+
+#include <string>
+
+#include "GOTest.h"
+
+class GOTestRandom : public GOTest {
+private:
+  static const std::string TEST_NAME;
+
+  /**
+   * The same seed must give the same sequence
+   */
+  void TestReproducibility();
+
+  /**
+   * The values must stay in their ranges and cover all values of a small range
+   */
+  void TestRanges();
+
+  /**
+   * Seeding a thread must not change the sequence of another thread
+   */
+  void TestThreadIndependence();
+
+public:
+  std::string GetName() override { return TEST_NAME; }
+  void run() override;
+};
+
+#endif /* GOTESTRANDOM_H */
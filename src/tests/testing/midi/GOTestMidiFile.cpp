@@ -0,0 +1,192 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOTestMidiFile.h"
+
+#include <cstdint>
+#include <format>
+#include <vector>
+
+#include <wx/file.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+
+#include "midi/GOMidiMap.h"
+#include "midi/GOMidiPlayerContent.h"
+#include "midi/files/GOMidiFileReader.h"
+
+const std::string GOTestMidiFile::TEST_NAME = "GOTestMidiFile";
+
+/*
+ * With 100 ticks per quarter the initial tempo of 120 BPM gives 5 ms per tick.
+ * The first track changes the tempo to 240 BPM (2.5 ms per tick) at tick 100
+ */
+static const std::vector<uint8_t> TRACK0 = {
+  0x00, 0xB0, 0x07, 0x64,                   // 0: volume 100
+  0x64, 0xFF, 0x51, 0x03, 0x03, 0xD0, 0x90, // 100: tempo 250000 us
+  0x00, 0x90, 0x3C, 0x40,                   // 100: note 60 on
+  0x64, 0x80, 0x3C, 0x00,                   // 200: note 60 off
+  0x00, 0xFF, 0x2F, 0x00                    // end of track
+};
+static const std::vector<uint8_t> TRACK1 = {
+  0x00, 0xC0, 0x05,       // 0: program 6
+  0x64, 0xB0, 0x07, 0x50, // 100: volume 80
+  0x00, 0x91, 0x40, 0x40, // 100: note 64 on the channel 2
+  0x32, 0xB0, 0x07, 0x60, // 150: volume 96
+  0x32, 0xFF, 0x2F, 0x00  // end of track
+};
+
+static void append_chunk(
+  std::vector<uint8_t> &data, const char *type, const std::vector<uint8_t> &c) {
+  const uint32_t len = c.size();
+
+  data.insert(data.end(), type, type + 4);
+  for (int shift = 24; shift >= 0; shift -= 8)
+    data.push_back((uint8_t)(len >> shift));
+  data.insert(data.end(), c.begin(), c.end());
+}
+
+void GOTestMidiFile::CheckEvent(
+  const std::string &label, const GOMidiEvent &e, const ExpectedEvent &exp) {
+  GOAssert(
+    e.GetMidiType() == exp.m_type && e.GetChannel() == exp.m_channel
+      && e.GetKey() == exp.m_key
+      && (exp.m_value < 0 || e.GetValue() == exp.m_value)
+      && e.GetTime() == exp.m_time,
+    std::format(
+      "{}: got type {} channel {} key {} value {} at {} ms instead of type {} "
+      "channel {} key {} value {} at {} ms",
+      label,
+      (int)e.GetMidiType(),
+      e.GetChannel(),
+      e.GetKey(),
+      e.GetValue(),
+      e.GetTime().ToLong(),
+      (int)exp.m_type,
+      exp.m_channel,
+      exp.m_key,
+      exp.m_value,
+      exp.m_time));
+}
+
+bool GOTestMidiFile::setUp() {
+  // type 1, 2 tracks, 100 ticks per quarter
+  std::vector<uint8_t> data;
+
+  append_chunk(data, "MThd", {0x00, 0x01, 0x00, 0x02, 0x00, 0x64});
+  append_chunk(data, "MTrk", TRACK0);
+  append_chunk(data, "MTrk", TRACK1);
+
+  wxFile file;
+
+  m_FileName = wxFileName::CreateTempFileName(wxT("GOTestMidiFile"));
+  return file.Open(m_FileName, wxFile::write)
+    && file.Write(data.data(), data.size()) == data.size();
+}
+
+bool GOTestMidiFile::tearDown() {
+  wxRemoveFile(m_FileName);
+  return true;
+}
+
+void GOTestMidiFile::TestMergeOrder() {
+  static const ExpectedEvent EXPECTED[] = {
+    {GOMidiEvent::MIDI_CTRL_CHANGE, 1, 7, 100, 0},
+    {GOMidiEvent::MIDI_PGM_CHANGE, 1, 6, -1, 0},
+    {GOMidiEvent::MIDI_NOTE, 1, 60, 64, 500},
+    {GOMidiEvent::MIDI_CTRL_CHANGE, 1, 7, 80, 500},
+    {GOMidiEvent::MIDI_NOTE, 2, 64, 64, 500},
+    {GOMidiEvent::MIDI_CTRL_CHANGE, 1, 7, 96, 625},
+    {GOMidiEvent::MIDI_NOTE, 1, 60, 0, 750},
+  };
+  GOMidiMap map;
+  GOMidiFileReader reader(map);
+  GOMidiEvent e;
+  unsigned nEvents = 0;
+
+  GOAssert(reader.Open(m_FileName), "TestMergeOrder: the file is not opened");
+  while (reader.ReadEvent(e)) {
+    GOAssert(
+      nEvents < std::size(EXPECTED), "TestMergeOrder: too many events read");
+    CheckEvent(
+      std::format("TestMergeOrder: event {}", nEvents), e, EXPECTED[nEvents]);
+    nEvents++;
+  }
+  GOAssert(
+    nEvents == std::size(EXPECTED),
+    std::format(
+      "TestMergeOrder: {} events read instead of {}",
+      nEvents,
+      std::size(EXPECTED)));
+  GOAssert(reader.Close(), "TestMergeOrder: decoding errors are reported");
+}
+
+void GOTestMidiFile::TestTempoChange() {
+  GOMidiMap map;
+  GOMidiFileReader reader(map);
+
+  GOAssert(reader.Open(m_FileName), "TestTempoChange: the file is not opened");
+
+  const auto &tempoMap = reader.GetTempoMap();
+
+  GOAssert(
+    tempoMap.size() == 2 && tempoMap[1].m_tick == 100
+      && tempoMap[1].m_time == 500.0f,
+    std::format(
+      "TestTempoChange: {} tempo changes instead of 2 with the second one at "
+      "tick 100",
+      tempoMap.size()));
+  GOAssert(
+    reader.GetTime(50) == 250.0f,
+    std::format(
+      "TestTempoChange: tick 50 is at {} ms instead of 250",
+      reader.GetTime(50)));
+  GOAssert(
+    reader.GetTime(200) == 750.0f,
+    std::format(
+      "TestTempoChange: tick 200 is at {} ms instead of 750",
+      reader.GetTime(200)));
+  reader.Close();
+}
+
+void GOTestMidiFile::TestSeek() {
+  // the content starts with MIDI_SYSEX_GO_CLEAR added when loading
+  static const ExpectedEvent EXPECTED[] = {
+    {GOMidiEvent::MIDI_SYSEX_GO_CLEAR, 0, -1, -1, 0},
+    {GOMidiEvent::MIDI_PGM_CHANGE, 1, 6, -1, 0},
+    {GOMidiEvent::MIDI_NOTE, 1, 60, 64, 500},
+    {GOMidiEvent::MIDI_NOTE, 2, 64, 64, 500},
+    {GOMidiEvent::MIDI_CTRL_CHANGE, 1, 7, 96, 625},
+  };
+  GOMidiMap map;
+  GOMidiFileReader reader(map);
+  GOMidiPlayerContent content;
+  std::vector<GOMidiEvent> chased;
+
+  GOAssert(reader.Open(m_FileName), "TestSeek: the file is not opened");
+  content.Load(reader, map, 0, false);
+  reader.Close();
+  GOAssert(content.Seek(700, chased), "TestSeek: no events after 700 ms");
+  CheckEvent(
+    "TestSeek: the current event",
+    content.GetCurrentEvent(),
+    {GOMidiEvent::MIDI_NOTE, 1, 60, 0, 750});
+  GOAssert(
+    chased.size() == std::size(EXPECTED),
+    std::format(
+      "TestSeek: {} events chased instead of {}",
+      chased.size(),
+      std::size(EXPECTED)));
+  for (unsigned i = 0; i < chased.size(); i++)
+    CheckEvent(
+      std::format("TestSeek: chased event {}", i), chased[i], EXPECTED[i]);
+}
+
+void GOTestMidiFile::run() {
+  TestMergeOrder();
+  TestTempoChange();
+  TestSeek();
+}
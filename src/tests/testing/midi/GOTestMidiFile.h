@@ -0,0 +1,65 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOTESTMIDIFILE_H
+#define GOTESTMIDIFILE_H
+
+#include <string>
+
+#include <wx/string.h>
+
+#include "midi/events/GOMidiEvent.h"
+
+#include "GOTest.h"
+
+class GOTestMidiFile : public GOTest {
+private:
+  static const std::string TEST_NAME;
+
+  struct ExpectedEvent {
+    GOMidiEvent::MidiType m_type;
+    int m_channel;
+    int m_key;
+    // -1 if the value is not checked
+    int m_value;
+    // ms
+    int m_time;
+  };
+
+  // the MIDI file with two tracks and a tempo change written by setUp()
+  wxString m_FileName;
+
+  void CheckEvent(
+    const std::string &label,
+    const GOMidiEvent &e,
+    const ExpectedEvent &expected);
+
+  /**
+   * The events of both tracks must be merged in the order of time, and the
+   * events of the same time must keep the order of the tracks
+   */
+  void TestMergeOrder();
+
+  /**
+   * The times of the events after a tempo change must be calculated with the
+   * new tempo
+   */
+  void TestTempoChange();
+
+  /**
+   * Seeking must return the events restoring the state at the new position:
+   * the last value of each controller, the program and the held notes
+   */
+  void TestSeek();
+
+public:
+  std::string GetName() override { return TEST_NAME; }
+  bool setUp() override;
+  void run() override;
+  bool tearDown() override;
+};
+
+#endif /* GOTESTMIDIFILE_H */
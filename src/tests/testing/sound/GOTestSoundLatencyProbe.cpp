@@ -0,0 +1,162 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOTestSoundLatencyProbe.h"
+
+#include <format>
+#include <vector>
+
+#include "sound/GOSoundLatencyProbe.h"
+
+const std::string GOTestSoundLatencyProbe::TEST_NAME
+  = "GOTestSoundLatencyProbe";
+
+static constexpr int64_t NS_PER_MS = 1000000;
+static constexpr unsigned N_CHANNELS = 2;
+static constexpr unsigned N_FRAMES = 480;
+static constexpr unsigned SAMPLE_RATE = 48000;
+
+/**
+ * Returns an interleaved buffer that is silent until onsetFrame
+ */
+static std::vector<float> make_buffer(unsigned onsetFrame) {
+  std::vector<float> buffer(N_CHANNELS * N_FRAMES, 0.0f);
+
+  for (unsigned i = onsetFrame * N_CHANNELS; i < buffer.size(); i++)
+    buffer[i] = 0.5f;
+  return buffer;
+}
+
+void GOTestSoundLatencyProbe::TestMeasurement() {
+  GOSoundLatencyProbe probe;
+  const std::vector<float> silent = make_buffer(N_FRAMES);
+  // the onset is 5 ms after the beginning of the buffer
+  const std::vector<float> sounding = make_buffer(240);
+
+  // not started yet
+  probe.OnNoteReceived(0);
+  probe.OnOutputRendered(
+    sounding.data(), N_CHANNELS, N_FRAMES, SAMPLE_RATE, 1 * NS_PER_MS);
+  GOAssert(
+    probe.GetNMeasured() == 0, "TestMeasurement: measured before Start()");
+
+  probe.Start();
+  probe.OnOutputRendered(
+    silent.data(), N_CHANNELS, N_FRAMES, SAMPLE_RATE, 0 * NS_PER_MS);
+  probe.OnNoteReceived(1 * NS_PER_MS);
+  probe.OnEventDispatched(3 * NS_PER_MS);
+  probe.OnSamplerStarted(7 * NS_PER_MS);
+  // the buffer is still silent, e.g. the pipe has a delay
+  probe.OnOutputRendered(
+    silent.data(), N_CHANNELS, N_FRAMES, SAMPLE_RATE, 10 * NS_PER_MS);
+  probe.OnOutputRendered(
+    sounding.data(), N_CHANNELS, N_FRAMES, SAMPLE_RATE, 20 * NS_PER_MS);
+
+  GOAssert(
+    probe.GetNMeasured() == 1,
+    std::format(
+      "TestMeasurement: expected 1 measurement, got {}",
+      probe.GetNMeasured()));
+
+  const int64_t expected[GOSoundLatencyProbe::N_INTERVALS]
+    = {2 * NS_PER_MS, 4 * NS_PER_MS, 18 * NS_PER_MS, 24 * NS_PER_MS};
+
+  for (unsigned i = 0; i < GOSoundLatencyProbe::N_INTERVALS; i++) {
+    const GOSoundLatencyProbe::IntervalStatistic stat
+      = probe.GetStatistic((GOSoundLatencyProbe::Interval)i);
+
+    GOAssert(
+      stat.m_count == 1 && stat.m_MinNs == expected[i]
+        && stat.m_MaxNs == expected[i] && stat.m_SumNs == expected[i],
+      std::format(
+        "TestMeasurement: interval {}: expected {} ns, got min {} max {}",
+        i,
+        expected[i],
+        stat.m_MinNs,
+        stat.m_MaxNs));
+  }
+
+  // 24 ms falls into [20, 30)
+  const GOSoundLatencyProbe::IntervalStatistic total
+    = probe.GetStatistic(GOSoundLatencyProbe::INTERVAL_TOTAL);
+
+  GOAssert(
+    total.m_buckets[8] == 1,
+    "TestMeasurement: the total is not in the bucket [20, 30) ms");
+}
+
+void GOTestSoundLatencyProbe::TestDiscardIfNotSilent() {
+  GOSoundLatencyProbe probe;
+  const std::vector<float> sounding = make_buffer(0);
+
+  probe.Start();
+  probe.OnOutputRendered(
+    sounding.data(), N_CHANNELS, N_FRAMES, SAMPLE_RATE, 0 * NS_PER_MS);
+  probe.OnNoteReceived(1 * NS_PER_MS);
+  probe.OnEventDispatched(2 * NS_PER_MS);
+  probe.OnSamplerStarted(3 * NS_PER_MS);
+  probe.OnOutputRendered(
+    sounding.data(), N_CHANNELS, N_FRAMES, SAMPLE_RATE, 10 * NS_PER_MS);
+  GOAssert(
+    probe.GetNMeasured() == 0 && probe.GetNDiscarded() == 1,
+    std::format(
+      "TestDiscardIfNotSilent: expected 0 measured and 1 discarded, got {} "
+      "and {}",
+      probe.GetNMeasured(),
+      probe.GetNDiscarded()));
+}
+
+void GOTestSoundLatencyProbe::TestTimeout() {
+  const int64_t timeoutNs
+    = std::chrono::nanoseconds(GOSoundLatencyProbe::MEASUREMENT_TIMEOUT)
+        .count();
+  GOSoundLatencyProbe probe;
+
+  probe.Start();
+  probe.OnNoteReceived(0);
+  probe.OnEventDispatched(1 * NS_PER_MS);
+  // the note does not sound. The next note is ignored until the timeout
+  probe.OnNoteReceived(timeoutNs / 2);
+  GOAssert(
+    probe.GetNDiscarded() == 0,
+    "TestTimeout: the measurement is discarded before the timeout");
+  probe.OnNoteReceived(timeoutNs + 1 * NS_PER_MS);
+  GOAssert(
+    probe.GetNDiscarded() == 1,
+    "TestTimeout: the measurement is not discarded after the timeout");
+
+  // the new measurement must start from the last note
+  const std::vector<float> silent = make_buffer(N_FRAMES);
+  const std::vector<float> sounding = make_buffer(0);
+
+  probe.OnOutputRendered(
+    silent.data(), N_CHANNELS, N_FRAMES, SAMPLE_RATE, timeoutNs);
+  probe.OnEventDispatched(timeoutNs + 2 * NS_PER_MS);
+  probe.OnSamplerStarted(timeoutNs + 3 * NS_PER_MS);
+  probe.OnOutputRendered(
+    sounding.data(),
+    N_CHANNELS,
+    N_FRAMES,
+    SAMPLE_RATE,
+    timeoutNs + 11 * NS_PER_MS);
+
+  const GOSoundLatencyProbe::IntervalStatistic total
+    = probe.GetStatistic(GOSoundLatencyProbe::INTERVAL_TOTAL);
+
+  GOAssert(
+    total.m_count == 1 && total.m_MaxNs == 10 * NS_PER_MS,
+    std::format(
+      "TestTimeout: expected the total of 10 ms, got {} measurements with "
+      "max {}",
+      total.m_count,
+      total.m_MaxNs));
+}
+
+void GOTestSoundLatencyProbe::run() {
+  TestMeasurement();
+  TestDiscardIfNotSilent();
+  TestTimeout();
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOTESTSOUNDLATENCYPROBE_H
+#define GOTESTSOUNDLATENCYPROBE_H
+
+#include <string>
+
+#include "GOTest.h"
+
+class GOTestSoundLatencyProbe : public GOTest {
+private:
+  static const std::string TEST_NAME;
+
+  /**
+   * A note passing all stages must be split into the stage intervals, and the
+   * onset must be found at its frame inside the output buffer
+   */
+  void TestMeasurement();
+
+  /**
+   * A note started while the output is not silent must be discarded
+   */
+  void TestDiscardIfNotSilent();
+
+  /**
+   * A note that never sounds must be discarded by the next note after the
+   * timeout only
+   */
+  void TestTimeout();
+
+public:
+  std::string GetName() override { return TEST_NAME; }
+  void run() override;
+};
+
+#endif /* GOTESTSOUNDLATENCYPROBE_H */
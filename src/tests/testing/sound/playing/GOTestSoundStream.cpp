@@ -14,6 +14,8 @@
 #include "sound/playing/GOSoundStream.h"
 
 #include "GOInt.h"
+#include "GORandom.h"
+#include "GOSampleStatistic.h"
 #include "GOWave.h"
 #include "GOWaveLoop.h"
 
@@ -209,8 +211,8 @@ void GOTestSoundStream::TestLoopTransitionAcrossDifferentEndPos() {
   GOSoundResample resample;
   GOSoundStream stream;
 
-  // PickEndSegment uses rand(); seed for reproducibility of the test path.
-  std::srand(0);
+  // PickEndSegment uses GORandom; seed for reproducibility of the test path.
+  GORandom::seedThread(0);
   stream.InitStream(
     &resample,
     pSection.get(),
@@ -265,10 +267,10 @@ void GOTestSoundStream::TestCompressedLoopWrapMatchesUncompressed() {
     GOSoundResample resample;
     GOSoundStream stream;
 
-    // Same seed for both runs: PickEndSegment() uses rand() to choose among
+    // Same seed for both runs: PickEndSegment() uses GORandom to choose among
     // multiple valid end segments, and both runs must pick identically so
     // the wrap timing (and hence the skip-ahead pattern) matches.
-    std::srand(0);
+    GORandom::seedThread(0);
     stream.InitStream(
       &resample,
       pSection.get(),
@@ -302,6 +304,95 @@ void GOTestSoundStream::TestCompressedLoopWrapMatchesUncompressed() {
         uncompressed[i]));
 }
 
+void GOTestSoundStream::TestMidSideMatchesStereo(
+  GOSoundResample::InterpolationType interpolationType) {
+  const std::string label
+    = interpolationType == GOSoundResample::GO_LINEAR_INTERPOLATION
+    ? "linear"
+    : "polyphase";
+  std::vector<GOInt16> pcmData(N_FRAMES * 2);
+
+  // left + right is even, so mid/side is lossless here
+  for (unsigned i = 0; i < N_FRAMES; i++) {
+    const int mid = (i % 100) * 300 - 15000;
+    const int side = (int)(i % 7) - 3;
+
+    pcmData[i * 2] = mid + side;
+    pcmData[i * 2 + 1] = mid - side;
+  }
+
+  auto createSection = [&](bool isCompressed, bool isMidSide) {
+    auto pSection = std::make_unique<GOSoundAudioSection>(m_pool);
+
+    pSection->Setup(
+      nullptr,
+      nullptr,
+      pcmData.data(),
+      GOWave::SF_SIGNEDSHORT_16,
+      2,
+      SECTION_RATE,
+      N_FRAMES,
+      nullptr,
+      BOOL3_DEFAULT,
+      isCompressed,
+      0,
+      0,
+      isMidSide);
+    return pSection;
+  };
+
+  auto capture = [&](const GOSoundAudioSection &section) {
+    GOSoundResample resample;
+    GOSoundStream stream;
+    std::vector<float> captured;
+    float buffer[N_BUFFER_ITEMS];
+
+    stream.InitStream(
+      &resample, &section, interpolationType, SAMPLE_RATE_ADJUSTMENT);
+    for (unsigned frameI = 0; frameI < N_FRAMES;
+         frameI += N_FRAMES_PER_BLOCK) {
+      stream.ReadBlock(buffer, N_FRAMES_PER_BLOCK);
+      captured.insert(captured.end(), buffer, buffer + N_BUFFER_ITEMS);
+    }
+    return captured;
+  };
+
+  const auto pPlain = createSection(false, false);
+  const auto pLeftRight = createSection(true, false);
+  const auto pMidSide = createSection(true, true);
+
+  GOAssert(
+    pMidSide->IsCompressed() && pMidSide->IsMidSide(),
+    std::format("The section is not stored as mid/side ({})", label));
+  GOAssert(
+    !pLeftRight->IsMidSide(),
+    std::format("The left/right section is stored as mid/side ({})", label));
+
+  const size_t leftRightSize = pLeftRight->GetStatistic().GetMemorySize();
+  const size_t midSideSize = pMidSide->GetStatistic().GetMemorySize();
+
+  GOAssert(
+    midSideSize < leftRightSize,
+    std::format(
+      "The mid/side section takes {} bytes, the left/right one {} bytes ({})",
+      midSideSize,
+      leftRightSize,
+      label));
+
+  const std::vector<float> expected = capture(*pPlain);
+  const std::vector<float> midSide = capture(*pMidSide);
+
+  for (unsigned i = 0; i < expected.size(); i++)
+    GOAssert(
+      midSide[i] == expected[i],
+      std::format(
+        "mid/side mismatch at output sample {} ({}): {} instead of {}",
+        i,
+        label,
+        midSide[i],
+        expected[i]));
+}
+
 void GOTestSoundStream::run() {
   for (unsigned nChannels : {1u, 2u}) {
     for (bool isCompressed : {false, true}) {
@@ -315,4 +406,6 @@ void GOTestSoundStream::run() {
   TestLoopTransitionAcrossDifferentEndPos();
   TestInitAlignedStream();
   TestCompressedLoopWrapMatchesUncompressed();
+  TestMidSideMatchesStereo(GOSoundResample::GO_LINEAR_INTERPOLATION);
+  TestMidSideMatchesStereo(GOSoundResample::GO_POLYPHASE_INTERPOLATION);
 }
@@ -85,6 +85,14 @@ private:
    */
   void TestCompressedLoopWrapMatchesUncompressed();
 
+  /**
+   * Tests that a stereo section stored as mid/side is decoded to the same
+   * output as the uncompressed one when the side has no lost bit, and that it
+   * takes less memory than the compressed left/right section
+   */
+  void TestMidSideMatchesStereo(
+    GOSoundResample::InterpolationType interpolationType);
+
 public:
   std::string GetName() override { return TEST_NAME; }
   void run() override;
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOTestSoundThreadCountControl.h"
+
+#include <format>
+
+#include "sound/scheduler/GOSoundThreadCountControl.h"
+
+const std::string GOTestSoundThreadCountControl::TEST_NAME
+  = "GOTestSoundThreadCountControl";
+
+void GOTestSoundThreadCountControl::TestStartsWithAllThreads() {
+  GOSoundThreadCountControl control;
+
+  control.Init(4, 10);
+  GOAssert(
+    control.GetNActiveThreads() == 4,
+    "TestStartsWithAllThreads: all threads must be active after Init");
+  for (unsigned i = 0; i < 100; i++) {
+    const unsigned nActive = control.Update(4.0f, 100);
+
+    GOAssert(
+      nActive == 4,
+      std::format(
+        "TestStartsWithAllThreads: expected 4 active threads, got {}",
+        nActive));
+  }
+}
+
+void GOTestSoundThreadCountControl::TestShrinkHysteresis() {
+  GOSoundThreadCountControl control;
+
+  control.Init(4, 10);
+  // no voices and almost no cost: only the callback thread is needed
+  for (unsigned i = 1; i <= 9; i++)
+    control.Update(0.01f, 0);
+  GOAssert(
+    control.GetNActiveThreads() == 4,
+    "TestShrinkHysteresis: no thread may be parked before the shrink delay");
+  control.Update(0.01f, 0);
+  GOAssert(
+    control.GetNActiveThreads() == 3,
+    std::format(
+      "TestShrinkHysteresis: expected 3 active threads, got {}",
+      control.GetNActiveThreads()));
+  for (unsigned i = 0; i < 30; i++)
+    control.Update(0.01f, 0);
+  GOAssert(
+    control.GetNActiveThreads() == 0,
+    std::format(
+      "TestShrinkHysteresis: expected all threads parked, got {}",
+      control.GetNActiveThreads()));
+}
+
+void GOTestSoundThreadCountControl::TestGrowOnVoices() {
+  GOSoundThreadCountControl control;
+
+  control.Init(8, 1);
+  // learn that one voice costs 1% of a period
+  for (unsigned i = 0; i < 200; i++)
+    control.Update(0.1f, 10);
+
+  const unsigned nLow = control.GetNActiveThreads();
+
+  GOAssert(
+    nLow == 0,
+    std::format("TestGrowOnVoices: expected no active threads, got {}", nLow));
+
+  // 400 voices are expected to cost 4 periods: ceil(4 / 0.7) - 1 = 5 workers
+  const unsigned nHigh = control.Update(0.1f, 400);
+
+  GOAssert(
+    nHigh == 5,
+    std::format("TestGrowOnVoices: expected 5 active threads, got {}", nHigh));
+}
+
+void GOTestSoundThreadCountControl::run() {
+  TestStartsWithAllThreads();
+  TestShrinkHysteresis();
+  TestGrowOnVoices();
+}
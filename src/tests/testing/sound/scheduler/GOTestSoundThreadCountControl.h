@@ -0,0 +1,40 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOTESTSOUNDTHREADCOUNTCONTROL_H
+#define GOTESTSOUNDTHREADCOUNTCONTROL_H
+
+#include <string>
+
+#include "GOTest.h"
+
+class GOTestSoundThreadCountControl : public GOTest {
+private:
+  static const std::string TEST_NAME;
+
+  /**
+   * All threads are active after Init, and a high period cost keeps them
+   * active
+   */
+  void TestStartsWithAllThreads();
+
+  /**
+   * A low load parks threads one by one, each after the shrink delay only
+   */
+  void TestShrinkHysteresis();
+
+  /**
+   * A sudden increase of the voice count activates threads immediately using
+   * the learned voice cost, before the period cost has grown
+   */
+  void TestGrowOnVoices();
+
+public:
+  std::string GetName() override { return TEST_NAME; }
+  void run() override;
+};
+
+#endif /* GOTESTSOUNDTHREADCOUNTCONTROL_H */
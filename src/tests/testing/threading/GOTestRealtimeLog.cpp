@@ -0,0 +1,121 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOTestRealtimeLog.h"
+
+#include <atomic>
+#include <format>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "threading/GORealtimeLog.h"
+
+const std::string GOTestRealtimeLog::TEST_NAME = "GOTestRealtimeLog";
+
+void GOTestRealtimeLog::TestFormatting() {
+  GORealtimeLog log(std::chrono::nanoseconds(0));
+  GORealtimeLog::Site site;
+  std::vector<wxString> messages;
+
+  log.Post(
+    site,
+    wxLOG_Error,
+    "int=%d uint=%u hex=%04x double=%.2f str=%s 100%%",
+    -5,
+    7u,
+    255u,
+    1.5,
+    "abc");
+  log.Drain([&](wxLogLevel level, const wxString &msg) {
+    GOAssert(level == wxLOG_Error, "TestFormatting: wrong level");
+    messages.push_back(msg);
+  });
+
+  const std::string expected
+    = "int=-5 uint=7 hex=00ff double=1.50 str=abc 100%";
+
+  GOAssert(
+    messages.size() == 1,
+    std::format("TestFormatting: expected 1 message, got {}", messages.size()));
+  GOAssert(
+    messages[0].ToStdString() == expected,
+    std::format(
+      "TestFormatting: expected '{}', got '{}'",
+      expected,
+      messages[0].ToStdString()));
+}
+
+void GOTestRealtimeLog::TestRateLimiting() {
+  GORealtimeLog log(std::chrono::hours(1));
+  GORealtimeLog::Site site;
+  unsigned nMessages = 0;
+
+  for (unsigned i = 0; i < 10; i++)
+    log.Post(site, wxLOG_Warning, "message %u", i);
+  log.Drain([&](wxLogLevel, const wxString &) { nMessages++; });
+  GOAssert(
+    nMessages == 1,
+    std::format("TestRateLimiting: expected 1 message, got {}", nMessages));
+}
+
+void GOTestRealtimeLog::TestConcurrentPosting() {
+  static constexpr unsigned N_THREADS = 4;
+  static constexpr unsigned N_POSTS = 20000;
+
+  auto pLog = std::make_unique<GORealtimeLog>(std::chrono::nanoseconds(0));
+  std::atomic_bool isPosting(true);
+  unsigned nDrained = 0;
+  unsigned nDropped = 0;
+  const GORealtimeLog::Sink sink = [&](wxLogLevel level, const wxString &msg) {
+    if (level == wxLOG_Info)
+      nDrained++;
+    else // the drop notification starts with the number of dropped messages
+      nDropped += wxAtoi(msg);
+  };
+  std::vector<std::thread> threads;
+
+  for (unsigned threadI = 0; threadI < N_THREADS; threadI++)
+    threads.emplace_back([&, threadI]() {
+      GORealtimeLog::Site site;
+
+      for (unsigned i = 0; i < N_POSTS; i++)
+        pLog->Post(
+          site,
+          wxLOG_Info,
+          "thread %u post %u value %f at %p",
+          threadI,
+          i,
+          i * 0.5,
+          (const void *)&site);
+    });
+
+  std::thread drainer([&]() {
+    while (isPosting.load())
+      pLog->Drain(sink);
+  });
+
+  for (auto &thread : threads)
+    thread.join();
+  isPosting.store(false);
+  drainer.join();
+  pLog->Drain(sink);
+
+  GOAssert(
+    nDrained + nDropped == N_THREADS * N_POSTS,
+    std::format(
+      "TestConcurrentPosting: drained {} + dropped {} != "
+      "posted {}",
+      nDrained,
+      nDropped,
+      N_THREADS * N_POSTS));
+}
+
+void GOTestRealtimeLog::run() {
+  TestFormatting();
+  TestRateLimiting();
+  TestConcurrentPosting();
+}
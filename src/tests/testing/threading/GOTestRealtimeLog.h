@@ -0,0 +1,40 @@
+/*
+ * Copyright 2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOTESTREALTIMELOG_H
+#define GOTESTREALTIMELOG_H
+
+#include <string>
+
+#include "GOTest.h"
+
+class GOTestRealtimeLog : public GOTest {
+private:
+  static const std::string TEST_NAME;
+
+  /**
+   * The posted arguments must be formatted according to the format string
+   */
+  void TestFormatting();
+
+  /**
+   * Repeated messages from the same call site within the minimal interval
+   * must be suppressed
+   */
+  void TestRateLimiting();
+
+  /**
+   * Several threads post messages concurrently with draining. Every message
+   * must be either drained or counted as dropped
+   */
+  void TestConcurrentPosting();
+
+public:
+  std::string GetName() override { return TEST_NAME; }
+  void run() override;
+};
+
+#endif /* GOTESTREALTIMELOG_H */
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -42,6 +42,12 @@ const wxCmdLineEntryDesc GOTool::m_cmdLineDesc[] = {
    wxTRANSLATE("specify input directory"),
    wxCMD_LINE_VAL_STRING,
    wxCMD_LINE_PARAM_OPTIONAL},
+  {wxCMD_LINE_OPTION,
+   wxTRANSLATE("u"),
+   wxTRANSLATE("update-from"),
+   wxTRANSLATE("reuse unchanged files of the previous organ package"),
+   wxCMD_LINE_VAL_STRING,
+   wxCMD_LINE_PARAM_OPTIONAL},
   {wxCMD_LINE_OPTION,
    wxTRANSLATE("t"),
    wxTRANSLATE("title"),
@@ -166,7 +172,7 @@ bool GOTool::OnCmdLineParsed(wxCmdLineParser &parser) {
 }
 
 bool GOTool::CmdLineCreate(wxCmdLineParser &parser) {
-  wxString organPackage, inputDirectory, title;
+  wxString organPackage, inputDirectory, title, prevPackage;
   std::vector<wxString> packages, odfs;
 
   if (!parser.Found(wxT("o"), &organPackage)) {
@@ -181,6 +187,7 @@ bool GOTool::CmdLineCreate(wxCmdLineParser &parser) {
     wxLogError(_("No title specified"));
     return false;
   }
+  parser.Found(wxT("u"), &prevPackage);
   for (unsigned i = 0; i < 5; i++) {
     wxString tmp;
     if (parser.Found(wxString::Format(wxT("p%d"), i + 1), &tmp))
@@ -192,7 +199,7 @@ bool GOTool::CmdLineCreate(wxCmdLineParser &parser) {
       odfs.push_back(tmp);
   }
   if (!CreateOrganPackage(
-        organPackage, title, inputDirectory, odfs, packages)) {
+        organPackage, title, inputDirectory, odfs, packages, prevPackage)) {
     wxLogError(_("organ package creation failed"));
     return false;
   }
@@ -206,7 +213,8 @@ bool GOTool::CreateOrganPackage(
   wxString title,
   wxString inputDirectory,
   std::vector<wxString> odfs,
-  std::vector<wxString> packages) {
+  std::vector<wxString> packages,
+  wxString prevPackage) {
   GOSettingDirectory cacheDir(
     NULL, wxEmptyString, wxEmptyString, wxEmptyString);
 
@@ -221,6 +229,8 @@ bool GOTool::CreateOrganPackage(
     }
   for (unsigned i = 0; i < odfs.size(); i++)
     archiveCreator.AddOrgan(odfs[i]);
+  if (!prevPackage.IsEmpty() && !archiveCreator.SetPreviousPackage(prevPackage))
+    return false;
   if (!archiveCreator.CreatePackage(organPackage, title))
     return false;
   if (!archiveCreator.AddDirectory(inputDirectory))
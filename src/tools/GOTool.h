@@ -2,7 +2,7 @@
  * GrandOrgue - a free pipe organ simulator
  *
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  *
  * This program is free software; you can redistribute it and/or
  * modify it under the terms of the GNU General Public License as
@@ -44,7 +44,8 @@ private:
     wxString title,
     wxString inputDirectory,
     std::vector<wxString> odfs,
-    std::vector<wxString> packages);
+    std::vector<wxString> packages,
+    wxString prevPackage);
 
 public:
   GOTool();